@@ -0,0 +1,116 @@
+/******************************************************************************\
+ * Measures the cost of tracking the current actor ID per thread in the       *
+ * logger. Each resume of an actor sets and restores this ID, even if the     *
+ * logger filters out all events. Build CAF with logging enabled (e.g.,       *
+ * --with-log-level=trace) to get meaningful results.                         *
+ *                                                                            *
+ * Usage: actor_id_tracking [--threads=N] [--iterations=N] [--pairs=N]        *
+ *                          [--rounds=N]                                      *
+\******************************************************************************/
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+class config : public actor_system_config {
+public:
+  size_t threads = 4;
+  size_t iterations = 10000000;
+  size_t pairs = 100;
+  size_t rounds = 10000;
+
+  config() {
+    // compiled in, but filtered out at runtime
+    logger_verbosity = atom("quiet");
+    opt_group{custom_options_, "global"}
+    .add(threads, "threads,t", "set number of threads for the micro benchmark")
+    .add(iterations, "iterations,i", "set number of ID changes per thread")
+    .add(pairs, "pairs,p", "set number of ping-pong actor pairs")
+    .add(rounds, "rounds,r", "set number of messages per pair");
+  }
+};
+
+behavior ping(event_based_actor* self, actor collector, size_t rounds) {
+  return {
+    [=](int x, const actor& pong) {
+      if (static_cast<size_t>(x) == rounds) {
+        self->send(collector, ok_atom::value);
+        self->send_exit(pong, exit_reason::user_shutdown);
+        self->quit();
+        return;
+      }
+      self->send(pong, x + 1, actor{self});
+    }
+  };
+}
+
+behavior pong(event_based_actor* self) {
+  return {
+    [=](int x, const actor& from) {
+      self->send(from, x, actor{self});
+    }
+  };
+}
+
+template <class F>
+double elapsed_ns(F f) {
+  auto t0 = clock_type::now();
+  f();
+  std::chrono::duration<double, std::nano> d = clock_type::now() - t0;
+  return d.count();
+}
+
+} // namespace <anonymous>
+
+void caf_main(actor_system& system, const config& cfg) {
+#ifndef CAF_LOG_LEVEL
+  cout << "*** CAF was built without logging, i.e., actor IDs are not tracked"
+       << endl;
+#endif
+  // micro benchmark: set and restore the actor ID in a tight loop
+  std::vector<std::thread> ts;
+  auto ns = elapsed_ns([&] {
+    for (size_t i = 0; i < cfg.threads; ++i)
+      ts.emplace_back([&] {
+        CAF_SET_LOGGER_SYS(&system);
+        for (size_t j = 0; j < cfg.iterations; ++j) {
+          CAF_PUSH_AID(static_cast<actor_id>(j));
+        }
+      });
+    for (auto& t : ts)
+      t.join();
+  });
+  cout << "push/pop actor ID: "
+       << ns / static_cast<double>(cfg.iterations) << " ns per iteration with "
+       << cfg.threads << " threads" << endl;
+  // macro benchmark: actors ping-pong on all scheduler threads
+  scoped_actor self{system};
+  ns = elapsed_ns([&] {
+    for (size_t i = 0; i < cfg.pairs; ++i) {
+      auto a = system.spawn(ping, actor{self}, cfg.rounds);
+      self->send(a, 0, system.spawn(pong));
+    }
+    for (size_t i = 0; i < cfg.pairs; ++i)
+      self->receive([](ok_atom) {
+        // nop
+      });
+  });
+  auto msgs = static_cast<double>(cfg.pairs * cfg.rounds * 2);
+  cout << "ping-pong: " << static_cast<long>(msgs / (ns / 1e9))
+       << " messages per second with " << system.scheduler().num_workers()
+       << " scheduler threads" << endl;
+}
+
+CAF_MAIN()
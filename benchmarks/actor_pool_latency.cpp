@@ -0,0 +1,134 @@
+/******************************************************************************\
+ * Measures end-to-end latency of actor pool dispatching policies for jobs    *
+ * with heterogeneous costs. A client sends jobs at a fixed rate regardless   *
+ * of pending results, i.e., slow jobs cause other jobs to queue up behind    *
+ * them unless the policy avoids busy workers.                                *
+ *                                                                            *
+ * Usage: actor_pool_latency [--workers=N] [--jobs=N] [--rate=N]              *
+ *                           [--fast-us=N] [--slow-us=N] [--slow-every=N]     *
+\******************************************************************************/
+
+#include <chrono>
+#include <thread>
+#include <cstdint>
+#include <utility>
+#include <iomanip>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+class config : public actor_system_config {
+public:
+  size_t workers = 4;
+  size_t jobs = 20000;
+  size_t rate = 10000;
+  size_t fast_us = 100;
+  size_t slow_us = 10000;
+  size_t slow_every = 100;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(workers, "workers,w", "set number of workers per pool")
+    .add(jobs, "jobs,j", "set number of jobs per policy")
+    .add(rate, "rate,r", "set number of jobs per second")
+    .add(fast_us, "fast-us", "set cost of regular jobs in microseconds")
+    .add(slow_us, "slow-us", "set cost of slow jobs in microseconds")
+    .add(slow_every, "slow-every", "make every N-th job a slow job");
+  }
+};
+
+int64_t now_ns() {
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  return static_cast<int64_t>(
+    duration_cast<nanoseconds>(clock_type::now().time_since_epoch()).count());
+}
+
+// Spins instead of sleeping to occupy the scheduler thread.
+behavior worker(event_based_actor*) {
+  return {
+    [](int64_t t0, int64_t cost_us) {
+      auto t = clock_type::now() + std::chrono::microseconds(cost_us);
+      while (clock_type::now() < t)
+        ; // nop
+      return t0;
+    }
+  };
+}
+
+behavior collector(event_based_actor* self, latency_histogram* hist,
+                   size_t expected, actor parent) {
+  return {
+    [=](int64_t t0) {
+      hist->record(std::chrono::nanoseconds(now_ns() - t0));
+      if (hist->count() == expected) {
+        self->send(parent, ok_atom::value);
+        self->quit();
+      }
+    }
+  };
+}
+
+long to_us(latency_histogram::duration_type x) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  return static_cast<long>(duration_cast<microseconds>(x).count());
+}
+
+} // namespace <anonymous>
+
+void caf_main(actor_system& system, const config& cfg) {
+  std::pair<const char*, actor_pool::policy> policies[] = {
+    {"round_robin", actor_pool::round_robin()},
+    {"random", actor_pool::random()},
+    {"join_shortest_queue", actor_pool::join_shortest_queue()},
+    {"power_of_two_choices", actor_pool::power_of_two_choices()}
+  };
+  scoped_actor self{system};
+  scoped_execution_unit context{&system};
+  auto spawn_worker = [&] { return system.spawn(worker); };
+  auto interval = std::chrono::nanoseconds(1000000000 / cfg.rate);
+  auto fast = static_cast<int64_t>(cfg.fast_us);
+  auto slow = static_cast<int64_t>(cfg.slow_us);
+  cout << "workers: " << cfg.workers << ", jobs: " << cfg.jobs
+       << ", rate: " << cfg.rate << "/s, scheduler threads: "
+       << system.scheduler().num_workers() << endl
+       << std::setw(22) << std::left << "policy"
+       << std::setw(12) << std::right << "p50 [us]"
+       << std::setw(12) << "p99 [us]"
+       << std::setw(12) << "p99.9 [us]"
+       << std::setw(12) << "max [us]" << endl;
+  for (auto& kvp : policies) {
+    latency_histogram hist;
+    auto pool = actor_pool::make(&context, cfg.workers, spawn_worker,
+                                 kvp.second);
+    auto sink = system.spawn(collector, &hist, cfg.jobs, actor{self});
+    auto t = clock_type::now();
+    for (size_t i = 0; i < cfg.jobs; ++i) {
+      std::this_thread::sleep_until(t);
+      t += interval;
+      auto cost = (i + 1) % cfg.slow_every == 0 ? slow : fast;
+      send_as(sink, pool, now_ns(), cost);
+    }
+    self->receive([](ok_atom) {
+      // nop
+    });
+    anon_send_exit(pool, exit_reason::user_shutdown);
+    cout << std::setw(22) << std::left << kvp.first << std::right
+         << std::setw(12) << to_us(hist.percentile(0.5))
+         << std::setw(12) << to_us(hist.percentile(0.99))
+         << std::setw(12) << to_us(hist.percentile(0.999))
+         << std::setw(12) << to_us(hist.max()) << endl;
+  }
+}
+
+CAF_MAIN()
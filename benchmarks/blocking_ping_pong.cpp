@@ -0,0 +1,85 @@
+/******************************************************************************\
+ * Measures the round-trip latency between a blocking actor and an            *
+ * event-based actor. The blocking actor sends a request and waits for the    *
+ * response, i.e., each round trip includes one wakeup of the blocking actor. *
+ * Use `--caf#scheduler.blocking-spin-budget=0` to disable spinning.          *
+ *                                                                            *
+ * Usage: blocking_ping_pong [--rounds=N] [--warmup=N]                        *
+\******************************************************************************/
+
+#include <chrono>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+class config : public actor_system_config {
+public:
+  size_t rounds = 100000;
+  size_t warmup = 1000;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(rounds, "rounds,r", "set number of measured round trips")
+    .add(warmup, "warmup,w", "set number of round trips before measuring");
+  }
+};
+
+behavior pong() {
+  return {
+    [](int x) {
+      return x;
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+void caf_main(actor_system& system, const config& cfg) {
+  auto testee = system.spawn(pong);
+  scoped_actor self{system};
+  auto round_trip = [&](int x) {
+    self->request(testee, infinite, x).receive(
+      [](int) {
+        // nop
+      },
+      [](error& err) {
+        cout << "*** unexpected error: " << to_string(err) << endl;
+      }
+    );
+  };
+  for (size_t i = 0; i < cfg.warmup; ++i)
+    round_trip(static_cast<int>(i));
+  std::vector<double> xs;
+  xs.reserve(cfg.rounds);
+  for (size_t i = 0; i < cfg.rounds; ++i) {
+    auto t0 = clock_type::now();
+    round_trip(static_cast<int>(i));
+    std::chrono::duration<double, std::micro> d = clock_type::now() - t0;
+    xs.push_back(d.count());
+  }
+  self->send_exit(testee, exit_reason::user_shutdown);
+  if (xs.empty())
+    return;
+  std::sort(xs.begin(), xs.end());
+  auto percentile = [&](double p) {
+    return xs[static_cast<size_t>(p * static_cast<double>(xs.size() - 1))];
+  };
+  cout << "round trips: " << xs.size() << endl
+       << "spin budget: " << cfg.scheduler_blocking_spin_budget << endl
+       << "p50: " << percentile(0.5) << " us" << endl
+       << "p99: " << percentile(0.99) << " us" << endl
+       << "max: " << xs.back() << " us" << endl;
+}
+
+CAF_MAIN()
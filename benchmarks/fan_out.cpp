@@ -0,0 +1,93 @@
+/******************************************************************************\
+ * Compares sending one message to many actors with individual `send` calls   *
+ * to a single `send_all` call. The sender broadcasts `rounds` messages to    *
+ * all receivers and each receiver reports back after the last round.         *
+ *                                                                            *
+ * Usage: fan_out [--receivers=N] [--rounds=N]                                *
+\******************************************************************************/
+
+#include <chrono>
+#include <vector>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+class config : public actor_system_config {
+public:
+  size_t receivers = 1000;
+  size_t rounds = 1000;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(receivers, "receivers,n", "set number of receivers per message")
+    .add(rounds, "rounds,r", "set number of messages per receiver");
+  }
+};
+
+behavior receiver(event_based_actor* self, actor collector, size_t rounds) {
+  auto received = std::make_shared<size_t>(0);
+  return {
+    [=](int) {
+      if (++*received == rounds) {
+        self->send(collector, ok_atom::value);
+        self->quit();
+      }
+    }
+  };
+}
+
+behavior sender(event_based_actor* self, std::vector<actor> xs,
+                size_t rounds, bool batched) {
+  return {
+    [=](int x) {
+      for (size_t i = 0; i < rounds; ++i) {
+        if (batched) {
+          self->send_all(xs, x);
+        } else {
+          for (auto& dest : xs)
+            self->send(dest, x);
+        }
+      }
+      self->quit();
+    }
+  };
+}
+
+double run(actor_system& sys, const config& cfg, bool batched) {
+  scoped_actor self{sys};
+  std::vector<actor> xs;
+  for (size_t i = 0; i < cfg.receivers; ++i)
+    xs.push_back(sys.spawn(receiver, actor{self}, cfg.rounds));
+  auto t0 = clock_type::now();
+  self->send(sys.spawn(sender, xs, cfg.rounds, batched), 42);
+  for (size_t i = 0; i < cfg.receivers; ++i)
+    self->receive([](ok_atom) {
+      // nop
+    });
+  std::chrono::duration<double, std::milli> d = clock_type::now() - t0;
+  return d.count();
+}
+
+} // namespace <anonymous>
+
+void caf_main(actor_system& system, const config& cfg) {
+  auto msgs = static_cast<double>(cfg.receivers * cfg.rounds);
+  auto print = [&](const char* what, double ms) {
+    cout << what << ": " << ms << " ms ("
+         << static_cast<long>(msgs / (ms / 1e3)) << " messages per second with "
+         << system.scheduler().num_workers() << " scheduler threads)" << endl;
+  };
+  print("send loop", run(system, cfg, false));
+  print("send_all", run(system, cfg, true));
+}
+
+CAF_MAIN()
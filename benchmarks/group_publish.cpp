@@ -0,0 +1,118 @@
+/******************************************************************************\
+ * Measures publishing to a local group with many subscribers while other     *
+ * threads subscribe and unsubscribe concurrently.                            *
+ *                                                                            *
+ * Usage: group_publish [--subscribers=N] [--messages=N] [--churn-threads=N]  *
+\******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+class config : public actor_system_config {
+public:
+  size_t subscribers = 10000;
+  size_t messages = 100;
+  size_t churn_threads = 1;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(subscribers, "subscribers,s", "set number of subscribers")
+    .add(messages, "messages,m", "set number of published messages")
+    .add(churn_threads, "churn-threads,c",
+         "set number of threads that join and leave the group");
+  }
+};
+
+behavior subscriber(event_based_actor* self, actor collector) {
+  return {
+    [=](int) {
+      // nop
+    },
+    [=](ok_atom) {
+      self->send(collector, ok_atom::value);
+      self->quit();
+    }
+  };
+}
+
+behavior idle(event_based_actor*) {
+  return {
+    [](int) {
+      // nop
+    },
+    [](ok_atom) {
+      // nop
+    }
+  };
+}
+
+long elapsed_ms(clock_type::time_point t0) {
+  using std::chrono::duration_cast;
+  using std::chrono::milliseconds;
+  return static_cast<long>(
+    duration_cast<milliseconds>(clock_type::now() - t0).count());
+}
+
+} // namespace <anonymous>
+
+void caf_main(actor_system& system, const config& cfg) {
+  auto grp = system.groups().anonymous();
+  scoped_actor self{system};
+  for (size_t i = 0; i < cfg.subscribers; ++i)
+    system.spawn_in_group(grp, subscriber, actor{self});
+  // each churn thread repeatedly joins and leaves with its own actors
+  std::atomic<bool> done{false};
+  std::atomic<size_t> churn_ops{0};
+  std::vector<std::thread> churn;
+  std::vector<actor> churners;
+  for (size_t i = 0; i < cfg.churn_threads; ++i) {
+    churners.push_back(system.spawn(idle));
+    auto hdl = actor_cast<strong_actor_ptr>(churners.back());
+    churn.emplace_back([&, hdl] {
+      while (!done) {
+        grp.subscribe(hdl);
+        grp.unsubscribe(hdl.get());
+        churn_ops += 2;
+      }
+    });
+  }
+  auto t0 = clock_type::now();
+  for (size_t i = 0; i < cfg.messages; ++i)
+    self->send(grp, static_cast<int>(i));
+  auto publish_ms = elapsed_ms(t0);
+  self->send(grp, ok_atom::value);
+  size_t i = 0;
+  self->receive_for(i, cfg.subscribers)(
+    [](ok_atom) {
+      // nop
+    }
+  );
+  auto total_ms = elapsed_ms(t0);
+  done = true;
+  for (auto& t : churn)
+    t.join();
+  for (auto& x : churners)
+    anon_send_exit(x, exit_reason::user_shutdown);
+  cout << "subscribers:    " << cfg.subscribers << endl
+       << "messages:       " << cfg.messages << endl
+       << "churn threads:  " << cfg.churn_threads << endl
+       << "churn ops:      " << churn_ops.load() << endl
+       << "publish time:   " << publish_ms << " ms" << endl
+       << "delivery time:  " << total_ms << " ms" << endl;
+}
+
+CAF_MAIN()
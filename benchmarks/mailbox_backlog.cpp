@@ -0,0 +1,97 @@
+/******************************************************************************\
+ * Measures enqueue and dequeue cost for large mailboxes. A scoped actor      *
+ * sends `messages` messages to itself before receiving all of them, i.e.,    *
+ * the mailbox grows far beyond the CPU caches and each dequeue touches cold  *
+ * memory. The size of the mailbox element header determines how many cache   *
+ * lines each message touches. Run with `perf stat -e cache-misses` to get    *
+ * the number of cache misses per message.                                    *
+ *                                                                            *
+ * Usage: mailbox_backlog [--messages=N] [--rounds=N] [--forwarded]           *
+\******************************************************************************/
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr size_t cache_line_size = 64;
+
+class config : public actor_system_config {
+public:
+  size_t messages = 1000000;
+  size_t rounds = 5;
+  bool forwarded = false;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(messages, "messages,m", "set number of messages in the mailbox")
+    .add(rounds, "rounds,r", "set number of fill/drain rounds")
+    .add(forwarded, "forwarded,f", "add one stage to each forwarding stack");
+  }
+};
+
+template <class F>
+double elapsed_ns(F f) {
+  auto t0 = clock_type::now();
+  f();
+  std::chrono::duration<double, std::nano> d = clock_type::now() - t0;
+  return d.count();
+}
+
+size_t cache_lines(size_t bytes) {
+  return (bytes + cache_line_size - 1) / cache_line_size;
+}
+
+} // namespace <anonymous>
+
+void caf_main(actor_system& system, const config& cfg) {
+  using element = mailbox_element_vals<int>;
+  cout << "sizeof(mailbox_element): " << sizeof(mailbox_element) << endl
+       << "sizeof(forwarding_stack): "
+       << sizeof(mailbox_element::forwarding_stack) << endl
+       << "sizeof(mailbox_element_vals<int>): " << sizeof(element) << " ("
+       << cache_lines(sizeof(element)) << " cache line(s))" << endl;
+  scoped_actor self{system};
+  auto dest = actor_cast<strong_actor_ptr>(self);
+  auto stages = [&]() -> mailbox_element::forwarding_stack {
+    if (cfg.forwarded)
+      return {dest};
+    return {};
+  };
+  auto n = static_cast<double>(cfg.messages * cfg.rounds);
+  double enqueue_ns = 0;
+  double dequeue_ns = 0;
+  uint64_t sum = 0;
+  for (size_t round = 0; round < cfg.rounds; ++round) {
+    enqueue_ns += elapsed_ns([&] {
+      for (size_t i = 0; i < cfg.messages; ++i)
+        dest->enqueue(make_mailbox_element(nullptr, make_message_id(),
+                                           stages(), static_cast<int>(i)),
+                      nullptr);
+    });
+    dequeue_ns += elapsed_ns([&] {
+      size_t i = 0;
+      self->receive_for(i, cfg.messages)(
+        [&](int x) {
+          sum += x;
+        }
+      );
+    });
+  }
+  cout << "enqueue: " << enqueue_ns / n << " ns per message" << endl
+       << "dequeue: " << dequeue_ns / n << " ns per message" << endl
+       << "checksum: " << sum << endl;
+}
+
+CAF_MAIN()
@@ -0,0 +1,115 @@
+/******************************************************************************\
+ * Measures the cost of keeping many requests outstanding. An aggregator      *
+ * sends `requests` requests with a timeout to a worker that only answers     *
+ * after receiving all of them, i.e., the aggregator has to store a handler   *
+ * and a deadline for each request until the responses arrive.                *
+ *                                                                            *
+ * Usage: outstanding_requests [--requests=N] [--rounds=N]                    *
+\******************************************************************************/
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+class config : public actor_system_config {
+public:
+  size_t requests = 10000;
+  size_t rounds = 20;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(requests, "requests,n", "set number of outstanding requests")
+    .add(rounds, "rounds,r", "set number of request/response rounds");
+  }
+};
+
+struct worker_state {
+  std::vector<response_promise> pending;
+};
+
+// answers all requests of a round at once
+behavior worker(stateful_actor<worker_state>* self, size_t requests) {
+  return {
+    [=](int) -> result<int> {
+      auto& xs = self->state.pending;
+      xs.emplace_back(self->make_response_promise());
+      if (xs.size() == requests) {
+        for (size_t i = 0; i < xs.size(); ++i)
+          xs[i].deliver(static_cast<int>(i));
+        xs.clear();
+      }
+      return delegated<int>{};
+    }
+  };
+}
+
+struct aggregator_state {
+  uint64_t sum = 0;
+  size_t open = 0;
+  size_t rounds = 0;
+};
+
+behavior aggregator(stateful_actor<aggregator_state>* self, actor collector,
+                    const config* cfg) {
+  auto w = self->spawn(worker, cfg->requests);
+  auto run = [=] {
+    self->state.open = cfg->requests;
+    for (size_t i = 0; i < cfg->requests; ++i)
+      self->request(w, std::chrono::seconds(60), 1).then(
+        [=](int x) {
+          self->state.sum += static_cast<uint64_t>(x);
+          if (--self->state.open == 0)
+            self->send(self, ok_atom::value);
+        },
+        [=](error& err) {
+          self->quit(std::move(err));
+        }
+      );
+  };
+  self->send(self, ok_atom::value);
+  return {
+    [=](ok_atom) {
+      if (self->state.rounds++ == cfg->rounds) {
+        self->send(collector, self->state.sum);
+        self->send_exit(w, exit_reason::user_shutdown);
+        self->quit();
+        return;
+      }
+      run();
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+void caf_main(actor_system& system, const config& cfg) {
+  scoped_actor self{system};
+  auto t0 = clock_type::now();
+  self->spawn(aggregator, actor{self}, &cfg);
+  self->receive(
+    [&](uint64_t sum) {
+      std::chrono::duration<double, std::nano> d = clock_type::now() - t0;
+      auto total = static_cast<double>(cfg.requests * cfg.rounds);
+      cout << "request + response: " << d.count() / total
+           << " ns per request with " << cfg.requests
+           << " outstanding requests (checksum " << sum << ")" << endl;
+    },
+    [&](error& err) {
+      cout << "*** error: " << system.render(err) << endl;
+    }
+  );
+}
+
+CAF_MAIN()
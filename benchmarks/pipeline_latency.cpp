@@ -0,0 +1,124 @@
+/******************************************************************************\
+ * Measures the round-trip latency of messages traveling through pipelines     *
+ * of actors. Each pipeline forwards a single message at a time, i.e., each    *
+ * stage wakes up the next one. Compare runs with and without direct handoff   *
+ * (--caf#work-stealing.direct-handoff=true) to see the effect of running      *
+ * the receiver on the sender's worker.                                        *
+ *                                                                             *
+ * Usage: pipeline_latency [--stages=N] [--pipelines=N] [--rounds=N]           *
+\******************************************************************************/
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+class config : public actor_system_config {
+public:
+  size_t stages = 8;
+  size_t pipelines = 4;
+  size_t rounds = 20000;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(stages, "stages,s", "set number of actors per pipeline")
+    .add(pipelines, "pipelines,p", "set number of concurrent pipelines")
+    .add(rounds, "rounds,r", "set number of round trips per pipeline");
+  }
+};
+
+int64_t now_ns() {
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  return static_cast<int64_t>(
+    duration_cast<nanoseconds>(clock_type::now().time_since_epoch()).count());
+}
+
+behavior stage(event_based_actor* self, actor next) {
+  return {
+    [=](int64_t t0) {
+      self->send(next, t0);
+    }
+  };
+}
+
+behavior driver(event_based_actor* self, latency_histogram* hist,
+                size_t rounds, actor parent) {
+  return {
+    [=](const actor& first) {
+      self->become(
+        [=](int64_t t0) {
+          hist->record(std::chrono::nanoseconds(now_ns() - t0));
+          if (hist->count() == rounds) {
+            self->send(parent, ok_atom::value);
+            self->quit();
+            return;
+          }
+          self->send(first, now_ns());
+        }
+      );
+      self->send(first, now_ns());
+    }
+  };
+}
+
+long to_us(latency_histogram::duration_type x) {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  return static_cast<long>(duration_cast<microseconds>(x).count());
+}
+
+} // namespace <anonymous>
+
+void caf_main(actor_system& system, const config& cfg) {
+  scoped_actor self{system};
+  std::vector<latency_histogram> hists(cfg.pipelines);
+  std::vector<actor> stages;
+  auto t0 = clock_type::now();
+  for (auto& hist : hists) {
+    auto d = system.spawn(driver, &hist, cfg.rounds, actor{self});
+    auto next = d;
+    for (size_t i = 0; i < cfg.stages; ++i) {
+      next = system.spawn(stage, next);
+      stages.push_back(next);
+    }
+    self->send(d, next);
+  }
+  for (size_t i = 0; i < cfg.pipelines; ++i)
+    self->receive([](ok_atom) {
+      // nop
+    });
+  std::chrono::duration<double> elapsed = clock_type::now() - t0;
+  for (auto& x : stages)
+    anon_send_exit(x, exit_reason::user_shutdown);
+  latency_histogram total;
+  for (auto& hist : hists)
+    total.merge(hist);
+  auto trips = static_cast<double>(cfg.pipelines * cfg.rounds);
+  cout << "stages: " << cfg.stages << ", pipelines: " << cfg.pipelines
+       << ", scheduler threads: " << system.scheduler().num_workers()
+       << ", direct handoff: " << std::boolalpha
+       << cfg.work_stealing_direct_handoff << endl
+       << std::setw(12) << "p50 [us]"
+       << std::setw(12) << "p99 [us]"
+       << std::setw(12) << "max [us]"
+       << std::setw(16) << "round trips/s" << endl
+       << std::setw(12) << to_us(total.percentile(0.5))
+       << std::setw(12) << to_us(total.percentile(0.99))
+       << std::setw(12) << to_us(total.max())
+       << std::setw(16) << static_cast<long>(trips / elapsed.count()) << endl;
+}
+
+CAF_MAIN()
@@ -0,0 +1,122 @@
+/******************************************************************************\
+ * Measures allocation cost in producer/consumer flows, where one thread      *
+ * creates small objects (e.g. messages) and another thread destroys them.    *
+ * The producer passes `blocks` blocks through a bounded queue, once          *
+ * allocated from the heap and once from the block cache. With the block      *
+ * cache, the consumer moves surplus blocks to the shared depot in batches,   *
+ * where the producer picks them up again.                                    *
+ *                                                                            *
+ * Usage: producer_consumer [--blocks=N] [--rounds=N]                         *
+\******************************************************************************/
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <cstddef>
+#include <iostream>
+
+#include "caf/all.hpp"
+#include "caf/detail/block_cache.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+using caf::detail::block_cache;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+class config : public actor_system_config {
+public:
+  size_t blocks = 10000000;
+  size_t rounds = 5;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(blocks, "blocks,b", "set number of blocks per round")
+    .add(rounds, "rounds,r", "set number of rounds");
+  }
+};
+
+// same size as a mailbox element holding an atom and an integer
+struct message_block {
+  char data[64];
+};
+
+// single-producer, single-consumer queue for passing blocks between threads
+class handoff_queue {
+public:
+  static constexpr size_t capacity = 1024;
+
+  handoff_queue() : head_(0), tail_(0) {
+    // nop
+  }
+
+  void push(void* x) {
+    auto t = tail_.load(std::memory_order_relaxed);
+    while (t - head_.load(std::memory_order_acquire) == capacity)
+      std::this_thread::yield();
+    buf_[t % capacity] = x;
+    tail_.store(t + 1, std::memory_order_release);
+  }
+
+  void* pop() {
+    auto h = head_.load(std::memory_order_relaxed);
+    while (tail_.load(std::memory_order_acquire) == h)
+      std::this_thread::yield();
+    auto result = buf_[h % capacity];
+    head_.store(h + 1, std::memory_order_release);
+    return result;
+  }
+
+private:
+  alignas(64) std::atomic<size_t> head_;
+  alignas(64) std::atomic<size_t> tail_;
+  alignas(64) std::array<void*, capacity> buf_;
+};
+
+template <class Allocate, class Deallocate>
+double run(size_t blocks, Allocate allocate, Deallocate deallocate) {
+  handoff_queue q;
+  auto t0 = clock_type::now();
+  std::thread consumer{[&] {
+    for (size_t i = 0; i < blocks; ++i)
+      deallocate(q.pop());
+  }};
+  for (size_t i = 0; i < blocks; ++i)
+    q.push(allocate());
+  consumer.join();
+  std::chrono::duration<double, std::milli> d = clock_type::now() - t0;
+  return d.count();
+}
+
+} // namespace <anonymous>
+
+void caf_main(actor_system&, const config& cfg) {
+  auto n = static_cast<double>(cfg.blocks);
+  auto print = [&](const char* what, double ms) {
+    cout << what << ": " << ms << " ms (" << (ms * 1e6 / n)
+         << " ns per block)" << endl;
+  };
+  for (size_t i = 0; i < cfg.rounds; ++i) {
+    print("heap", run(cfg.blocks,
+                      [] { return ::operator new(sizeof(message_block)); },
+                      [](void* x) { ::operator delete(x); }));
+    print("block cache", run(cfg.blocks,
+                             [] {
+                               auto& xs = block_cache::local<message_block>();
+                               return block_cache::allocate(
+                                 xs, sizeof(message_block));
+                             },
+                             [](void* x) {
+                               auto& xs = block_cache::local<message_block>();
+                               block_cache::deallocate(xs, x);
+                             }));
+  }
+}
+
+CAF_MAIN()
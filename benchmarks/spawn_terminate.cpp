@@ -0,0 +1,95 @@
+/******************************************************************************\
+ * Measures spawn and termination throughput of short-lived actors. Each       *
+ * spawner actor repeatedly spawns `batch` workers that answer a single        *
+ * request and terminate afterwards, i.e., the benchmark mostly exercises      *
+ * actor construction, launching, and destruction on the scheduler threads.    *
+ *                                                                             *
+ * Usage: spawn_terminate [--spawners=N] [--actors=N] [--batch=N]              *
+\******************************************************************************/
+
+#include <chrono>
+#include <iostream>
+
+#include "caf/all.hpp"
+
+using std::cout;
+using std::endl;
+
+using namespace caf;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+class config : public actor_system_config {
+public:
+  size_t spawners = 4;
+  size_t actors = 250000;
+  size_t batch = 100;
+
+  config() {
+    opt_group{custom_options_, "global"}
+    .add(spawners, "spawners,s", "set number of concurrent spawner actors")
+    .add(actors, "actors,n", "set number of spawned actors per spawner")
+    .add(batch, "batch,b", "set maximum number of concurrently alive workers");
+  }
+};
+
+behavior worker(event_based_actor* self) {
+  return {
+    [=](int x) {
+      self->quit();
+      return x;
+    }
+  };
+}
+
+struct spawner_state {
+  size_t spawned = 0;
+  size_t done = 0;
+};
+
+behavior spawner(stateful_actor<spawner_state>* self, actor collector,
+                 const config* cfg) {
+  auto spawn_one = [=] {
+    ++self->state.spawned;
+    self->request(self->spawn(worker), infinite, 1).then(
+      [=](int) {
+        self->send(self, ok_atom::value);
+      }
+    );
+  };
+  for (size_t i = 0; i < cfg->batch && i < cfg->actors; ++i)
+    spawn_one();
+  return {
+    [=](ok_atom) {
+      if (++self->state.done == cfg->actors) {
+        self->send(collector, ok_atom::value);
+        self->quit();
+        return;
+      }
+      if (self->state.spawned < cfg->actors)
+        spawn_one();
+    }
+  };
+}
+
+} // namespace <anonymous>
+
+void caf_main(actor_system& system, const config& cfg) {
+  scoped_actor self{system};
+  auto t0 = clock_type::now();
+  for (size_t i = 0; i < cfg.spawners; ++i)
+    self->spawn(spawner, actor{self}, &cfg);
+  for (size_t i = 0; i < cfg.spawners; ++i)
+    self->receive([](ok_atom) {
+      // nop
+    });
+  std::chrono::duration<double> d = clock_type::now() - t0;
+  auto total = static_cast<double>(cfg.spawners * cfg.actors);
+  cout << "spawn + terminate: " << static_cast<long>(total / d.count())
+       << " actors per second with " << system.scheduler().num_workers()
+       << " scheduler threads" << endl;
+}
+
+CAF_MAIN()
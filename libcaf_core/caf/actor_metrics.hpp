@@ -0,0 +1,56 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_ACTOR_METRICS_HPP
+#define CAF_ACTOR_METRICS_HPP
+
+#include <string>
+
+#include "caf/fwd.hpp"
+#include "caf/latency_histogram.hpp"
+
+#include "caf/meta/type_name.hpp"
+
+namespace caf {
+
+/// Message processing statistics of an instrumented actor.
+/// @see abstract_actor::is_instrumented_flag
+struct actor_metrics {
+  /// ID of the instrumented actor.
+  actor_id owner;
+
+  /// Name of the instrumented actor.
+  std::string owner_name;
+
+  /// Time between enqueueing a message and dequeueing it for processing.
+  latency_histogram queueing_time;
+
+  /// Time for processing a message, i.e., running its handler.
+  latency_histogram processing_time;
+};
+
+/// @relates actor_metrics
+template <class Inspector>
+typename Inspector::result_type inspect(Inspector& f, actor_metrics& x) {
+  return f(meta::type_name("actor_metrics"), x.owner, x.owner_name,
+           x.queueing_time, x.processing_time);
+}
+
+} // namespace caf
+
+#endif // CAF_ACTOR_METRICS_HPP
@@ -27,9 +27,11 @@ namespace caf {
 
 /// Provides support for thread-safe output operations on character streams. The
 /// stream operates on a per-actor basis and will print only complete lines or
-/// when explicitly forced to flush its buffer. The stream will convert *any*
-/// operation to a message received by a printer actor. This actor is a sequence
-/// point that ensures output appears never interleaved.
+/// when explicitly forced to flush its buffer. Output goes to a buffer of the
+/// calling thread that gets written in batches and never interleaves lines.
+/// Event-based actors flush this buffer at the end of each resume, blocking
+/// actors at the end of each statement. Redirected output goes to a printer
+/// actor instead.
 class actor_ostream {
 public:
   using fun_type = actor_ostream& (*)(actor_ostream&);
@@ -39,6 +41,8 @@ public:
   actor_ostream& operator=(actor_ostream&&) = default;
   actor_ostream& operator=(const actor_ostream&) = default;
 
+  ~actor_ostream();
+
   /// Open redirection file in append mode.
   static constexpr int append = 0x01;
 
@@ -92,6 +96,8 @@ private:
   void init(abstract_actor*);
 
   actor_id self_;
+  detail::print_sink* sink_;
+  bool deferred_;
   actor printer_;
 };
 
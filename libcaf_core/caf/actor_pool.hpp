@@ -19,11 +19,14 @@
 #ifndef CAF_ACTOR_POOL_HPP
 #define CAF_ACTOR_POOL_HPP
 
+#include <memory>
 #include <vector>
 #include <functional>
 
 #include "caf/locks.hpp"
 #include "caf/actor.hpp"
+#include "caf/expected.hpp"
+#include "caf/actor_clock.hpp"
 #include "caf/execution_unit.hpp"
 #include "caf/mailbox_element.hpp"
 #include "caf/monitorable_actor.hpp"
@@ -54,6 +57,16 @@ namespace caf {
 /// during the enqueue operation. Any user-defined policy thus has to dispatch
 /// messages with as little overhead as possible, because the dispatching
 /// runs in the context of the sender.
+///
+/// An *elastic* pool stores its factory and resizes itself between
+/// configurable bounds. Before dispatching a message, the pool periodically
+/// samples the mailboxes of its workers. It adds a worker if the average
+/// queue depth exceeds a threshold or if a worker makes no progress on its
+/// mailbox for too long. It retires a worker only after the load stayed low
+/// for a while, i.e., short bursts do not cause it to oscillate. Retired
+/// workers receive an exit message and process all of their pending messages
+/// first. Since the pool has no thread of its own, it only resizes itself
+/// while receiving messages.
 /// @experimental
 class actor_pool : public monitorable_actor {
 public:
@@ -63,6 +76,34 @@ public:
   using policy = std::function<void (actor_system&, uplock&, const actor_vec&,
                                      mailbox_element_ptr&, execution_unit*)>;
 
+  /// Configures the resizing of an elastic pool.
+  struct elasticity {
+    using duration_type = actor_clock::duration_type;
+
+    /// Minimum number of workers.
+    size_t min_workers = 1;
+
+    /// Maximum number of workers.
+    size_t max_workers = 16;
+
+    /// Adds a worker when the average queue depth exceeds this value.
+    size_t grow_threshold = 4;
+
+    /// Retires a worker when the average queue depth stays at or below this
+    /// value for at least `shrink_delay`.
+    size_t shrink_threshold = 0;
+
+    /// Adds a worker when the estimated time for any worker to drain its
+    /// mailbox exceeds this value.
+    duration_type max_latency = std::chrono::milliseconds(100);
+
+    /// Minimum time between two samples.
+    duration_type interval = std::chrono::milliseconds(50);
+
+    /// Minimum time of low load before retiring a worker.
+    duration_type shrink_delay = std::chrono::seconds(1);
+  };
+
   /// Returns a simple round robin dispatching policy.
   static policy round_robin();
 
@@ -72,6 +113,16 @@ public:
   /// Returns a random dispatching policy.
   static policy random();
 
+  /// Returns a dispatching policy that sends each message to the worker with
+  /// the fewest messages in its mailbox. Scans all workers on each dispatch.
+  /// Workers that are not local actors always count as idle.
+  static policy join_shortest_queue();
+
+  /// Returns a dispatching policy that samples two random workers and sends
+  /// each message to the one with fewer messages in its mailbox. Achieves
+  /// nearly the load balance of `join_shortest_queue` in constant time.
+  static policy power_of_two_choices();
+
   /// Returns a split/join dispatching policy. The function object `sf`
   /// distributes a work item to all workers (split step) and the function
   /// object `jf` joins individual results into a single one with `init`
@@ -99,6 +150,14 @@ public:
   /// function `fac` using the dispatch policy `pol`.
   static actor make(execution_unit* eu, size_t num_workers, const factory& fac, policy pol);
 
+  /// Returns an elastic actor pool that starts with `cfg.min_workers` workers
+  /// and spawns or retires workers via `fac` depending on the load. Returns
+  /// `sec::invalid_argument` if `cfg.min_workers` is 0, exceeds
+  /// `cfg.max_workers`, or if `cfg.shrink_threshold` is not below
+  /// `cfg.grow_threshold`.
+  static expected<actor> make(execution_unit* eu, const elasticity& cfg,
+                              factory fac, policy pol);
+
   void enqueue(mailbox_element_ptr what, execution_unit* eu) override;
 
   actor_pool(actor_config& cfg);
@@ -114,10 +173,20 @@ private:
   // call without workers_mtx_ held
   void quit(execution_unit* host);
 
+  // call without workers_mtx_ held
+  void resize();
+
+  // stops monitoring `worker` and tells it to quit after processing all
+  // pending messages, call without workers_mtx_ held
+  void retire(const actor& worker);
+
+  struct elastic_state;
+
   detail::shared_spinlock workers_mtx_;
   std::vector<actor> workers_;
   policy policy_;
   exit_reason planned_reason_;
+  std::unique_ptr<elastic_state> elastic_;
 };
 
 } // namespace caf
@@ -28,6 +28,8 @@
 #include "caf/abstract_actor.hpp"
 #include "caf/actor_control_block.hpp"
 
+#include "caf/detail/block_cache.hpp"
+
 #ifdef CAF_GCC
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Winvalid-offsetof"
@@ -73,6 +75,19 @@ public:
   actor_storage(const actor_storage&) = delete;
   actor_storage& operator=(const actor_storage&) = delete;
 
+  // Short-lived actors make allocating and releasing storage a hot path.
+  // Hence, we recycle the memory of destroyed actors per type and thread.
+
+  static void* operator new(size_t n) {
+    using cache = detail::block_cache;
+    return cache::allocate(cache::local<actor_storage>(), n);
+  }
+
+  static void operator delete(void* ptr) noexcept {
+    using cache = detail::block_cache;
+    cache::deallocate(cache::local<actor_storage>(), ptr);
+  }
+
   static_assert(sizeof(actor_control_block) < CAF_CACHE_LINE_SIZE,
                 "actor_control_block exceeds 64 bytes");
 
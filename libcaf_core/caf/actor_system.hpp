@@ -40,6 +40,9 @@
 #include "caf/is_typed_actor.hpp"
 #include "caf/abstract_actor.hpp"
 #include "caf/actor_registry.hpp"
+#include "caf/stream_registry.hpp"
+#include "caf/metrics_registry.hpp"
+#include "caf/response_future.hpp"
 #include "caf/string_algorithms.hpp"
 #include "caf/scoped_execution_unit.hpp"
 #include "caf/uniform_type_info_map.hpp"
@@ -264,6 +267,12 @@ public:
   /// Returns the system-wide group manager.
   group_manager& groups();
 
+  /// Returns the system-wide registry for actors with active streams.
+  stream_registry& streams();
+
+  /// Returns the system-wide registry for instrumented actors.
+  metrics_registry& metrics();
+
   /// Returns `true` if the I/O module is available, `false` otherwise.
   bool has_middleman() const;
 
@@ -483,6 +492,19 @@ public:
   /// Returns the system-wide clock.
   actor_clock& clock() noexcept;
 
+  /// Sends `{xs...}` as a request to `dest` on behalf of the calling thread.
+  /// Unlike `scoped_actor` or `function_view`, this function neither creates
+  /// nor registers an actor. Instead, the response gets written directly to a
+  /// pooled slot owned by the returned handle.
+  /// @warning The returned handle must not outlive the actor system.
+  template <class Handle, class... Ts>
+  response_future request(const Handle& dest, const duration& timeout,
+                          Ts&&... xs) {
+    static_assert(sizeof...(Ts) > 0, "no message to send");
+    return request_impl(actor_cast<strong_actor_ptr>(dest), timeout,
+                        make_message(std::forward<Ts>(xs)...));
+  }
+
   /// @cond PRIVATE
 
   /// Increases running-detached-threads-count by one.
@@ -512,6 +534,9 @@ private:
                   "Probably you have tried to spawn a broker or opencl actor.");
   }
 
+  response_future request_impl(strong_actor_ptr dest, const duration& timeout,
+                               message msg);
+
   expected<strong_actor_ptr> dyn_spawn_impl(const std::string& name,
                                             message& args,
                                             execution_unit* ctx,
@@ -530,6 +555,8 @@ private:
       cfg.flags |= abstract_actor::is_detached_flag;
     if (has_hide_flag(Os))
       cfg.flags |= abstract_actor::is_hidden_flag;
+    if (has_instrumented_flag(Os))
+      cfg.flags |= abstract_actor::is_instrumented_flag;
     if (!cfg.host)
       cfg.host = dummy_execution_unit();
     CAF_SET_LOGGER_SYS(this);
@@ -556,8 +583,11 @@ private:
   intrusive_ptr<caf::logger> logger_;
   actor_registry registry_;
   group_manager groups_;
+  stream_registry streams_;
+  metrics_registry metrics_;
   module_array modules_;
   scoped_execution_unit dummy_execution_unit_;
+  std::unique_ptr<detail::response_slot_pool> response_slots_;
   bool await_actors_before_shutdown_;
   // Stores SpawnServ, ConfigServ, and StreamServ
   std::array<strong_actor_ptr, num_internal_actors> internal_actors_;
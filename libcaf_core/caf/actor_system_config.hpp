@@ -39,6 +39,7 @@
 
 #include "caf/detail/safe_equal.hpp"
 #include "caf/detail/type_traits.hpp"
+#include "caf/detail/value_descriptor.hpp"
 
 namespace caf {
 
@@ -66,6 +67,9 @@ public:
 
   using value_factory_rtti_map = hash_map<std::type_index, value_factory>;
 
+  using value_descriptor_string_map = hash_map<std::string,
+                                               const detail::value_descriptor*>;
+
   using actor_factory_map = hash_map<std::string, actor_factory>;
 
   using portable_name_map = hash_map<std::type_index, std::string>;
@@ -262,7 +266,9 @@ public:
   size_t scheduler_max_throughput;
   bool scheduler_enable_profiling;
   size_t scheduler_profiling_ms_resolution;
+  size_t scheduler_profiling_sample_interval;
   std::string scheduler_profiling_output_file;
+  size_t scheduler_blocking_spin_budget;
 
   // -- config parameters for work-stealing ------------------------------------
 
@@ -273,6 +279,7 @@ public:
   size_t work_stealing_moderate_sleep_duration_us;
   size_t work_stealing_relaxed_steal_interval;
   size_t work_stealing_relaxed_sleep_duration_us;
+  bool work_stealing_direct_handoff;
 
   // -- config parameters for the logger ---------------------------------------
 
@@ -283,6 +290,7 @@ public:
   std::string logger_component_filter;
   atom_value logger_verbosity;
   bool logger_inline_output;
+  bool logger_binary_output;
 
   // -- backward compatibility -------------------------------------------------
 
@@ -302,6 +310,7 @@ public:
   bool middleman_enable_udp;
   size_t middleman_cached_udp_buffers;
   size_t middleman_max_pending_msgs;
+  size_t middleman_max_stream_backlog;
 
   // -- config parameters of the OpenCL module ---------------------------------
 
@@ -319,6 +328,7 @@ public:
 
   value_factory_string_map value_factories_by_name;
   value_factory_rtti_map value_factories_by_rtti;
+  value_descriptor_string_map value_descriptors_by_name;
   actor_factory_map actor_factories;
   module_factory_vector module_factories;
   hook_factory_vector hook_factories;
@@ -362,6 +372,7 @@ private:
   template <class T>
   void add_message_type_impl(std::string name) {
     type_names_by_rtti.emplace(std::type_index(typeid(T)), name);
+    value_descriptors_by_name.emplace(name, detail::make_value_descriptor<T>());
     value_factories_by_name.emplace(std::move(name), &make_type_erased_value<T>);
     value_factories_by_rtti.emplace(std::type_index(typeid(T)),
                                      &make_type_erased_value<T>);
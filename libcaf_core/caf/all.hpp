@@ -51,6 +51,7 @@
 #include "caf/message_id.hpp"
 #include "caf/replies_to.hpp"
 #include "caf/serializer.hpp"
+#include "caf/tuple_view.hpp"
 #include "caf/actor_clock.hpp"
 #include "caf/actor_proxy.hpp"
 #include "caf/exit_reason.hpp"
@@ -75,21 +76,28 @@
 #include "caf/typed_behavior.hpp"
 #include "caf/proxy_registry.hpp"
 #include "caf/behavior_policy.hpp"
+#include "caf/stream_metrics.hpp"
+#include "caf/stream_registry.hpp"
+#include "caf/actor_metrics.hpp"
+#include "caf/metrics_registry.hpp"
 #include "caf/message_builder.hpp"
 #include "caf/message_handler.hpp"
 #include "caf/response_handle.hpp"
 #include "caf/fused_scatterer.hpp"
+#include "caf/fused_stage.hpp"
 #include "caf/random_gatherer.hpp"
 #include "caf/system_messages.hpp"
 #include "caf/abstract_channel.hpp"
 #include "caf/may_have_timeout.hpp"
 #include "caf/message_priority.hpp"
+#include "caf/latency_histogram.hpp"
 #include "caf/typed_actor_view.hpp"
 #include "caf/binary_serializer.hpp"
 #include "caf/composed_behavior.hpp"
 #include "caf/event_based_actor.hpp"
 #include "caf/primitive_variant.hpp"
 #include "caf/timeout_definition.hpp"
+#include "caf/keyed_scatterer.hpp"
 #include "caf/broadcast_scatterer.hpp"
 #include "caf/actor_system_config.hpp"
 #include "caf/binary_deserializer.hpp"
@@ -39,6 +39,7 @@
 #include "caf/detail/type_list.hpp"
 #include "caf/detail/apply_args.hpp"
 #include "caf/detail/type_traits.hpp"
+#include "caf/detail/thread_parker.hpp"
 #include "caf/detail/blocking_behavior.hpp"
 
 #include "caf/mixin/sender.hpp"
@@ -351,6 +352,11 @@ public:
   /// @endcond
 
 private:
+  /// Polls the mailbox for up to `spin_limit_` iterations before the actor
+  /// parks its thread. Adjusts `spin_limit_` depending on whether spinning
+  /// paid off and returns `true` if new data arrived while spinning.
+  bool spin();
+
   size_t attach_functor(const actor&);
 
   size_t attach_functor(const actor_addr&);
@@ -369,6 +375,15 @@ private:
       res += attach_functor(x);
     return res;
   }
+
+  // puts the thread of this actor to sleep while its mailbox is empty
+  detail::thread_parker parker_;
+
+  // upper bound for `spin_limit_`, configured via `blocking-spin-budget`
+  size_t spin_budget_;
+
+  // number of polling attempts in the next call to `await_data`
+  size_t spin_limit_;
 };
 
 } // namespace caf
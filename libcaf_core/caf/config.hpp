@@ -25,6 +25,12 @@
 // Platform-specific adjustments.
 #define CAF_CACHE_LINE_SIZE 64
 
+// Maximum size in bytes of message contents consisting of scalar values only
+// that CAF allocates from thread-local free lists (may be overridden).
+#ifndef CAF_SMALL_MESSAGE_SIZE
+#define CAF_SMALL_MESSAGE_SIZE 32
+#endif
+
 // Config pararameters defined by the build system (usually CMake):
 //
 // CAF_ENABLE_RUNTIME_CHECKS:
@@ -0,0 +1,139 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_ACK_WINDOW_HPP
+#define CAF_DETAIL_ACK_WINDOW_HPP
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "caf/config.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Keeps track of all batches on an outbound path that await an ACK. Stores
+/// only sizes and send times in a ring buffer indexed by batch ID, i.e., no
+/// payload. Releasing any number of batches with a cumulative ACK is O(1).
+class ack_window {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using clock_type = std::chrono::steady_clock;
+
+  using time_point = clock_type::time_point;
+
+  /// Bookkeeping for a single batch.
+  struct entry {
+    /// Number of elements sent on the path up to and including this batch.
+    int64_t accumulated;
+
+    /// Send time of the batch.
+    time_point sent;
+  };
+
+  // -- constants --------------------------------------------------------------
+
+  /// Initial capacity of the ring buffer. Must be a power of two.
+  static constexpr size_t initial_capacity = 8;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  ack_window()
+      : buf_(size_t{initial_capacity}),
+        first_(0),
+        next_(0),
+        acked_(0),
+        sent_(0) {
+    // nop
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the ID of the oldest unacknowledged batch.
+  inline int64_t first_id() const {
+    return first_;
+  }
+
+  /// Returns the ID for the next batch.
+  inline int64_t next_id() const {
+    return next_;
+  }
+
+  /// Returns the number of unacknowledged batches.
+  inline int64_t batches() const {
+    return next_ - first_;
+  }
+
+  /// Returns the number of elements in all unacknowledged batches.
+  inline long elements() const {
+    return static_cast<long>(sent_ - acked_);
+  }
+
+  inline bool empty() const {
+    return first_ == next_;
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds a batch with ID `next_id()`.
+  void push(long xs_size, time_point t) {
+    if (static_cast<size_t>(batches()) == buf_.size())
+      grow();
+    sent_ += xs_size;
+    buf_[index(next_++)] = entry{sent_, t};
+  }
+
+  /// Releases all batches up to and including `id` and returns the entry for
+  /// `id`. Returns `nullptr` for outdated or invalid IDs without changing
+  /// the state of the window. The returned pointer becomes invalid after
+  /// calling `push`.
+  const entry* release(int64_t id) {
+    if (id < first_ || id >= next_)
+      return nullptr;
+    auto& x = buf_[index(id)];
+    acked_ = x.accumulated;
+    first_ = id + 1;
+    return &x;
+  }
+
+private:
+  inline size_t index(int64_t id) const {
+    return static_cast<size_t>(id) & (buf_.size() - 1);
+  }
+
+  void grow() {
+    std::vector<entry> tmp(buf_.size() * 2);
+    for (auto i = first_; i < next_; ++i)
+      tmp[static_cast<size_t>(i) & (tmp.size() - 1)] = buf_[index(i)];
+    buf_.swap(tmp);
+  }
+
+  std::vector<entry> buf_;
+  int64_t first_;
+  int64_t next_;
+  int64_t acked_;
+  int64_t sent_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_ACK_WINDOW_HPP
@@ -0,0 +1,469 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_BINARY_LOG_HPP
+#define CAF_DETAIL_BINARY_LOG_HPP
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <algorithm>
+#include <type_traits>
+
+#include "caf/fwd.hpp"
+#include "caf/atom.hpp"
+#include "caf/config.hpp"
+#include "caf/duration.hpp"
+#include "caf/actor_cast.hpp"
+#include "caf/message_id.hpp"
+#include "caf/deep_to_string.hpp"
+#include "caf/actor_control_block.hpp"
+
+namespace caf {
+namespace detail {
+
+// -- file format --------------------------------------------------------------
+
+// A binary log starts with `binary_log_magic`, followed by the start time of
+// the logger in nanoseconds since the epoch and a sequence of blocks. Each
+// block starts with a tag:
+// - `site_block`: ID, level, line, component, function name, and file name of
+//   a call site. Written once before the first record of that site.
+// - `thread_block`: number and textual ID of a thread. Written once before the
+//   first record of that thread.
+// - `record_block`: a single `log_record`.
+// Integers use the byte order of the host and strings are prefixed with their
+// size as `uint32_t`.
+
+constexpr char binary_log_magic[] = "CAFBLOG1";
+
+constexpr size_t binary_log_magic_size = sizeof(binary_log_magic) - 1;
+
+enum binary_log_block : char {
+  site_block = 'S',
+  thread_block = 'T',
+  record_block = 'R'
+};
+
+// -- records ------------------------------------------------------------------
+
+/// Size of a single record in bytes.
+constexpr size_t log_record_size = 128;
+
+/// Size of the header of a record in bytes.
+constexpr size_t log_record_header_size = 32;
+
+/// Maximum number of payload bytes per record.
+constexpr size_t log_record_payload_size = log_record_size
+                                           - log_record_header_size;
+
+/// Signals that the next record of the same thread continues the payload.
+constexpr uint16_t log_record_continued = 0x0001;
+
+/// A fixed-size entry in a binary log. Events with more than
+/// `log_record_payload_size` bytes of payload span multiple consecutive
+/// records of the same thread.
+struct log_record {
+  /// ID of the call site.
+  uint32_t site;
+  /// Bitmask of flags.
+  uint16_t flags;
+  /// Number of used bytes in `payload`.
+  uint16_t size;
+  /// Number of the logging thread.
+  uint32_t thread;
+  /// Unused.
+  uint32_t reserved;
+  /// ID of the logging actor.
+  uint64_t aid;
+  /// Nanoseconds since the epoch.
+  int64_t tstamp;
+  /// Encoded message, see `log_item`.
+  char payload[log_record_payload_size];
+};
+
+static_assert(sizeof(log_record) == log_record_size,
+              "log_record has an unexpected size");
+
+// -- payload encoding ---------------------------------------------------------
+
+// The payload of an event is a sequence of items that mirrors the calls to
+// `logger::line_builder`. Primitive values, strings, atoms, durations,
+// message IDs, and actor handles are stored in raw form and rendered by the
+// decoder, all other values are rendered on the calling thread via
+// `deep_to_string`.
+
+/// Denotes the kind of an item in the payload.
+enum log_item : char {
+  /// A string that appears verbatim in the output.
+  text_item = 't',
+  /// A value.
+  value_item = 'v',
+  /// A string for the name followed by a value.
+  arg_item = 'a'
+};
+
+/// Denotes the type of a value in the payload.
+enum log_value : char {
+  /// A string rendered by the logging thread.
+  rendered_value = 'r',
+  /// An `int64_t`.
+  int_value = 'i',
+  /// An `uint64_t`.
+  uint_value = 'u',
+  /// A `double`.
+  double_value = 'd',
+  /// A `bool`.
+  bool_value = 'b',
+  /// A string rendered by the decoder via `deep_to_string`.
+  string_value = 's',
+  /// An `atom_value` as `uint64_t`.
+  atom_raw_value = 'A',
+  /// A `duration` as unit and count.
+  duration_value = 'D',
+  /// A `message_id` as `uint64_t`.
+  message_id_value = 'M',
+  /// An actor handle as actor ID followed by a flag for a valid node ID,
+  /// the process ID, and the host ID.
+  actor_value = 'P'
+};
+
+/// Selects the `log_value` for `T`.
+template <class T>
+struct log_value_oracle {
+  static constexpr log_value value =
+    std::is_same<T, bool>::value
+    ? bool_value
+    : (std::is_integral<T>::value
+       ? (std::is_signed<T>::value ? int_value : uint_value)
+       : (std::is_same<T, float>::value || std::is_same<T, double>::value
+          ? double_value
+          : (std::is_same<T, std::string>::value
+             || std::is_same<T, const char*>::value
+             || std::is_same<T, char*>::value
+             ? string_value
+             : rendered_value)));
+};
+
+template <>
+struct log_value_oracle<atom_value> {
+  static constexpr log_value value = atom_raw_value;
+};
+
+template <>
+struct log_value_oracle<duration> {
+  static constexpr log_value value = duration_value;
+};
+
+template <>
+struct log_value_oracle<message_id> {
+  static constexpr log_value value = message_id_value;
+};
+
+template <>
+struct log_value_oracle<strong_actor_ptr> {
+  static constexpr log_value value = actor_value;
+};
+
+template <>
+struct log_value_oracle<actor_addr> {
+  static constexpr log_value value = actor_value;
+};
+
+template <>
+struct log_value_oracle<actor> {
+  static constexpr log_value value = actor_value;
+};
+
+template <class T>
+void append_log_raw(std::string& buf, T x) {
+  static_assert(std::is_trivial<T>::value, "T must be a trivial type");
+  char tmp[sizeof(T)];
+  memcpy(tmp, &x, sizeof(T));
+  buf.append(tmp, sizeof(T));
+}
+
+inline void append_log_string(std::string& buf, const char* str, size_t n) {
+  append_log_raw(buf, static_cast<uint32_t>(n));
+  buf.append(str, n);
+}
+
+inline void append_log_string(std::string& buf, const std::string& str) {
+  append_log_string(buf, str.data(), str.size());
+}
+
+inline void append_log_string(std::string& buf, const char* str) {
+  append_log_string(buf, str, str != nullptr ? strlen(str) : 0);
+}
+
+template <class T>
+void append_log_value(std::string& buf, const T& x,
+                      std::integral_constant<log_value, rendered_value>) {
+  buf += static_cast<char>(rendered_value);
+  append_log_string(buf, deep_to_string(x));
+}
+
+template <class T>
+void append_log_value(std::string& buf, const T& x,
+                      std::integral_constant<log_value, int_value>) {
+  buf += static_cast<char>(int_value);
+  append_log_raw(buf, static_cast<int64_t>(x));
+}
+
+template <class T>
+void append_log_value(std::string& buf, const T& x,
+                      std::integral_constant<log_value, uint_value>) {
+  buf += static_cast<char>(uint_value);
+  append_log_raw(buf, static_cast<uint64_t>(x));
+}
+
+template <class T>
+void append_log_value(std::string& buf, const T& x,
+                      std::integral_constant<log_value, double_value>) {
+  buf += static_cast<char>(double_value);
+  append_log_raw(buf, static_cast<double>(x));
+}
+
+template <class T>
+void append_log_value(std::string& buf, const T& x,
+                      std::integral_constant<log_value, bool_value>) {
+  buf += static_cast<char>(bool_value);
+  buf += x ? '\1' : '\0';
+}
+
+template <class T>
+void append_log_value(std::string& buf, const T& x,
+                      std::integral_constant<log_value, string_value>) {
+  buf += static_cast<char>(string_value);
+  append_log_string(buf, x);
+}
+
+template <class T>
+void append_log_value(std::string& buf, const T& x,
+                      std::integral_constant<log_value, atom_raw_value>) {
+  buf += static_cast<char>(atom_raw_value);
+  append_log_raw(buf, static_cast<uint64_t>(x));
+}
+
+template <class T>
+void append_log_value(std::string& buf, const T& x,
+                      std::integral_constant<log_value, duration_value>) {
+  buf += static_cast<char>(duration_value);
+  append_log_raw(buf, static_cast<uint32_t>(x.unit));
+  append_log_raw(buf, x.count);
+}
+
+template <class T>
+void append_log_value(std::string& buf, const T& x,
+                      std::integral_constant<log_value, message_id_value>) {
+  buf += static_cast<char>(message_id_value);
+  append_log_raw(buf, x.integer_value());
+}
+
+template <class T>
+void append_log_value(std::string& buf, const T& x,
+                      std::integral_constant<log_value, actor_value>) {
+  buf += static_cast<char>(actor_value);
+  auto ptr = actor_cast<actor_control_block*>(x);
+  if (ptr == nullptr) {
+    append_log_raw(buf, actor_id{0});
+    buf += '\0';
+    return;
+  }
+  append_log_raw(buf, ptr->aid);
+  if (!ptr->nid) {
+    buf += '\0';
+    return;
+  }
+  buf += '\1';
+  append_log_raw(buf, ptr->nid.process_id());
+  auto& hid = ptr->nid.host_id();
+  buf.append(reinterpret_cast<const char*>(hid.data()), hid.size());
+}
+
+/// Appends `x` as value to `buf`.
+template <class T>
+void append_log_value(std::string& buf, const T& x) {
+  std::integral_constant<log_value, log_value_oracle<T>::value> token;
+  append_log_value(buf, x, token);
+}
+
+/// Renders the payload `buf` of size `n` to a string, producing the same
+/// output as `logger::line_builder`. Returns `false` for malformed input.
+bool render_log_payload(std::string& result, const char* buf, size_t n);
+
+// -- ring buffer --------------------------------------------------------------
+
+/// A lock-free ring buffer for passing log records from a single producer to
+/// a single consumer.
+class log_ring {
+public:
+  /// Maximum number of records in the buffer.
+  static constexpr size_t capacity = 1024;
+
+  log_ring(uint32_t thread_num, std::string thread_str)
+      : head_(0),
+        tail_(0),
+        retired_(false),
+        thread_(thread_num),
+        thread_str_(std::move(thread_str)) {
+    // nop
+  }
+
+  log_ring(const log_ring&) = delete;
+
+  log_ring& operator=(const log_ring&) = delete;
+
+  /// Returns the number of the thread writing to this buffer.
+  inline uint32_t thread() const {
+    return thread_;
+  }
+
+  /// Returns the textual representation of the thread ID.
+  inline const std::string& thread_str() const {
+    return thread_str_;
+  }
+
+  /// Returns the number of unused records.
+  /// @warning Call only from the producer.
+  inline size_t available() const {
+    return capacity - (tail_.load(std::memory_order_relaxed)
+                       - head_.load(std::memory_order_acquire));
+  }
+
+  /// Returns the `n`-th unpublished record.
+  /// @warning Call only from the producer.
+  inline log_record& at(size_t n) {
+    return buf_[(tail_.load(std::memory_order_relaxed) + n) % capacity];
+  }
+
+  /// Makes the next `n` records visible to the consumer.
+  /// @warning Call only from the producer.
+  inline void publish(size_t n) {
+    tail_.store(tail_.load(std::memory_order_relaxed) + n,
+                std::memory_order_release);
+  }
+
+  /// Signals that the producer publishes no more records, e.g., because its
+  /// thread terminates.
+  /// @warning Call only from the producer.
+  inline void retire() {
+    retired_.store(true, std::memory_order_release);
+  }
+
+  /// Returns whether the producer published its last record. The consumer
+  /// has seen all records of the buffer after calling `consume` once more.
+  inline bool retired() const {
+    return retired_.load(std::memory_order_acquire);
+  }
+
+  /// Calls `f` for each published record and returns the number of records.
+  /// @warning Call only from the consumer.
+  template <class F>
+  size_t consume(F f) {
+    auto first = head_.load(std::memory_order_relaxed);
+    auto last = tail_.load(std::memory_order_acquire);
+    for (auto i = first; i != last; ++i)
+      f(buf_[i % capacity]);
+    head_.store(last, std::memory_order_release);
+    return last - first;
+  }
+
+private:
+  // written by the consumer
+  std::atomic<size_t> head_;
+
+  char pad1_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+
+  // written by the producer
+  std::atomic<size_t> tail_;
+
+  char pad2_[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+
+  std::atomic<bool> retired_;
+  uint32_t thread_;
+  std::string thread_str_;
+  std::array<log_record, capacity> buf_;
+};
+
+// -- writing blocks -----------------------------------------------------------
+
+template <class T>
+void write_log_raw(std::ostream& out, T x) {
+  out.write(reinterpret_cast<const char*>(&x), sizeof(T));
+}
+
+inline void write_log_string(std::ostream& out, const char* str) {
+  auto n = str != nullptr ? strlen(str) : 0;
+  write_log_raw(out, static_cast<uint32_t>(n));
+  out.write(str, static_cast<std::streamsize>(n));
+}
+
+inline void write_log_string(std::ostream& out, const std::string& str) {
+  write_log_raw(out, static_cast<uint32_t>(str.size()));
+  out.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+/// Writes the file header of a binary log with start time `t0`.
+void write_log_header(std::ostream& out, int64_t t0);
+
+/// Writes a `site_block`.
+void write_log_site(std::ostream& out, uint32_t id, int level,
+                    const char* component, const char* pretty_fun,
+                    const char* file_name, int line_number);
+
+/// Writes a `thread_block`.
+void write_log_thread(std::ostream& out, uint32_t num, const std::string& str);
+
+/// Writes a `record_block`.
+void write_log_record(std::ostream& out, const log_record& x);
+
+/// Returns the number of records required for a payload of `n` bytes.
+inline size_t log_record_count(size_t n) {
+  return n == 0 ? 1 : (n + log_record_payload_size - 1)
+                      / log_record_payload_size;
+}
+
+/// Splits `payload` into `log_record_count(payload.size())` records with the
+/// same header as `x`. Calls `next` to obtain the storage for each record.
+template <class F>
+void split_log_payload(const log_record& x, const std::string& payload,
+                       F next) {
+  size_t pos = 0;
+  do {
+    log_record& y = next();
+    y.site = x.site;
+    y.thread = x.thread;
+    y.reserved = 0;
+    y.aid = x.aid;
+    y.tstamp = x.tstamp;
+    auto n = std::min(payload.size() - pos, log_record_payload_size);
+    memcpy(y.payload, payload.data() + pos, n);
+    y.size = static_cast<uint16_t>(n);
+    pos += n;
+    y.flags = pos < payload.size() ? log_record_continued : uint16_t{0};
+  } while (pos < payload.size());
+}
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_BINARY_LOG_HPP
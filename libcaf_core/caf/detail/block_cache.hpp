@@ -0,0 +1,194 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_BLOCK_CACHE_HPP
+#define CAF_DETAIL_BLOCK_CACHE_HPP
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+
+#include "caf/config.hpp"
+
+// The cache keeps its free lists in thread-local storage. Without
+// `thread_local`, all blocks go straight to the heap.
+#if defined(CAF_NO_MEM_MANAGEMENT) || defined(CAF_NO_THREAD_LOCAL)
+#  define CAF_NO_BLOCK_CACHE
+#endif
+
+namespace caf {
+namespace detail {
+
+/// Keeps the memory blocks of destroyed objects in thread-local free lists for
+/// reusing them when creating objects of the same type on the same thread,
+/// e.g., actors or small messages. Each list holds at most `max_blocks`
+/// blocks. Surplus blocks move in batches to a depot that all threads share,
+/// where threads with an empty list pick them up again. Hence, the cache also
+/// helps when one thread creates objects that another thread destroys, e.g.,
+/// messages in a producer/consumer flow. All lists of a thread release their
+/// blocks when the thread terminates. Building CAF with
+/// `CAF_NO_MEM_MANAGEMENT` or on a platform without `thread_local` support
+/// disables the cache, i.e., `allocate` and `deallocate` fall back to plain
+/// `new` and `delete`.
+class block_cache {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Maximum number of cached blocks per type and thread.
+  static constexpr size_t max_blocks = 64;
+
+  /// Number of blocks that move between a free list and its depot at once.
+  static constexpr size_t batch_size = max_blocks / 2;
+
+  /// Maximum number of blocks in the depot for a single type.
+  static constexpr size_t max_depot_blocks = 16 * max_blocks;
+
+  // -- member types -----------------------------------------------------------
+
+  /// A cached memory block.
+  struct node {
+    node* next;
+  };
+
+  /// Stores surplus blocks of a single type for all threads. Depots are never
+  /// destroyed, because threads may return blocks to them at any time,
+  /// including during static destruction.
+  struct depot {
+    depot();
+
+    /// Guards `head`.
+    std::mutex mtx;
+
+    /// Points to the first stored block.
+    node* head;
+
+    /// Stores the number of stored blocks.
+    std::atomic<size_t> size;
+  };
+
+  /// A free list for a single type.
+  struct list {
+    /// Points to the first cached block.
+    node* head;
+
+    /// Stores the number of cached blocks.
+    size_t size;
+
+    /// Links all lists of a thread that hold blocks.
+    list* next;
+
+    /// Stores whether this list is linked to the other lists of its thread.
+    bool enrolled;
+
+    /// Points to the depot for blocks of the same type, which is `nullptr`
+    /// until static initialization created the depot.
+    depot* const* shared;
+  };
+
+  /// Returns the thread-local free list for blocks of type `T`.
+  template <class T>
+  static list& local() noexcept {
+    return lists<T>::value;
+  }
+
+  // -- memory management ------------------------------------------------------
+
+  /// Returns a cached block from `xs` or allocates a new block of `n` bytes.
+  static void* allocate(list& xs, size_t n) {
+#   ifndef CAF_NO_BLOCK_CACHE
+    auto x = xs.head;
+    if (x != nullptr) {
+      xs.head = x->next;
+      --xs.size;
+      return x;
+    }
+    auto d = *xs.shared;
+    if (d != nullptr && d->size.load(std::memory_order_relaxed) > 0)
+      return refill(xs, n);
+#   else
+    static_cast<void>(xs);
+#   endif
+    return ::operator new(n);
+  }
+
+  /// Caches `ptr` in `xs`. Moves a batch of blocks to the depot first if `xs`
+  /// is full.
+  static void deallocate(list& xs, void* ptr) noexcept {
+#   ifndef CAF_NO_BLOCK_CACHE
+    if (xs.enrolled || enroll(xs)) {
+      if (xs.size == max_blocks)
+        spill(xs);
+      auto x = static_cast<node*>(ptr);
+      x->next = xs.head;
+      xs.head = x;
+      ++xs.size;
+      return;
+    }
+#   else
+    static_cast<void>(xs);
+#   endif
+    ::operator delete(ptr);
+  }
+
+private:
+#ifndef CAF_NO_BLOCK_CACHE
+  template <class T>
+  struct lists {
+    static depot* shared;
+    static thread_local list value;
+  };
+
+  /// Links `xs` to the other lists of this thread. Returns `false` if this
+  /// thread already released its cached blocks, i.e., is terminating.
+  static bool enroll(list& xs) noexcept;
+
+  /// Moves up to `batch_size` blocks from the depot to the empty list `xs` and
+  /// returns one of them. Allocates a new block of `n` bytes if the depot ran
+  /// empty in the meantime.
+  static void* refill(list& xs, size_t n);
+
+  /// Moves `batch_size` blocks from the full list `xs` to the depot or
+  /// releases them if the depot is full.
+  static void spill(list& xs) noexcept;
+#else
+  // Placeholder that `allocate` and `deallocate` never touch.
+  template <class T>
+  struct lists {
+    static list value;
+  };
+#endif
+};
+
+#ifndef CAF_NO_BLOCK_CACHE
+// leaked on purpose, see block_cache::depot
+template <class T>
+block_cache::depot* block_cache::lists<T>::shared = new block_cache::depot;
+
+template <class T>
+thread_local block_cache::list block_cache::lists<T>::value{
+  nullptr, 0, nullptr, false, &block_cache::lists<T>::shared};
+#else
+template <class T>
+block_cache::list block_cache::lists<T>::value;
+#endif
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_BLOCK_CACHE_HPP
@@ -132,6 +132,19 @@ public:
     tail_ = tmp;
   }
 
+  // acquires only one lock, keeps the order of [first, last)
+  template <class Iterator>
+  void append(Iterator first, Iterator last) {
+    if (first == last)
+      return;
+    node* head;
+    node* tail;
+    make_chain(first, last, head, tail);
+    lock_guard guard(tail_lock_);
+    tail_.load()->next = head;
+    tail_ = tail;
+  }
+
   // acquires both locks
   void prepend(pointer value) {
     CAF_ASSERT(value != nullptr);
@@ -156,6 +169,29 @@ public:
     first->next = tmp;
   }
 
+  // acquires both locks, keeps the order of [first, last)
+  template <class Iterator>
+  void prepend(Iterator first, Iterator last) {
+    if (first == last)
+      return;
+    node* head;
+    node* tail;
+    make_chain(first, last, head, tail);
+    lock_guard guard1(head_lock_);
+    lock_guard guard2(tail_lock_);
+    auto dummy = head_.load();
+    CAF_ASSERT(dummy != nullptr);
+    auto next = dummy->next.load();
+    if (next) {
+      tail->next = next;
+    } else {
+      // queue is empty
+      CAF_ASSERT(dummy == tail_);
+      tail_ = tail;
+    }
+    dummy->next = head;
+  }
+
   // acquires only one lock, returns nullptr on failure
   pointer take_head() {
     unique_node_ptr first;
@@ -215,6 +251,21 @@ private:
     return nullptr;
   }
 
+  // links new nodes for all values in [first, last) without locking
+  template <class Iterator>
+  static void make_chain(Iterator first, Iterator last, node*& head,
+                         node*& tail) {
+    CAF_ASSERT(first != last);
+    head = new node(*first);
+    tail = head;
+    for (++first; first != last; ++first) {
+      CAF_ASSERT(*first != nullptr);
+      auto tmp = new node(*first);
+      tail->next.store(tmp, std::memory_order_relaxed);
+      tail = tmp;
+    }
+  }
+
   // guarded by head_lock_
   std::atomic<node*> head_;
   char pad1_[CAF_CACHE_LINE_SIZE - sizeof(node*)];
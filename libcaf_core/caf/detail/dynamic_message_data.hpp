@@ -19,27 +19,38 @@
 #ifndef CAF_DETAIL_DYNAMIC_MESSAGE_DATA_HPP
 #define CAF_DETAIL_DYNAMIC_MESSAGE_DATA_HPP
 
-#include <vector>
+#include <cstddef>
+#include <cstdint>
 
 #include "caf/type_erased_value.hpp"
 
 #include "caf/detail/message_data.hpp"
+#include "caf/detail/value_descriptor.hpp"
 
 namespace caf {
 namespace detail {
 
+/// Stores the elements of a dynamically built or deserialized message in a
+/// single memory block. The block starts with a table of `element` entries
+/// and stores the type-erased values at its end, growing downwards. Values
+/// without a descriptor are stored as boxed pointers inside the block.
 class dynamic_message_data : public message_data {
 public:
   // -- member types -----------------------------------------------------------
 
-  using elements = std::vector<type_erased_value_ptr>;
+  /// Locates a single value in the memory block.
+  struct element {
+    /// Distance between the value and the end of the block.
+    size_t offset;
+
+    /// Describes how to copy and move the value.
+    const value_descriptor* descriptor;
+  };
 
   // -- constructors, destructors, and assignment operators --------------------
 
   dynamic_message_data();
 
-  dynamic_message_data(elements&& data);
-
   dynamic_message_data(const dynamic_message_data& other);
 
   ~dynamic_message_data() override;
@@ -70,18 +81,64 @@ public:
 
   error save(size_t pos, serializer& sink) const override;
 
+  // -- observers --------------------------------------------------------------
+
+  /// Returns the number of bytes in the memory block.
+  inline size_t capacity() const noexcept {
+    return capacity_;
+  }
+
+  /// Returns how many bytes a value of type `x` occupies at most,
+  /// including padding.
+  static inline size_t storage_size(const value_descriptor* x) noexcept {
+    return x->size + x->alignment - 1;
+  }
+
   // -- modifiers --------------------------------------------------------------
 
   void clear();
 
+  /// Makes sure that `n` more elements with `value_bytes` bytes of values
+  /// in total fit into the block without reallocating.
+  void reserve(size_t n, size_t value_bytes);
+
+  /// Returns uninitialized memory for a new value of type `x`. The new
+  /// value becomes part of the message only after calling `commit`.
+  void* allocate(const value_descriptor* x);
+
+  /// Adds `ptr`, previously constructed at the memory returned by
+  /// `allocate(x)`, to the message.
+  void commit(const value_descriptor* x, type_erased_value* ptr);
+
+  /// Adds a default-constructed value of type `x` and returns it.
+  type_erased_value* emplace(const value_descriptor* x);
+
+  /// Adds `x` as boxed pointer to the message.
   void append(type_erased_value_ptr x);
 
   void add_to_type_token(uint16_t typenr);
 
 private:
+  // -- utility functions ------------------------------------------------------
+
+  inline element* elements() const noexcept {
+    return reinterpret_cast<element*>(block_);
+  }
+
+  inline type_erased_value* value(size_t pos) const noexcept {
+    return reinterpret_cast<type_erased_value*>(block_ + capacity_
+                                                - elements()[pos].offset);
+  }
+
+  /// Moves all elements to a new block of at least `new_capacity` bytes.
+  void grow(size_t new_capacity);
+
   // -- data members -----------------------------------------------------------
 
-  elements elements_;
+  char* block_;
+  size_t capacity_;
+  size_t size_;
+  size_t values_size_;
   uint32_t type_token_;
 };
 
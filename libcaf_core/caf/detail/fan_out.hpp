@@ -0,0 +1,113 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_FAN_OUT_HPP
+#define CAF_DETAIL_FAN_OUT_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include "caf/fwd.hpp"
+#include "caf/message.hpp"
+#include "caf/actor_cast.hpp"
+#include "caf/message_id.hpp"
+#include "caf/execution_unit.hpp"
+#include "caf/actor_control_block.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Delivers one message to many actors. All receivers share the content of
+/// the message and all mailbox elements live in a single allocation. The
+/// number of atomic operations on the reference count of the sender does not
+/// depend on the number of receivers. Actors that become ready do not get
+/// scheduled individually. Instead, `submit` passes them to the scheduler in
+/// one batch, i.e., with a single enqueue operation per worker.
+class fan_out : public execution_unit {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  /// Prepares a fan-out of `msg` to at most `max_receivers` actors. The
+  /// context `ctx` is the execution unit of the sender or `nullptr`.
+  fan_out(actor_system& sys, execution_unit* ctx, strong_actor_ptr sender,
+          message_id mid, message msg, size_t max_receivers);
+
+  fan_out(const fan_out&) = delete;
+
+  fan_out& operator=(const fan_out&) = delete;
+
+  /// Calls `submit`.
+  ~fan_out() override;
+
+  // -- fan-out ----------------------------------------------------------------
+
+  /// Enqueues the message to `dest`.
+  /// @pre `dest != nullptr`
+  /// @pre less than `max_receivers` previous calls
+  void enqueue(abstract_actor* dest);
+
+  /// Enqueues the message to all valid handles in `xs`.
+  template <class Container>
+  void enqueue_all(const Container& xs) {
+    for (auto& x : xs)
+      if (x)
+        enqueue(actor_cast<abstract_actor*>(x));
+  }
+
+  /// Schedules all actors that became ready during previous `enqueue` calls.
+  void submit();
+
+  // -- overridden member functions of execution_unit --------------------------
+
+  /// Collects `ptr` for scheduling it in `submit`.
+  void exec_later(resumable* ptr) override;
+
+  // -- utility functions ------------------------------------------------------
+
+  /// Returns the number of elements in `xs`.
+  template <class Container>
+  static size_t count(const Container& xs) {
+    size_t result = 0;
+    for (auto i = std::begin(xs); i != std::end(xs); ++i)
+      ++result;
+    return result;
+  }
+
+private:
+  struct slab;
+
+  // parent execution unit of the sender
+  execution_unit* ctx_;
+
+  // ID of the message
+  message_id mid_;
+
+  // stores the sender, the content, and all mailbox elements
+  slab* slab_;
+
+  // number of mailbox elements created so far
+  size_t used_;
+
+  // actors that became ready
+  std::vector<resumable*> jobs_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_FAN_OUT_HPP
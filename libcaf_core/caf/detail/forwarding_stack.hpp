@@ -0,0 +1,255 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_FORWARDING_STACK_HPP
+#define CAF_DETAIL_FORWARDING_STACK_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <initializer_list>
+
+#include "caf/config.hpp"
+#include "caf/actor_control_block.hpp"
+
+namespace caf {
+namespace detail {
+
+/// A stack of actor handles with a vector-like interface that stores one
+/// element inline. Almost all messages have no or a single next stage, i.e.,
+/// this stack only allocates memory for chains with at least two stages. The
+/// object is only half as large as a `std::vector` in order to keep the
+/// header of mailbox elements compact.
+class forwarding_stack {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using value_type = strong_actor_ptr;
+
+  using size_type = size_t;
+
+  using difference_type = ptrdiff_t;
+
+  using reference = value_type&;
+
+  using const_reference = const value_type&;
+
+  using pointer = value_type*;
+
+  using const_pointer = const value_type*;
+
+  using iterator = pointer;
+
+  using const_iterator = const_pointer;
+
+  using reverse_iterator = std::reverse_iterator<iterator>;
+
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Number of elements stored without allocating heap memory.
+  static constexpr uint32_t inline_capacity = 1;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  forwarding_stack() noexcept;
+
+  forwarding_stack(std::initializer_list<value_type> xs);
+
+  /// Allows passing stacks deserialized as `std::vector` (e.g. in BASP).
+  forwarding_stack(std::vector<value_type> xs);
+
+  forwarding_stack(forwarding_stack&& other) noexcept;
+
+  forwarding_stack(const forwarding_stack& other);
+
+  forwarding_stack& operator=(forwarding_stack&& other) noexcept;
+
+  forwarding_stack& operator=(const forwarding_stack& other);
+
+  ~forwarding_stack();
+
+  // -- properties -------------------------------------------------------------
+
+  inline bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  inline size_type size() const noexcept {
+    return size_;
+  }
+
+  inline size_type capacity() const noexcept {
+    return capacity_;
+  }
+
+  /// Returns whether this stack stores its elements inline.
+  inline bool is_inline() const noexcept {
+    return capacity_ == inline_capacity;
+  }
+
+  // -- element access ---------------------------------------------------------
+
+  inline pointer data() noexcept {
+    return is_inline() ? &xs_.local : xs_.heap;
+  }
+
+  inline const_pointer data() const noexcept {
+    return is_inline() ? &xs_.local : xs_.heap;
+  }
+
+  inline reference operator[](size_type pos) noexcept {
+    CAF_ASSERT(pos < size_);
+    return data()[pos];
+  }
+
+  inline const_reference operator[](size_type pos) const noexcept {
+    CAF_ASSERT(pos < size_);
+    return data()[pos];
+  }
+
+  inline reference front() noexcept {
+    CAF_ASSERT(!empty());
+    return data()[0];
+  }
+
+  inline const_reference front() const noexcept {
+    CAF_ASSERT(!empty());
+    return data()[0];
+  }
+
+  inline reference back() noexcept {
+    CAF_ASSERT(!empty());
+    return data()[size_ - 1];
+  }
+
+  inline const_reference back() const noexcept {
+    CAF_ASSERT(!empty());
+    return data()[size_ - 1];
+  }
+
+  // -- iterator access --------------------------------------------------------
+
+  inline iterator begin() noexcept {
+    return data();
+  }
+
+  inline const_iterator begin() const noexcept {
+    return data();
+  }
+
+  inline const_iterator cbegin() const noexcept {
+    return data();
+  }
+
+  inline iterator end() noexcept {
+    return data() + size_;
+  }
+
+  inline const_iterator end() const noexcept {
+    return data() + size_;
+  }
+
+  inline const_iterator cend() const noexcept {
+    return data() + size_;
+  }
+
+  inline reverse_iterator rbegin() noexcept {
+    return reverse_iterator{end()};
+  }
+
+  inline const_reverse_iterator rbegin() const noexcept {
+    return const_reverse_iterator{end()};
+  }
+
+  inline reverse_iterator rend() noexcept {
+    return reverse_iterator{begin()};
+  }
+
+  inline const_reverse_iterator rend() const noexcept {
+    return const_reverse_iterator{begin()};
+  }
+
+  // -- modifiers --------------------------------------------------------------
+
+  inline void push_back(value_type x) {
+    if (size_ == capacity_)
+      grow(capacity_ * 2);
+    data()[size_++] = std::move(x);
+  }
+
+  inline void pop_back() noexcept {
+    CAF_ASSERT(!empty());
+    data()[--size_] = nullptr;
+  }
+
+  /// Inserts `x` before `pos`. Required for deserializing into this type.
+  iterator insert(const_iterator pos, value_type x);
+
+  /// Releases all elements but keeps the allocated memory.
+  void clear() noexcept;
+
+  /// Makes sure this stack can store at least `n` elements without
+  /// allocating more memory.
+  void reserve(size_type n);
+
+private:
+  // Moves all elements to a heap-allocated array with `n` slots.
+  void grow(size_type n);
+
+  // Releases all memory and re-initializes the inline storage.
+  void reset() noexcept;
+
+  // Takes ownership of the content of `other`. Requires `empty()`.
+  void steal(forwarding_stack& other) noexcept;
+
+  // Stores the single inline element or a pointer to heap memory. All slots
+  // within the current capacity are constructed, unused slots are null.
+  union storage {
+    storage() noexcept {
+      // nop
+    }
+
+    ~storage() {
+      // nop
+    }
+
+    value_type local;
+    pointer heap;
+  };
+
+  storage xs_;
+  uint32_t size_;
+  uint32_t capacity_;
+};
+
+/// @relates forwarding_stack
+bool operator==(const forwarding_stack& x, const forwarding_stack& y);
+
+/// @relates forwarding_stack
+inline bool operator!=(const forwarding_stack& x, const forwarding_stack& y) {
+  return !(x == y);
+}
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_FORWARDING_STACK_HPP
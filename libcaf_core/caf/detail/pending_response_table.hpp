@@ -0,0 +1,220 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_PENDING_RESPONSE_TABLE_HPP
+#define CAF_DETAIL_PENDING_RESPONSE_TABLE_HPP
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <functional>
+
+#include "caf/optional.hpp"
+#include "caf/message_id.hpp"
+#include "caf/actor_clock.hpp"
+
+#include "caf/detail/response_handler.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Stores handlers and timeouts for outstanding requests of an actor in a
+/// flat, open-addressed hash table with Robin Hood probing. Request IDs of an
+/// actor form a sequence, i.e., outstanding requests usually occupy
+/// consecutive slots in their home position and lookups as well as removals
+/// touch a single slot. Timeouts live in a binary heap next to the table.
+/// Instead of registering one timeout per request at the clock, actors use
+/// `timeout_id` for all request timeouts. Clocks replace previous entries with
+/// the same ID, i.e., each actor has at most one clock entry that it re-arms
+/// for the earliest deadline. Firings can be stale, hence actors only expire
+/// deadlines that passed according to the clock.
+class pending_response_table {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using time_point = actor_clock::time_point;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Initial number of slots after the first insertion.
+  static constexpr size_t min_capacity = 16;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  pending_response_table();
+
+  pending_response_table(pending_response_table&&) = default;
+
+  pending_response_table& operator=(pending_response_table&&) = default;
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the message ID of the message that signalizes an expired
+  /// request timeout. This ID has the response flag set but no request ID,
+  /// i.e., it never collides with a response to an actual request.
+  static message_id timeout_id() {
+    return make_message_id(message_id::response_flag_mask);
+  }
+
+  /// Returns the number of entries, i.e., handlers or pending timeouts.
+  inline size_t size() const noexcept {
+    return size_;
+  }
+
+  /// Returns whether this table has no entries.
+  inline bool empty() const noexcept {
+    return size_ == 0;
+  }
+
+  /// Returns the number of stored response handlers.
+  inline size_t num_handlers() const noexcept {
+    return num_handlers_;
+  }
+
+  /// Returns the number of slots in the table.
+  inline size_t capacity() const noexcept {
+    return slots_.size();
+  }
+
+  /// Returns the earliest pending deadline or `none` if no timeout is
+  /// pending. Deadlines of answered requests remain in the heap until they
+  /// expire, i.e., the result can be earlier than the next actual timeout.
+  optional<time_point> next_timeout() const;
+
+  /// Returns whether the deadline for the response with ID `id` has passed
+  /// while the table still holds an entry for it.
+  bool expired(message_id id) const noexcept;
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Stores `f` as handler for the response with ID `id`.
+  void add_handler(message_id id, response_handler f);
+
+  /// Stores the deadline `t` for the response with ID `id`.
+  /// @returns `true` if `t` is the new earliest deadline, i.e., the caller
+  ///          needs to move its clock entry.
+  bool add_timeout(message_id id, time_point t);
+
+  /// Removes the entry for `id` and returns its handler, if any.
+  response_handler take(message_id id);
+
+  /// Removes the entry for `id`.
+  void erase(message_id id);
+
+  /// Removes all entries.
+  void clear();
+
+  /// Removes all deadlines up to `now` and passes the ID of each expired
+  /// request to `f`. Expired entries remain in the table until the caller
+  /// removes them, e.g., via `take` or `erase`.
+  template <class F>
+  void expire(time_point now, F f) {
+    std::vector<message_id> ids;
+    while (!timeouts_.empty() && timeouts_.front().first <= now) {
+      auto x = timeouts_.front();
+      std::pop_heap(timeouts_.begin(), timeouts_.end(), heap_order{});
+      timeouts_.pop_back();
+      auto i = find(x.second);
+      // skip answered requests and overridden deadlines
+      if (i == npos || slots_[i].timeout != x.first)
+        continue;
+      slots_[i].timeout = expired_mark();
+      ids.push_back(x.second);
+    }
+    // calling f may add more entries, so we must not do that while iterating
+    for (auto id : ids)
+      f(id);
+  }
+
+private:
+  // -- member types -----------------------------------------------------------
+
+  struct slot {
+    /// Identifies the response, an invalid ID marks an empty slot.
+    message_id id;
+
+    /// Deadline for the response, the epoch if the request has no timeout,
+    /// or `expired_mark()` after the deadline has passed.
+    time_point timeout;
+
+    /// Callback for the response, may be empty for awaited responses.
+    response_handler handler;
+  };
+
+  using heap_entry = std::pair<time_point, message_id>;
+
+  struct heap_order {
+    inline bool operator()(const heap_entry& x, const heap_entry& y) const {
+      return x.first > y.first;
+    }
+  };
+
+  // -- constants --------------------------------------------------------------
+
+  static constexpr size_t npos = static_cast<size_t>(-1);
+
+  // -- utility functions ------------------------------------------------------
+
+  /// Marks slots with expired deadlines.
+  static constexpr time_point expired_mark() {
+    return time_point::min();
+  }
+
+  /// Returns the preferred position for `id`.
+  inline size_t home(message_id id) const noexcept {
+    return static_cast<size_t>(id.request_id().integer_value())
+           & (slots_.size() - 1);
+  }
+
+  /// Returns the distance of the entry at `pos` to its home slot.
+  inline size_t distance(size_t pos) const noexcept {
+    return (pos - home(slots_[pos].id)) & (slots_.size() - 1);
+  }
+
+  /// Returns the position of `id` or `npos`.
+  size_t find(message_id id) const noexcept;
+
+  /// Returns the position of `id` after inserting an empty entry if needed.
+  size_t emplace(message_id id);
+
+  /// Inserts `x` into the first suitable slot, possibly displacing other
+  /// entries, and returns the final position of `x`.
+  size_t insert(slot x);
+
+  /// Removes the entry at `pos` by shifting subsequent entries backwards.
+  void erase_at(size_t pos);
+
+  /// Doubles the number of slots.
+  void grow();
+
+  /// Drops deadlines of answered requests from the heap.
+  void compact_timeouts();
+
+  // -- member variables -------------------------------------------------------
+
+  std::vector<slot> slots_;
+  size_t size_;
+  size_t num_handlers_;
+  std::vector<heap_entry> timeouts_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_PENDING_RESPONSE_TABLE_HPP
@@ -0,0 +1,113 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_PRINT_SINK_HPP
+#define CAF_DETAIL_PRINT_SINK_HPP
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "caf/actor.hpp"
+#include "caf/actor_addr.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Writes the output of `aout` to STDOUT without going through the printer
+/// actor. Each thread collects output in a local buffer, grouped by actor.
+/// Flushing the buffer writes all complete lines with a single `writev` call,
+/// while incomplete lines remain in the sink until the actor either completes
+/// the line, forces a flush, or terminates. Event-based actors flush at the
+/// end of each resume, i.e., before other workers can pick them up again,
+/// which preserves the order of lines per actor. Brokers flush after each IO
+/// event. Threads flush remaining output when exiting.
+///
+/// Actors that redirected their output, as well as all actors after a call
+/// to `actor_ostream::redirect_all`, still send their output to the printer.
+///
+/// The sink writes to file descriptor 1 directly, bypassing `std::cout` and
+/// its buffer. Hence, output of `aout` and output that the application writes
+/// to `std::cout` without flushing may appear in a different order than
+/// written. Applications that mix both should flush `std::cout` regularly.
+///
+/// @note The scheduler creates a sink only on platforms with `thread_local`.
+class print_sink {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  explicit print_sink(actor printer);
+
+  ~print_sink();
+
+  // -- output -----------------------------------------------------------------
+
+  /// Appends `str` to the output of `aid`.
+  void write(actor_id aid, std::string str);
+
+  /// Writes all complete lines buffered by the calling thread. Also writes the
+  /// incomplete line of `forced` unless `forced == invalid_actor_id`.
+  void flush(actor_id forced = invalid_actor_id);
+
+  /// Flushes all output of the terminated actor `aid`.
+  void erase(actor_id aid);
+
+  // -- redirection ------------------------------------------------------------
+
+  /// Sends all further output of `aid` to the printer actor, which in turn
+  /// writes it to `fn`.
+  void redirect(actor_id aid, std::string fn, int flags);
+
+  /// Sends all further output to the printer actor, which in turn writes it
+  /// to `fn` unless an actor redirected its output individually.
+  void redirect_all(std::string fn, int flags);
+
+private:
+  /// Returns whether the output of `aid` goes to the printer actor and
+  /// forwards `str` to it in this case.
+  bool forward_to_printer(actor_id aid, std::string& str);
+
+  /// Sends `str` as output of `aid` to the printer actor.
+  /// @pre `mtx_` is locked
+  void send_to_printer(actor_id aid, std::string str);
+
+  // printer actor for redirected output
+  actor printer_;
+
+  // guards the following members and serializes writes to STDOUT
+  std::mutex mtx_;
+
+  // incomplete lines per actor
+  std::unordered_map<actor_id, std::string> tails_;
+
+  // actors that redirected their output
+  std::unordered_set<actor_id> redirected_;
+
+  // denotes whether `redirect_all` has been called
+  bool redirected_all_;
+
+  // allows `write` to skip `mtx_` as long as no actor redirects its output
+  std::atomic<bool> any_redirect_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_PRINT_SINK_HPP
@@ -0,0 +1,68 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_REQUEST_ALL_HPP
+#define CAF_DETAIL_REQUEST_ALL_HPP
+
+#include <chrono>
+#include <vector>
+
+#include "caf/fwd.hpp"
+#include "caf/actor.hpp"
+#include "caf/duration.hpp"
+#include "caf/actor_cast.hpp"
+#include "caf/actor_clock.hpp"
+#include "caf/scoped_actor.hpp"
+#include "caf/actor_control_block.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Sends `xs...` as request to each actor in `hdls` and calls `f` for each
+/// response or `g` for each error. Sends all requests before waiting for the
+/// first response and all requests share a single deadline, i.e., the caller
+/// blocks for at most `timeout` in total regardless of the number of actors.
+/// @warning Must not get called from inside an actor.
+template <class F, class G, class... Ts>
+void request_all(actor_system& sys, const std::vector<strong_actor_ptr>& hdls,
+                 const duration& timeout, F f, G g, const Ts&... xs) {
+  scoped_actor self{sys, true};
+  using handle = decltype(self->request(actor{}, timeout, xs...));
+  std::vector<handle> pending;
+  pending.reserve(hdls.size());
+  auto deadline = self->clock().now();
+  deadline += timeout;
+  auto remaining = [&]() -> duration {
+    if (!timeout.valid())
+      return timeout;
+    using std::chrono::microseconds;
+    using std::chrono::duration_cast;
+    return duration{duration_cast<microseconds>(deadline
+                                                - self->clock().now())};
+  };
+  for (auto& hdl : hdls)
+    pending.emplace_back(self->request(actor_cast<actor>(hdl), remaining(),
+                                       xs...));
+  for (auto& rh : pending)
+    rh.receive(f, g);
+}
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_REQUEST_ALL_HPP
@@ -0,0 +1,298 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_RESPONSE_HANDLER_HPP
+#define CAF_DETAIL_RESPONSE_HANDLER_HPP
+
+#include <new>
+#include <tuple>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include "caf/fwd.hpp"
+#include "caf/param.hpp"
+#include "caf/message.hpp"
+#include "caf/type_nr.hpp"
+#include "caf/behavior.hpp"
+#include "caf/type_erased_tuple.hpp"
+
+#include "caf/detail/try_match.hpp"
+#include "caf/detail/apply_args.hpp"
+#include "caf/detail/type_traits.hpp"
+#include "caf/detail/pseudo_tuple.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Matches a response against the signature of a single callback. Unlike
+/// `trivial_match_case`, this type has no virtual member functions and
+/// ignores the result of the callback, since response handlers always
+/// return `void`.
+template <class F>
+class response_case {
+public:
+  using arg_types = typename get_callable_trait<F>::arg_types;
+
+  using pattern = typename tl_map<arg_types, param_decay>::type;
+
+  using decayed_arg_types = typename tl_map<arg_types, std::decay>::type;
+
+  using intermediate_pseudo_tuple =
+    typename tl_apply<decayed_arg_types, pseudo_tuple>::type;
+
+  static constexpr bool is_manipulator =
+    tl_exists<arg_types, is_mutable_ref>::value;
+
+  response_case(F f) : f_(std::move(f)) {
+    // nop
+  }
+
+  bool operator()(type_erased_tuple& xs) {
+    if (xs.type_token() != make_type_token_from_list<pattern>())
+      return false;
+    meta_elements<pattern> ms;
+    if (!try_match(xs, ms.arr.data(), ms.arr.size()))
+      return false;
+    typename il_indices<decayed_arg_types>::type indices;
+    message tmp;
+    auto needs_detaching = is_manipulator && xs.shared();
+    if (needs_detaching)
+      tmp = message::copy(xs);
+    intermediate_pseudo_tuple tup{needs_detaching ? tmp.content() : xs};
+    apply_args(f_, indices, tup);
+    return true;
+  }
+
+private:
+  F f_;
+};
+
+/// Tries each callback in order until one matches the response.
+template <class... Fs>
+class response_cases {
+public:
+  response_cases(Fs... fs) : cases_(std::move(fs)...) {
+    // nop
+  }
+
+  bool operator()(type_erased_tuple& xs) {
+    return invoke(xs, std::integral_constant<size_t, 0>{});
+  }
+
+private:
+  bool invoke(type_erased_tuple&, std::integral_constant<size_t, sizeof...(Fs)>) {
+    return false;
+  }
+
+  template <size_t I>
+  bool invoke(type_erased_tuple& xs, std::integral_constant<size_t, I>) {
+    return std::get<I>(cases_)(xs)
+           || invoke(xs, std::integral_constant<size_t, I + 1>{});
+  }
+
+  std::tuple<response_case<Fs>...> cases_;
+};
+
+/// A type-erased callback for a single response message. Stores function
+/// objects of up to `inline_size` bytes without allocating heap memory and
+/// falls back to the heap for larger ones. Compared to a `behavior`, response
+/// handlers skip the reference-counted `behavior_impl` and its case table.
+class response_handler {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Maximum size of function objects stored inline.
+  static constexpr size_t inline_size = 6 * sizeof(void*);
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  response_handler() noexcept : vtbl_(nullptr) {
+    // nop
+  }
+
+  /// Wraps a generic behavior, e.g., the result handler of a stream.
+  response_handler(behavior bhvr);
+
+  response_handler(response_handler&& other) noexcept : vtbl_(other.vtbl_) {
+    if (vtbl_ != nullptr) {
+      vtbl_->move(buf_, other.buf_);
+      other.vtbl_ = nullptr;
+    }
+  }
+
+  response_handler& operator=(response_handler&& other) noexcept {
+    if (this != &other) {
+      reset();
+      if (other.vtbl_ != nullptr) {
+        other.vtbl_->move(buf_, other.buf_);
+        vtbl_ = other.vtbl_;
+        other.vtbl_ = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  response_handler(const response_handler&) = delete;
+
+  response_handler& operator=(const response_handler&) = delete;
+
+  ~response_handler() {
+    reset();
+  }
+
+  /// Creates a response handler from a function object with signature
+  /// `bool (type_erased_tuple&)`.
+  template <class T>
+  static response_handler make(T x) {
+    response_handler result;
+    result.assign(std::move(x),
+                  std::integral_constant<bool, fits_inline<T>()>{});
+    return result;
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  explicit operator bool() const noexcept {
+    return vtbl_ != nullptr;
+  }
+
+  /// Returns whether the function object lives in the inline buffer.
+  bool is_inline() const noexcept {
+    return vtbl_ != nullptr && vtbl_->is_inline;
+  }
+
+  // -- invocation -------------------------------------------------------------
+
+  /// Invokes the handler with `xs`.
+  /// @returns `true` if the handler matched `xs`, `false` otherwise.
+  bool operator()(type_erased_tuple& xs) {
+    return vtbl_ != nullptr && vtbl_->invoke(buf_, xs);
+  }
+
+  /// Invokes the handler with `xs`.
+  /// @returns `true` if the handler matched `xs`, `false` otherwise.
+  bool operator()(message& xs);
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Destroys the stored function object.
+  void reset() noexcept {
+    if (vtbl_ != nullptr) {
+      vtbl_->destroy(buf_);
+      vtbl_ = nullptr;
+    }
+  }
+
+private:
+  using storage =
+    typename std::aligned_storage<inline_size, alignof(void*)>::type;
+
+  struct vtable {
+    bool is_inline;
+    bool (*invoke)(storage&, type_erased_tuple&);
+    void (*move)(storage&, storage&);
+    void (*destroy)(storage&);
+  };
+
+  template <class T>
+  static constexpr bool fits_inline() {
+    return sizeof(T) <= sizeof(storage) && alignof(T) <= alignof(storage)
+           && std::is_nothrow_move_constructible<T>::value;
+  }
+
+  // Stores `T` in the inline buffer.
+  template <class T>
+  struct inline_model {
+    static T& get(storage& x) {
+      return *reinterpret_cast<T*>(&x);
+    }
+
+    static bool invoke(storage& x, type_erased_tuple& xs) {
+      return get(x)(xs);
+    }
+
+    static void move(storage& dst, storage& src) {
+      new (&dst) T(std::move(get(src)));
+      get(src).~T();
+    }
+
+    static void destroy(storage& x) {
+      get(x).~T();
+    }
+
+    static const vtable* vtbl() {
+      static constexpr vtable result{true, invoke, move, destroy};
+      return &result;
+    }
+  };
+
+  // Stores a pointer to a heap-allocated `T` in the inline buffer.
+  template <class T>
+  struct heap_model {
+    static T*& get(storage& x) {
+      return *reinterpret_cast<T**>(&x);
+    }
+
+    static bool invoke(storage& x, type_erased_tuple& xs) {
+      return (*get(x))(xs);
+    }
+
+    static void move(storage& dst, storage& src) {
+      new (&dst) T*(get(src));
+    }
+
+    static void destroy(storage& x) {
+      delete get(x);
+    }
+
+    static const vtable* vtbl() {
+      static constexpr vtable result{false, invoke, move, destroy};
+      return &result;
+    }
+  };
+
+  template <class T>
+  void assign(T&& x, std::true_type) {
+    using type = typename std::decay<T>::type;
+    new (&buf_) type(std::forward<T>(x));
+    vtbl_ = inline_model<type>::vtbl();
+  }
+
+  template <class T>
+  void assign(T&& x, std::false_type) {
+    using type = typename std::decay<T>::type;
+    new (&buf_) type*(new type(std::forward<T>(x)));
+    vtbl_ = heap_model<type>::vtbl();
+  }
+
+  const vtable* vtbl_;
+  storage buf_;
+};
+
+/// Creates a response handler that invokes the first callback in `fs` with
+/// a matching signature.
+template <class... Fs>
+response_handler make_response_handler(Fs... fs) {
+  return response_handler::make(response_cases<Fs...>{std::move(fs)...});
+}
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_RESPONSE_HANDLER_HPP
@@ -0,0 +1,124 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_RESPONSE_SLOT_HPP
+#define CAF_DETAIL_RESPONSE_SLOT_HPP
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <condition_variable>
+
+#include "caf/fwd.hpp"
+#include "caf/message.hpp"
+#include "caf/duration.hpp"
+#include "caf/expected.hpp"
+#include "caf/message_id.hpp"
+#include "caf/monitorable_actor.hpp"
+
+namespace caf {
+namespace detail {
+
+/// A minimal actor for receiving a single response per request on behalf of a
+/// non-actor thread. The response gets written directly into the slot and the
+/// slot only wakes up the waiting thread if it actually blocks. Slots are
+/// owned by a `response_slot_pool` and reused for subsequent requests.
+class response_slot : public monitorable_actor {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using clock_type = std::chrono::steady_clock;
+
+  enum state_type {
+    idle,
+    waiting,
+    ready
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  response_slot(actor_config& cfg, response_slot_pool* pool);
+
+  ~response_slot() override;
+
+  // -- overridden functions of abstract_actor ---------------------------------
+
+  using abstract_actor::enqueue;
+
+  void enqueue(mailbox_element_ptr what, execution_unit* host) override;
+
+  const char* name() const override;
+
+  // -- request management -----------------------------------------------------
+
+  /// Prepares this slot for a new request and returns its ID.
+  message_id arm(const duration& timeout);
+
+  /// Blocks until the response arrives or the timeout expires. Results in
+  /// `sec::request_timeout` if no response arrived in time. Responses with
+  /// an error get converted to the error.
+  expected<message> await();
+
+  /// Discards the response to the current request.
+  void cancel();
+
+  /// Returns the pool this slot belongs to.
+  inline response_slot_pool* pool() const {
+    return pool_;
+  }
+
+private:
+  response_slot_pool* pool_;
+  message_id last_request_id_;
+  // response ID this slot accepts or 0, claimed by the first matching response
+  std::atomic<uint64_t> awaited_;
+  // cancelling a request races with incoming responses
+  uint64_t current_;
+  bool has_deadline_;
+  clock_type::time_point deadline_;
+  std::atomic<int> state_;
+  message result_;
+  std::mutex mtx_;
+  std::condition_variable cv_;
+};
+
+/// Stores unused `response_slot` instances of an actor system.
+class response_slot_pool {
+public:
+  explicit response_slot_pool(actor_system& sys);
+
+  ~response_slot_pool();
+
+  /// Returns an unused slot, creating a new one if needed.
+  strong_actor_ptr acquire();
+
+  /// Returns `slot` to the pool.
+  void release(strong_actor_ptr slot);
+
+private:
+  actor_system& system_;
+  std::mutex mtx_;
+  std::vector<strong_actor_ptr> slots_;
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_RESPONSE_SLOT_HPP
@@ -79,6 +79,9 @@ public:
       // a dummy is never part of a non-empty list
       new_element->next = is_dummy(e) ? nullptr : e;
       if (stack_.compare_exchange_strong(e, new_element)) {
+        auto counter = enqueued_.load(std::memory_order_acquire);
+        if (counter != nullptr)
+          counter->fetch_add(1, std::memory_order_relaxed);
         return  (e == reader_blocked_dummy()) ? enqueue_result::unblocked_reader
                                               : enqueue_result::success;
       }
@@ -104,6 +107,47 @@ public:
     return cache_.empty() && !head_ && is_dummy(stack_.load());
   }
 
+  /// Returns an estimate for the number of elements that were enqueued but
+  /// not yet dequeued via `try_pop`. Elements moved to the cache count as
+  /// dequeued. The result may be stale, but never blocks the reader or any
+  /// writer and hence allows other threads to cheaply check the load.
+  /// Always returns 0 unless `enable_size_estimate` has been called.
+  /// @threadsafe
+  size_t size_estimate() const {
+    auto counter = enqueued_.load(std::memory_order_acquire);
+    if (counter == nullptr)
+      return 0;
+    auto x = dequeued_.load(std::memory_order_relaxed);
+    auto y = counter->load(std::memory_order_relaxed);
+    // the reader may overtake our load of the counter
+    return y > x ? y - x : 0;
+  }
+
+  /// Starts counting enqueue operations for `size_estimate`. Counting costs
+  /// an atomic write per enqueue, hence only actors that others query for
+  /// their load, e.g., workers of an actor pool, enable it. Elements that
+  /// are already in the queue do not count.
+  /// @threadsafe
+  void enable_size_estimate() {
+    if (enqueued_.load(std::memory_order_acquire) != nullptr)
+      return;
+    // the counter lives outside of this object to keep the extra writes
+    // away from the cache line of `stack_`
+    auto counter = new std::atomic<size_t>(
+      dequeued_.load(std::memory_order_relaxed));
+    std::atomic<size_t>* expected = nullptr;
+    if (!enqueued_.compare_exchange_strong(expected, counter,
+                                           std::memory_order_acq_rel))
+      delete counter;
+  }
+
+  /// Returns the total number of elements dequeued via `try_pop`, e.g., for
+  /// computing the throughput of the reader.
+  /// @threadsafe
+  size_t dequeue_count() const {
+    return dequeued_.load(std::memory_order_relaxed);
+  }
+
   /// Queries whether this has been closed.
   bool closed() {
     return !stack_.load();
@@ -146,13 +190,14 @@ public:
     cache_.clear(f);
   }
 
-  single_reader_queue() : head_(nullptr) {
+  single_reader_queue() : enqueued_(nullptr), dequeued_(0), head_(nullptr) {
     stack_ = stack_empty_dummy();
   }
 
   ~single_reader_queue() {
     if (!closed())
       close();
+    delete enqueued_.load();
   }
 
   size_t count(size_t max_count = std::numeric_limits<size_t>::max()) {
@@ -269,6 +314,12 @@ private:
   // exposed to "outside" access
   std::atomic<pointer> stack_;
 
+  // counts successful enqueue operations if enabled, written by any thread
+  std::atomic<std::atomic<size_t>*> enqueued_;
+
+  // counts successful take_head operations, written only by the owner
+  std::atomic<size_t> dequeued_;
+
   // accessed only by the owner
   pointer head_;
   deleter_type delete_;
@@ -316,6 +367,8 @@ private:
     if (head_ != nullptr || fetch_new_data()) {
       auto result = head_;
       head_ = head_->next;
+      dequeued_.store(dequeued_.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
       return result;
     }
     return nullptr;
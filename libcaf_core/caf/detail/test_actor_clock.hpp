@@ -31,11 +31,13 @@ public:
   time_point now() const noexcept override;
 
   /// Tries to dispatch the next timeout or delayed message regardless of its
-  /// timestamp. Returns `false` if `schedule().empty()`, otherwise `true`.
+  /// timestamp, advancing the time to the timestamp if necessary. Returns
+  /// `false` if `schedule().empty()`, otherwise `true`.
   bool dispatch_once();
 
   /// Dispatches all timeouts and delayed messages regardless of their
-  /// timestamp. Returns the number of dispatched events.
+  /// timestamp, advancing the time to the latest timestamp if necessary.
+  /// Returns the number of dispatched events.
   size_t dispatch();
 
   /// Advances the time by `x` and dispatches timeouts and delayed messages.
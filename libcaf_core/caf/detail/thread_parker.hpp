@@ -0,0 +1,120 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_THREAD_PARKER_HPP
+#define CAF_DETAIL_THREAD_PARKER_HPP
+
+#include "caf/config.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#ifndef CAF_LINUX
+#include <mutex>
+#include <condition_variable>
+#endif
+
+#ifdef CAF_MSVC
+#include <intrin.h>
+#endif
+
+namespace caf {
+namespace detail {
+
+/// Signals the CPU that the calling thread runs a busy-wait loop.
+inline void cpu_relax() {
+#if defined(CAF_MSVC)
+  _mm_pause();
+#elif defined(__i386__) || defined(__x86_64__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield" ::: "memory");
+#endif
+}
+
+/// Puts a single reader thread to sleep until a writer signals new data. On
+/// Linux, the reader sleeps on a futex. Other platforms fall back to a
+/// condition variable. Writers only issue a system call (or acquire the mutex)
+/// if the reader actually parked, i.e., waking up a spinning or running reader
+/// costs a single atomic increment.
+class thread_parker {
+public:
+  using clock_type = std::chrono::high_resolution_clock;
+
+  thread_parker();
+
+  /// Blocks the calling thread until `ready()` returns `true`.
+  /// @warning Call only from the reader.
+  template <class Predicate>
+  void park(Predicate ready) {
+    parked_ = true;
+    for (;;) {
+      auto x = seq_.load();
+      if (ready())
+        break;
+      wait(x, nullptr);
+    }
+    parked_ = false;
+  }
+
+  /// Blocks the calling thread until `ready()` returns `true` or the absolute
+  /// `timeout` was reached. Returns `false` on a timeout.
+  /// @warning Call only from the reader.
+  template <class Predicate>
+  bool park_until(Predicate ready, clock_type::time_point timeout) {
+    parked_ = true;
+    auto result = true;
+    for (;;) {
+      auto x = seq_.load();
+      if (ready())
+        break;
+      if (!wait(x, &timeout)) {
+        result = ready();
+        break;
+      }
+    }
+    parked_ = false;
+    return result;
+  }
+
+  /// Wakes up the reader if it is currently parked. Writers must make the
+  /// state change observed by the predicate of the reader visible *before*
+  /// calling this function.
+  void unpark();
+
+private:
+  /// Sleeps while `seq_ == x`, returning `false` if `timeout` expired.
+  bool wait(uint32_t x, const clock_type::time_point* timeout);
+
+  // set by the reader while it runs `park`, read by writers
+  std::atomic<bool> parked_;
+
+  // incremented on each `unpark` call, used as futex word on Linux
+  std::atomic<uint32_t> seq_;
+
+#ifndef CAF_LINUX
+  std::mutex mtx_;
+  std::condition_variable cv_;
+#endif
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_THREAD_PARKER_HPP
@@ -0,0 +1,103 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_TSC_CLOCK_HPP
+#define CAF_DETAIL_TSC_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+
+#include "caf/config.hpp"
+
+#if defined(CAF_MSVC) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define CAF_HAS_TSC
+#elif (defined(CAF_GCC) || defined(CAF_CLANG))                                 \
+  && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define CAF_HAS_TSC
+#endif
+
+namespace caf {
+namespace detail {
+
+/// A cheap clock for instrumenting hot code paths. Reads the time stamp
+/// counter on x86 CPUs and falls back to `std::chrono::steady_clock` with
+/// nanosecond ticks on other platforms. The counter is assumed to be invariant,
+/// i.e., to run at a constant rate on all cores.
+class tsc_clock {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using rep = uint64_t;
+
+  /// Compact time point for storing in padding bytes of other objects.
+  using stamp_type = uint32_t;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Number of low-order bits dropped from a stamp. Stamps have a resolution
+  /// of 16 ticks and wrap around after 2^36 ticks, i.e., about 20 seconds at
+  /// 3 GHz. Longer intervals between two stamps are not measurable.
+  static constexpr int stamp_shift = 4;
+
+  // -- time points ------------------------------------------------------------
+
+  /// Returns the current tick count.
+  static inline rep now() noexcept {
+#   ifdef CAF_HAS_TSC
+    return __rdtsc();
+#   else
+    using namespace std::chrono;
+    auto t = steady_clock::now().time_since_epoch();
+    return static_cast<rep>(duration_cast<nanoseconds>(t).count());
+#   endif
+  }
+
+  /// Returns the current tick count as compact stamp.
+  static inline stamp_type stamp() noexcept {
+    return static_cast<stamp_type>(now() >> stamp_shift);
+  }
+
+  // -- conversions ------------------------------------------------------------
+
+  /// Starts calibrating the clock against `std::chrono::steady_clock` by
+  /// taking a reference point. Only the first call in a process has an
+  /// effect. Instrumented actors call this function when spawned, so
+  /// applications without instrumentation never calibrate the clock.
+  static void calibrate();
+
+  /// Returns the number of ticks per nanosecond. Finishes the calibration on
+  /// first call, which blocks the caller only if the reference point is less
+  /// than a few milliseconds old.
+  static double ticks_per_ns();
+
+  /// Converts a tick count to nanoseconds.
+  static std::chrono::nanoseconds to_duration(rep ticks);
+
+  /// Returns the time elapsed since taking `x`.
+  static inline std::chrono::nanoseconds since(stamp_type x) {
+    auto ticks = static_cast<stamp_type>(stamp() - x);
+    return to_duration(static_cast<rep>(ticks) << stamp_shift);
+  }
+};
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_TSC_CLOCK_HPP
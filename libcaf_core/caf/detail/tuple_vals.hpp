@@ -21,6 +21,7 @@
 
 #include <tuple>
 #include <stdexcept>
+#include <type_traits>
 
 #include "caf/type_nr.hpp"
 #include "caf/serializer.hpp"
@@ -29,7 +30,10 @@
 #include "caf/make_type_erased_value.hpp"
 
 #include "caf/detail/type_list.hpp"
+#include "caf/detail/block_cache.hpp"
+#include "caf/detail/type_list_id.hpp"
 #include "caf/detail/safe_equal.hpp"
+#include "caf/detail/type_traits.hpp"
 #include "caf/detail/message_data.hpp"
 #include "caf/detail/try_serialize.hpp"
 #include "caf/detail/stringification_inspector.hpp"
@@ -80,6 +84,54 @@ struct tuple_vals_type_helper<T, 0> {
   }
 };
 
+/// Tests whether `Ts` are scalar values of at most `CAF_SMALL_MESSAGE_SIZE`
+/// bytes in total.
+template <class... Ts>
+struct is_small_message {
+  static constexpr bool value =
+    conjunction<std::is_scalar<Ts>::value...>::value
+    && sizeof(std::tuple<Ts...>) <= CAF_SMALL_MESSAGE_SIZE;
+};
+
+/// Allocates objects of type `T` holding a small message from thread-local
+/// free lists. Most messages in the control plane of an application carry
+/// only a few scalar values, e.g., an atom and an integer. Recycling their
+/// memory avoids going through the heap for each message. Falls back to
+/// plain `new` and `delete` if CAF builds without the block cache.
+template <class T, class... Ts>
+struct small_message_allocator {
+#ifndef CAF_NO_BLOCK_CACHE
+  using enabled = std::integral_constant<bool, is_small_message<Ts...>::value>;
+#else
+  using enabled = std::false_type;
+#endif
+
+  static void* allocate(size_t n) {
+    return allocate(n, enabled{});
+  }
+
+  static void deallocate(void* ptr) noexcept {
+    deallocate(ptr, enabled{});
+  }
+
+private:
+  static void* allocate(size_t n, std::true_type) {
+    return block_cache::allocate(block_cache::local<T>(), n);
+  }
+
+  static void* allocate(size_t n, std::false_type) {
+    return ::operator new(n);
+  }
+
+  static void deallocate(void* ptr, std::true_type) noexcept {
+    block_cache::deallocate(block_cache::local<T>(), ptr);
+  }
+
+  static void deallocate(void* ptr, std::false_type) noexcept {
+    ::operator delete(ptr);
+  }
+};
+
 template <class Base, class... Ts>
 class tuple_vals_impl : public Base {
 public:
@@ -154,6 +206,10 @@ public:
     return dispatch(pos, source);
   }
 
+  void* native_tuple(const void* id) noexcept override {
+    return id == type_list_id<Ts...>::get() ? &data_ : nullptr;
+  }
+
   uint32_t type_token() const noexcept override {
     return make_type_token<Ts...>();
   }
@@ -219,6 +275,14 @@ public:
 
   using super::super;
 
+  static void* operator new(size_t n) {
+    return small_message_allocator<tuple_vals, Ts...>::allocate(n);
+  }
+
+  static void operator delete(void* ptr) noexcept {
+    small_message_allocator<tuple_vals, Ts...>::deallocate(ptr);
+  }
+
   using super::copy;
 
   message_data::cow_ptr copy() const override {
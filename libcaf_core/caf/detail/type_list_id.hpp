@@ -0,0 +1,43 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_TYPE_LIST_ID_HPP
+#define CAF_DETAIL_TYPE_LIST_ID_HPP
+
+namespace caf {
+namespace detail {
+
+/// Provides a unique address for each list of types. Comparing two addresses
+/// at runtime tells whether two lists are identical without inspecting any
+/// type information.
+template <class... Ts>
+struct type_list_id {
+  static const void* get() noexcept {
+    return &tag;
+  }
+
+  static char tag;
+};
+
+template <class... Ts>
+char type_list_id<Ts...>::tag;
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_TYPE_LIST_ID_HPP
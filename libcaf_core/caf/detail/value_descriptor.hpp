@@ -0,0 +1,105 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_DETAIL_VALUE_DESCRIPTOR_HPP
+#define CAF_DETAIL_VALUE_DESCRIPTOR_HPP
+
+#include <new>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include "caf/type_erased_value.hpp"
+
+#include "caf/detail/type_erased_value_impl.hpp"
+
+namespace caf {
+namespace detail {
+
+/// Describes how to construct a type-erased value in preallocated memory.
+/// Allows message data to store all of its elements in a single memory block
+/// instead of allocating each element individually.
+struct value_descriptor {
+  /// Size of the type-erased value in bytes.
+  size_t size;
+
+  /// Alignment of the type-erased value in bytes.
+  size_t alignment;
+
+  /// Default-constructs a value at `storage`. Set to `nullptr` for types
+  /// without default constructor.
+  type_erased_value* (*make)(void* storage);
+
+  /// Copy-constructs a value at `storage` from `x`, which must be an
+  /// instance of the described type.
+  type_erased_value* (*copy)(void* storage, const type_erased_value& x);
+
+  /// Move-constructs a value at `storage` from `x`, which must be an
+  /// instance of the described type, and destroys `x` afterwards.
+  type_erased_value* (*move)(void* storage, type_erased_value& x);
+};
+
+/// Implements the functions of a `value_descriptor` for `T`.
+template <class T>
+struct value_descriptor_impl {
+  using impl = type_erased_value_impl<T>;
+
+  static type_erased_value* make(void* storage) {
+    return new (storage) impl;
+  }
+
+  static type_erased_value* copy(void* storage, const type_erased_value& x) {
+    return new (storage) impl(static_cast<const impl&>(x));
+  }
+
+  static type_erased_value* move(void* storage, type_erased_value& x) {
+    auto& y = static_cast<impl&>(x);
+    auto result = new (storage) impl(std::move(y));
+    y.~impl();
+    return result;
+  }
+
+  // types without default constructor can only get copied or moved
+  using make_fun = type_erased_value* (*)(void*);
+
+  static constexpr make_fun make_ptr(std::true_type) {
+    return make;
+  }
+
+  static constexpr make_fun make_ptr(std::false_type) {
+    return nullptr;
+  }
+
+  static const value_descriptor* get() {
+    static constexpr value_descriptor result{
+      sizeof(impl), alignof(impl),
+      make_ptr(std::is_default_constructible<T>{}), copy, move};
+    return &result;
+  }
+};
+
+/// Returns the descriptor for values created by `make_type_erased_value<T>`.
+template <class T>
+const value_descriptor* make_value_descriptor() {
+  return value_descriptor_impl<T>::get();
+}
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_DETAIL_VALUE_DESCRIPTOR_HPP
@@ -41,6 +41,12 @@ public:
   ///          executed by this execution unit.
   virtual void exec_later(resumable* ptr) = 0;
 
+  /// Enqueues all jobs in `[first, last)` to the job list of the execution
+  /// unit. The default implementation calls `exec_later` for each job.
+  /// @warning Must only be called from a {@link resumable} currently
+  ///          executed by this execution unit.
+  virtual void exec_later_all(resumable** first, resumable** last);
+
   /// Returns the enclosing actor system.
   /// @warning Must be set before the execution unit calls `resume` on an actor.
   actor_system& system() const {
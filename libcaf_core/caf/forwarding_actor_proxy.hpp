@@ -23,13 +23,14 @@
 #include "caf/actor_proxy.hpp"
 
 #include "caf/detail/shared_spinlock.hpp"
+#include "caf/detail/forwarding_stack.hpp"
 
 namespace caf {
 
 /// Implements a simple proxy forwarding all operations to a manager.
 class forwarding_actor_proxy : public actor_proxy {
 public:
-  using forwarding_stack = std::vector<strong_actor_ptr>;
+  using forwarding_stack = detail::forwarding_stack;
 
   forwarding_actor_proxy(actor_config& cfg, actor dest);
 
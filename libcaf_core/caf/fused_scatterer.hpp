@@ -188,6 +188,7 @@ public:
       if (idx < np)
         return (*i)->path_at(idx);
       idx -= np;
+      ++i;
     }
     return nullptr;
   }
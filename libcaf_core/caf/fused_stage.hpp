@@ -0,0 +1,320 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_FUSED_STAGE_HPP
+#define CAF_FUSED_STAGE_HPP
+
+#include <tuple>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+#include "caf/unit.hpp"
+#include "caf/downstream.hpp"
+
+#include "caf/detail/type_traits.hpp"
+
+namespace caf {
+namespace stream_ops {
+
+// -- operators ----------------------------------------------------------------
+
+// Each operator receives an element plus a continuation `next` for passing
+// results to the remainder of the chain. The member function `flush` runs at
+// the end of each batch and allows operators to emit buffered results.
+
+/// Transforms each element with `F`.
+template <class F>
+class map_op {
+public:
+  template <class T>
+  using output = detail::decay_t<typename std::result_of<F&(T)>::type>;
+
+  map_op(F f) : f_(std::move(f)) {
+    // nop
+  }
+
+  template <class T, class Next>
+  void operator()(T&& x, Next& next) {
+    next(f_(std::forward<T>(x)));
+  }
+
+  template <class Next>
+  void flush(Next&) {
+    // nop
+  }
+
+private:
+  F f_;
+};
+
+/// Drops all elements that do not satisfy `F`.
+template <class F>
+class filter_op {
+public:
+  template <class T>
+  using output = T;
+
+  filter_op(F f) : f_(std::move(f)) {
+    // nop
+  }
+
+  template <class T, class Next>
+  void operator()(T&& x, Next& next) {
+    if (f_(x))
+      next(std::forward<T>(x));
+  }
+
+  template <class Next>
+  void flush(Next&) {
+    // nop
+  }
+
+private:
+  F f_;
+};
+
+/// Transforms each element into a container with any number of elements and
+/// passes the content of the container individually to the next operator.
+template <class F>
+class flat_map_op {
+public:
+  template <class T>
+  using output = typename detail::decay_t<
+                   typename std::result_of<F&(T)>::type
+                 >::value_type;
+
+  flat_map_op(F f) : f_(std::move(f)) {
+    // nop
+  }
+
+  template <class T, class Next>
+  void operator()(T&& x, Next& next) {
+    auto ys = f_(std::forward<T>(x));
+    for (auto& y : ys)
+      next(std::move(y));
+  }
+
+  template <class Next>
+  void flush(Next&) {
+    // nop
+  }
+
+private:
+  F f_;
+};
+
+/// Forwards elements until `F` returns `false` for the first time and drops
+/// all remaining elements afterwards.
+template <class F>
+class take_while_op {
+public:
+  template <class T>
+  using output = T;
+
+  take_while_op(F f) : f_(std::move(f)), done_(false) {
+    // nop
+  }
+
+  template <class T, class Next>
+  void operator()(T&& x, Next& next) {
+    if (!done_ && f_(x))
+      next(std::forward<T>(x));
+    else
+      done_ = true;
+  }
+
+  template <class Next>
+  void flush(Next&) {
+    // nop
+  }
+
+private:
+  F f_;
+  bool done_;
+};
+
+/// Folds all elements of a batch into an accumulator by calling `F` with
+/// signature `void (Acc&, T)` and emits a single result per batch.
+template <class Acc, class F>
+class reduce_op {
+public:
+  template <class T>
+  using output = Acc;
+
+  reduce_op(Acc init, F f)
+      : init_(std::move(init)),
+        acc_(init_),
+        f_(std::move(f)),
+        dirty_(false) {
+    // nop
+  }
+
+  template <class T, class Next>
+  void operator()(T&& x, Next&) {
+    f_(acc_, std::forward<T>(x));
+    dirty_ = true;
+  }
+
+  template <class Next>
+  void flush(Next& next) {
+    if (dirty_) {
+      dirty_ = false;
+      auto result = std::move(acc_);
+      acc_ = init_;
+      next(std::move(result));
+    }
+  }
+
+private:
+  Acc init_;
+  Acc acc_;
+  F f_;
+  bool dirty_;
+};
+
+template <class F>
+map_op<F> map(F f) {
+  return {std::move(f)};
+}
+
+template <class F>
+filter_op<F> filter(F f) {
+  return {std::move(f)};
+}
+
+template <class F>
+flat_map_op<F> flat_map(F f) {
+  return {std::move(f)};
+}
+
+template <class F>
+take_while_op<F> take_while(F f) {
+  return {std::move(f)};
+}
+
+template <class Acc, class F>
+reduce_op<Acc, F> reduce(Acc init, F f) {
+  return {std::move(init), std::move(f)};
+}
+
+} // namespace stream_ops
+
+namespace detail {
+
+/// Computes the output type of a chain of operators for input `T`.
+template <class T, class... Ops>
+struct fused_output {
+  using type = T;
+};
+
+template <class T, class Op, class... Ops>
+struct fused_output<T, Op, Ops...> {
+  using type =
+    typename fused_output<typename Op::template output<T>, Ops...>::type;
+};
+
+/// Passes elements to the operator at position `I` in `Ops`.
+template <size_t I, class Ops, class Out,
+          bool Last = (I == std::tuple_size<Ops>::value)>
+struct fused_next {
+  Ops& ops;
+  downstream<Out>& out;
+
+  template <class T>
+  void operator()(T&& x) {
+    fused_next<I + 1, Ops, Out> next{ops, out};
+    std::get<I>(ops)(std::forward<T>(x), next);
+  }
+};
+
+/// Pushes elements that passed through all operators to the output buffer.
+template <size_t I, class Ops, class Out>
+struct fused_next<I, Ops, Out, true> {
+  Ops& ops;
+  downstream<Out>& out;
+
+  template <class T>
+  void operator()(T&& x) {
+    out.push(std::forward<T>(x));
+  }
+};
+
+template <size_t I, class Ops, class Out>
+enable_if_t<I == std::tuple_size<Ops>::value>
+fused_flush(Ops&, downstream<Out>&) {
+  // end of recursion
+}
+
+template <size_t I, class Ops, class Out>
+enable_if_t<(I < std::tuple_size<Ops>::value)>
+fused_flush(Ops& ops, downstream<Out>& out) {
+  fused_next<I + 1, Ops, Out> next{ops, out};
+  std::get<I>(ops).flush(next);
+  fused_flush<I + 1>(ops, out);
+}
+
+} // namespace detail
+
+/// A stage function that runs a chain of stateless operators inside a single
+/// `stream_stage_impl`. Elements pass through all operators within one batch
+/// loop, i.e., without any additional mailbox hop or credit round-trip.
+///
+/// ~~~
+/// using namespace caf::stream_ops;
+/// self->make_stage(in, [](unit_t&) {},
+///                  fuse<int>(filter([](int x) { return x % 2 == 0; }),
+///                            map([](int x) { return std::to_string(x); })),
+///                  [](unit_t&) {});
+/// ~~~
+template <class In, class... Ops>
+class fused_stage {
+public:
+  using input_type = In;
+
+  using output_type = typename detail::fused_output<In, Ops...>::type;
+
+  using ops_tuple = std::tuple<Ops...>;
+
+  fused_stage(Ops... ops) : ops_(std::move(ops)...) {
+    // nop
+  }
+
+  void operator()(unit_t&, downstream<output_type>& out, In x) {
+    detail::fused_next<0, ops_tuple, output_type> f{ops_, out};
+    f(std::move(x));
+  }
+
+  /// Called by `stream_stage_impl` after processing a batch.
+  void end_batch(unit_t&, downstream<output_type>& out) {
+    detail::fused_flush<0>(ops_, out);
+  }
+
+private:
+  ops_tuple ops_;
+};
+
+/// Fuses `ops` into a single stage function for inputs of type `In`.
+template <class In, class... Ops>
+fused_stage<In, Ops...> fuse(Ops... ops) {
+  return {std::move(ops)...};
+}
+
+} // namespace caf
+
+#endif // CAF_FUSED_STAGE_HPP
@@ -38,6 +38,10 @@ template <class> class weak_intrusive_ptr;
 
 template <class> struct timeout_definition;
 
+// -- 2 param templates --------------------------------------------------------
+
+template <class, class> class keyed_scatterer;
+
 // -- 3 param templates --------------------------------------------------------
 
 template <class, class, int> class actor_cast_access;
@@ -96,12 +100,16 @@ class proxy_registry;
 class stream_manager;
 class random_gatherer;
 class stream_gatherer;
+class stream_registry;
 class actor_companion;
 class mailbox_element;
 class message_handler;
 class scheduled_actor;
+class metrics_registry;
 class stream_scatterer;
+class response_future;
 class response_promise;
+class latency_histogram;
 class event_based_actor;
 class type_erased_tuple;
 class type_erased_value;
@@ -118,7 +126,9 @@ struct exit_msg;
 struct down_msg;
 struct stream_msg;
 struct timeout_msg;
+struct actor_metrics;
 struct group_down_msg;
+struct stream_metrics;
 struct invalid_actor_t;
 struct invalid_actor_addr_t;
 struct illegal_message_element;
@@ -192,11 +202,15 @@ template <class> class type_erased_value_impl;
 template <class> class stream_distribution_tree;
 
 class disposer;
+class print_sink;
 class message_data;
 class group_manager;
 class private_thread;
+class response_slot_pool;
 class dynamic_message_data;
 
+struct value_descriptor;
+
 } // namespace detail
 
 // -- weak pointer aliases -----------------------------------------------------
@@ -25,6 +25,7 @@
 #include "caf/stream_id.hpp"
 #include "caf/stream_msg.hpp"
 #include "caf/stream_aborter.hpp"
+#include "caf/stream_metrics.hpp"
 #include "caf/stream_priority.hpp"
 #include "caf/actor_control_block.hpp"
 
@@ -56,10 +57,11 @@ public:
   /// Priority of incoming batches from this source.
   stream_priority prio;
 
-  /// ID of the last acknowledged batch ID.
+  /// ID of the last acknowledged batch ID or -1 if no batch was acknowledged
+  /// yet.
   int64_t last_acked_batch_id;
 
-  /// ID of the last received batch.
+  /// ID of the last received batch or -1 if no batch was received yet.
   int64_t last_batch_id;
 
   /// Amount of credit we have signaled upstream.
@@ -88,6 +90,9 @@ public:
 
   void emit_ack_batch(long new_demand);
 
+  /// Returns a snapshot of the state of this path.
+  inbound_path_metrics metrics() const;
+
   static void emit_irregular_shutdown(local_actor* self, const stream_id& sid,
                                       const strong_actor_ptr& hdl,
                                       error reason);
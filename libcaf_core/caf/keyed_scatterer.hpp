@@ -0,0 +1,259 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_KEYED_SCATTERER_HPP
+#define CAF_KEYED_SCATTERER_HPP
+
+#include <map>
+#include <deque>
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+
+#include "caf/node_id.hpp"
+#include "caf/buffered_scatterer.hpp"
+
+namespace caf {
+
+/// A scatterer that partitions data by key, i.e., all elements with the same
+/// key go to the same path. This allows parallelizing stateful stages such as
+/// aggregations without sharing state between the workers. Paths are placed
+/// on a consistent hash ring, so adding or removing a path only re-assigns
+/// the keys owned by that path. Each path has its own buffer and never
+/// receives more elements than its credit allows.
+///
+/// `KeyFn` is a default-constructible function object that returns a
+/// hashable key for a `const T&`.
+template <class T, class KeyFn>
+class keyed_scatterer : public buffered_scatterer<T> {
+public:
+  // -- member types -----------------------------------------------------------
+
+  /// Base type.
+  using super = buffered_scatterer<T>;
+
+  using path_ptr = typename super::path_ptr;
+
+  using buffer_type = typename super::buffer_type;
+
+  /// Type of the keys extracted by `KeyFn`.
+  using key_type =
+    typename std::decay<
+      typename std::result_of<KeyFn(const T&)>::type
+    >::type;
+
+  /// Maps positions on the hash ring to paths.
+  using ring_type = std::map<size_t, path_ptr>;
+
+  /// Stores pending elements for each path.
+  using lanes_map = std::unordered_map<path_ptr, buffer_type>;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Number of positions each path occupies on the hash ring. More positions
+  /// result in a more even distribution of keys.
+  static constexpr size_t virtual_nodes = 64;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  keyed_scatterer(local_actor* selfptr) : super(selfptr) {
+    // nop
+  }
+
+  // -- overridden functions ---------------------------------------------------
+
+  using super::remove_path;
+
+  path_ptr add_path(const stream_id& sid, strong_actor_ptr origin,
+                    strong_actor_ptr sink_ptr,
+                    mailbox_element::forwarding_stack stages,
+                    message_id handshake_mid, message handshake_data,
+                    stream_priority prio, bool redeployable) override {
+    auto ptr = super::add_path(sid, std::move(origin), std::move(sink_ptr),
+                               std::move(stages), handshake_mid,
+                               std::move(handshake_data), prio, redeployable);
+    if (ptr != nullptr)
+      add_to_ring(ptr);
+    return ptr;
+  }
+
+  bool remove_path(const stream_id& sid, const actor_addr& x,
+                   error reason, bool silent) override {
+    CAF_LOG_TRACE(CAF_ARG(sid) << CAF_ARG(x)
+                  << CAF_ARG(reason) << CAF_ARG(silent));
+    auto i = this->iter_find(this->paths_, sid, x);
+    if (i != this->paths_.end()) {
+      remove_from_ring(i->get());
+      return super::remove_path(i, std::move(reason), silent);
+    }
+    return false;
+  }
+
+  void close() override {
+    ring_.clear();
+    lanes_.clear();
+    super::close();
+  }
+
+  void abort(error reason) override {
+    ring_.clear();
+    lanes_.clear();
+    super::abort(std::move(reason));
+  }
+
+  long credit() const override {
+    // We receive messages until we have exhausted all downstream credit and
+    // have filled our buffer to its minimum size. Elements in the lane of a
+    // congested path exceed the credit of that path and leave only after its
+    // sink grants more credit. Hence, a hot key reduces the credit we hand
+    // out upstream instead of piling up elements in a single lane.
+    auto result = this->total_credit() + this->min_buffer_size();
+    for (auto& kvp : lanes_) {
+      auto excess = static_cast<long>(kvp.second.size())
+                    - kvp.first->open_credit;
+      if (excess > 0)
+        result -= excess;
+    }
+    return std::max(result, 0L);
+  }
+
+  long buffered() const override {
+    auto result = super::buffered();
+    for (auto& kvp : lanes_)
+      result += static_cast<long>(kvp.second.size());
+    return result;
+  }
+
+  void emit_batches() override {
+    CAF_LOG_TRACE("");
+    fan_out();
+    for (auto& x : this->paths_) {
+      auto i = lanes_.find(x.get());
+      if (i == lanes_.end())
+        continue;
+      auto chunk = super::get_chunk(i->second, x->open_credit);
+      auto csize = static_cast<long>(chunk.size());
+      if (csize > 0)
+        x->emit_batch(csize, make_message(std::move(chunk)));
+    }
+  }
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the path responsible for `key` or `nullptr` if no path exists.
+  path_ptr owner(const key_type& key) const {
+    if (ring_.empty())
+      return nullptr;
+    auto i = ring_.lower_bound(mix(std::hash<key_type>{}(key)));
+    return i != ring_.end() ? i->second : ring_.begin()->second;
+  }
+
+  /// Returns the pending elements for each path.
+  const lanes_map& lanes() const {
+    return lanes_;
+  }
+
+  KeyFn& key_fn() {
+    return key_fn_;
+  }
+
+  const KeyFn& key_fn() const {
+    return key_fn_;
+  }
+
+protected:
+  /// Spreads the content of `buf_` to `lanes_`.
+  void fan_out() {
+    if (ring_.empty())
+      return;
+    for (auto& x : this->buf_)
+      lanes_[owner(key_fn_(x))].push_back(std::move(x));
+    this->buf_.clear();
+  }
+
+  /// Places `ptr` on the ring and moves pending elements of all keys that
+  /// `ptr` takes over into its lane.
+  void add_to_ring(path_ptr ptr) {
+    auto seed = path_hash(*ptr);
+    for (size_t i = 0; i < virtual_nodes; ++i)
+      ring_.emplace(mix(seed + i), ptr);
+    auto& dest = lanes_[ptr];
+    for (auto& kvp : lanes_) {
+      if (kvp.first == ptr)
+        continue;
+      // A key lives in exactly one lane, so moving all of its elements in a
+      // single pass preserves their order.
+      auto& buf = kvp.second;
+      auto stays = [&](const T& x) { return owner(key_fn_(x)) != ptr; };
+      auto first = std::stable_partition(buf.begin(), buf.end(), stays);
+      std::move(first, buf.end(), std::back_inserter(dest));
+      buf.erase(first, buf.end());
+    }
+  }
+
+  /// Removes `ptr` from the ring and hands its pending elements back to the
+  /// central buffer for re-distribution.
+  void remove_from_ring(path_ptr ptr) {
+    for (auto i = ring_.begin(); i != ring_.end();) {
+      if (i->second == ptr)
+        i = ring_.erase(i);
+      else
+        ++i;
+    }
+    auto i = lanes_.find(ptr);
+    if (i == lanes_.end())
+      return;
+    // Elements in the lane are older than elements in the central buffer.
+    auto& buf = this->buf_;
+    buf.insert(buf.begin(), std::make_move_iterator(i->second.begin()),
+               std::make_move_iterator(i->second.end()));
+    lanes_.erase(i);
+  }
+
+  /// Computes a stable seed for the ring positions of `x`.
+  static size_t path_hash(const outbound_path& x) {
+    auto result = std::hash<strong_actor_ptr>{}(x.hdl);
+    if (x.hdl)
+      result ^= std::hash<node_id>{}(x.hdl->node()) + 0x9e3779b9
+                + (result << 6) + (result >> 2);
+    return result;
+  }
+
+  /// Scrambles the bits of `x` to spread adjacent values over the ring.
+  static size_t mix(size_t x) {
+    auto y = static_cast<uint64_t>(x);
+    y = (y ^ (y >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    y = (y ^ (y >> 27)) * 0x94d049bb133111ebULL;
+    return static_cast<size_t>(y ^ (y >> 31));
+  }
+
+  ring_type ring_;
+  lanes_map lanes_;
+  KeyFn key_fn_;
+};
+
+template <class T, class KeyFn>
+constexpr size_t keyed_scatterer<T, KeyFn>::virtual_nodes;
+
+} // namespace caf
+
+#endif // CAF_KEYED_SCATTERER_HPP
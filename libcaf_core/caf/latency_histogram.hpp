@@ -0,0 +1,112 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_LATENCY_HISTOGRAM_HPP
+#define CAF_LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#include "caf/meta/type_name.hpp"
+
+namespace caf {
+
+/// Aggregates duration samples in logarithmic buckets. Recording a sample is
+/// O(1) and requires no allocation, which makes this histogram suitable for
+/// always-on instrumentation of hot code paths.
+class latency_histogram {
+public:
+  // -- member types -----------------------------------------------------------
+
+  using duration_type = std::chrono::nanoseconds;
+
+  // -- constants --------------------------------------------------------------
+
+  /// Bucket `i` counts samples in the range `[2^(i-1), 2^i)` nanoseconds,
+  /// with bucket 0 counting samples of 0ns.
+  static constexpr size_t num_buckets = 64;
+
+  using buckets_array = std::array<uint64_t, num_buckets>;
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  latency_histogram();
+
+  // -- modifiers --------------------------------------------------------------
+
+  /// Adds a sample to the histogram. Negative values count as 0.
+  void record(duration_type x);
+
+  /// Adds all samples of `other` to this histogram.
+  void merge(const latency_histogram& other);
+
+  /// Removes all samples.
+  void reset();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns the number of recorded samples.
+  inline uint64_t count() const {
+    return count_;
+  }
+
+  /// Returns the smallest recorded sample.
+  duration_type min() const;
+
+  /// Returns the largest recorded sample.
+  duration_type max() const;
+
+  /// Returns the arithmetic mean of all samples.
+  duration_type mean() const;
+
+  /// Returns an upper bound for the `q`-quantile with `0 <= q <= 1`, e.g.,
+  /// `percentile(0.99)` for the 99th percentile. The result is accurate up to
+  /// the resolution of the bucket, i.e., a factor of 2.
+  duration_type percentile(double q) const;
+
+  /// Returns the sample counts per bucket.
+  inline const buckets_array& buckets() const {
+    return buckets_;
+  }
+
+  template <class Inspector>
+  friend typename Inspector::result_type inspect(Inspector& f,
+                                                 latency_histogram& x) {
+    return f(meta::type_name("latency_histogram"), x.count_, x.sum_, x.min_,
+             x.max_, x.buckets_);
+  }
+
+private:
+  static size_t bucket_of(uint64_t x);
+
+  uint64_t count_;
+  uint64_t sum_;
+  uint64_t min_;
+  uint64_t max_;
+  buckets_array buckets_;
+};
+
+/// @relates latency_histogram
+std::string to_string(const latency_histogram& x);
+
+} // namespace caf
+
+#endif // CAF_LATENCY_HISTOGRAM_HPP
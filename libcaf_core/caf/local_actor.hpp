@@ -408,6 +408,13 @@ public:
     return mailbox_;
   }
 
+  /// Returns an estimate for the number of messages waiting in the mailbox.
+  /// Safe to call from any thread. Always returns 0 unless the mailbox
+  /// counts enqueue operations, which actor pools enable for their workers.
+  inline size_t mailbox_size_estimate() const {
+    return mailbox_.size_estimate();
+  }
+
   virtual void initialize();
 
   bool cleanup(error&& fail_state, execution_unit* host) override;
@@ -19,7 +19,12 @@
 #ifndef CAF_LOGGER_HPP
 #define CAF_LOGGER_HPP
 
+#include <mutex>
+#include <memory>
 #include <thread>
+#include <vector>
+#include <utility>
+#include <atomic>
 #include <fstream>
 #include <cstring>
 #include <sstream>
@@ -37,8 +42,8 @@
 #include "caf/abstract_actor.hpp"
 #include "caf/deep_to_string.hpp"
 
+#include "caf/detail/binary_log.hpp"
 #include "caf/detail/scope_guard.hpp"
-#include "caf/detail/shared_spinlock.hpp"
 #include "caf/detail/pretty_type_name.hpp"
 #include "caf/detail/single_reader_queue.hpp"
 
@@ -173,15 +178,77 @@ public:
     bool behind_arg_;
   };
 
+  /// Builds the payload of a binary log record with `CAF_ARG`. Stores
+  /// integers, floating point numbers, booleans, and strings in raw form for
+  /// rendering them on the decoder side. Other values still get rendered via
+  /// `deep_to_string`. Writes to a buffer that belongs to the calling thread,
+  /// i.e., only one instance may exist per thread at any time.
+  class record_builder {
+  public:
+    record_builder();
+
+    template <class T>
+    record_builder& operator<<(const T& x) {
+      buf_ += static_cast<char>(detail::value_item);
+      detail::append_log_value(buf_, x);
+      return *this;
+    }
+
+    template <class T>
+    record_builder& operator<<(const arg_wrapper<T>& x) {
+      buf_ += static_cast<char>(detail::arg_item);
+      detail::append_log_string(buf_, x.name);
+      detail::append_log_value(buf_, x.value);
+      return *this;
+    }
+
+    record_builder& operator<<(const std::string& str);
+
+    record_builder& operator<<(const char* str);
+
+    inline const std::string& get() const {
+      return buf_;
+    }
+
+  private:
+    std::string& buf_;
+  };
+
   /// Returns the ID of the actor currently associated to the calling thread.
   actor_id thread_local_aid();
 
   /// Associates an actor ID to the calling thread and returns the last value.
   actor_id thread_local_aid(actor_id aid);
 
+  /// Returns the actor IDs of all running threads that called
+  /// `thread_local_aid(aid)` at least once. Meant for diagnostics only, since
+  /// enumerating threads requires a lock.
+  static std::vector<std::pair<std::thread::id, actor_id>> thread_aids();
+
   /// Writes an entry to the log file.
   void log(event* x);
 
+  /// Writes a binary entry for the call site `site` to the log file.
+  /// @param payload Output of a `record_builder`.
+  void log(uint32_t site, const std::string& payload);
+
+  /// Returns whether this logger writes binary records instead of text.
+  inline bool binary_output() const {
+    return binary_output_;
+  }
+
+  /// Registers a call site for binary logging and returns its ID. All
+  /// arguments must remain valid until the program terminates.
+  static uint32_t register_site(int level, const char* component,
+                                const char* pretty_fun, const char* file_name,
+                                int line_number);
+
+  /// Decodes a binary log file from `in` and renders each event with `lf` to
+  /// `out`, ordered by timestamps. Returns `false` if `in` is not a binary log
+  /// or contains malformed blocks.
+  static bool render_binary(std::istream& in, std::ostream& out,
+                            const line_format& lf);
+
   ~logger() override;
 
   /** @cond PRIVATE */
@@ -224,6 +291,11 @@ public:
   /// Renders `x` using the line format `lf` to `out`.
   void render(std::ostream& out, const line_format& lf, const event& x) const;
 
+  /// Renders all fields of `x` except `thread_field` using the start time
+  /// `t0` to `out`.
+  static void render_field(std::ostream& out, const field& f, const event& x,
+                           timestamp t0);
+
   /// Parses `format_str` into a format description vector.
   /// @warning The returned vector can have pointers into `format_str`.
   static line_format parse_format(const char* format_str);
@@ -258,6 +330,24 @@ private:
 
   void log_last_line();
 
+  // writes `msg` from the call site `site` directly to `file_`
+  void write_binary(uint32_t site, const std::string& msg, timestamp t);
+
+  // returns the ring buffer for the calling thread
+  detail::log_ring* local_ring();
+
+  // writes all records from the ring buffers to `file_` and releases the
+  // buffers of terminated threads
+  size_t drain_rings();
+
+  // wakes up the logger thread if it waits for new records
+  void wake_binary();
+
+  // writes a `site_block` for `site` unless already present in `file_`
+  void write_site(uint32_t site);
+
+  void run_binary();
+
   logger(actor_system& sys);
 
   void init(actor_system_config& cfg);
@@ -271,8 +361,6 @@ private:
   actor_system& system_;
   int level_;
   bool inline_output_;
-  detail::shared_spinlock aids_lock_;
-  std::unordered_map<std::thread::id, actor_id> aids_;
   std::thread thread_;
   std::mutex queue_mtx_;
   std::condition_variable queue_cv_;
@@ -282,6 +370,23 @@ private:
   line_format file_format_;
   line_format console_format_;
   std::fstream file_;
+  // state for binary output
+  bool binary_output_;
+  uint64_t instance_;
+  std::atomic<bool> binary_running_;
+  std::mutex rings_mtx_;
+  // ring buffers of threads that started logging since the last drain
+  std::vector<std::shared_ptr<detail::log_ring>> rings_;
+  // assigns numbers to threads, starting at 1 since number 0 belongs to the
+  // logger thread, guarded by `rings_mtx_`
+  uint32_t next_thread_num_;
+  // accessed only by the logger thread
+  std::vector<std::shared_ptr<detail::log_ring>> known_rings_;
+  // lets the logger thread sleep while all ring buffers are empty
+  std::mutex binary_mtx_;
+  std::condition_variable binary_cv_;
+  std::atomic<bool> binary_idle_;
+  std::vector<bool> known_sites_;
 };
 
 std::string to_string(logger::field_type x);
@@ -339,8 +444,17 @@ inline caf::actor_id caf_set_aid_dummy() { return 0; }
 #define CAF_LOG_IMPL(component, loglvl, message)                               \
   do {                                                                         \
     auto CAF_UNIFYN(caf_logger) = caf::logger::current_logger();               \
-    if (CAF_UNIFYN(caf_logger) != nullptr                                      \
-        && CAF_UNIFYN(caf_logger)->accepts(loglvl, component))                 \
+    if (CAF_UNIFYN(caf_logger) == nullptr                                      \
+        || !CAF_UNIFYN(caf_logger)->accepts(loglvl, component))                \
+      break;                                                                   \
+    if (CAF_UNIFYN(caf_logger)->binary_output()) {                             \
+      static const uint32_t CAF_UNIFYN(caf_log_site) =                         \
+        ::caf::logger::register_site(loglvl, component, CAF_PRETTY_FUN,        \
+                                     __FILE__, __LINE__);                      \
+      CAF_UNIFYN(caf_logger)                                                   \
+        ->log(CAF_UNIFYN(caf_log_site),                                        \
+              (::caf::logger::record_builder{} << message).get());             \
+    } else {                                                                   \
       CAF_UNIFYN(caf_logger)                                                   \
         ->log(new ::caf::logger::event{                                        \
           nullptr, nullptr, loglvl, component, CAF_PRETTY_FUN, __FILE__,       \
@@ -348,6 +462,7 @@ inline caf::actor_id caf_set_aid_dummy() { return 0; }
           ::std::this_thread::get_id(),                                        \
           CAF_UNIFYN(caf_logger)->thread_local_aid(),                          \
           ::caf::make_timestamp()});                                           \
+    }                                                                          \
   } while (false)
 
 #define CAF_PUSH_AID(aarg)                                                     \
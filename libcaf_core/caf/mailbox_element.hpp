@@ -35,14 +35,20 @@
 #include "caf/meta/omittable_if_empty.hpp"
 
 #include "caf/detail/disposer.hpp"
+#include "caf/detail/forwarding_stack.hpp"
+#include "caf/detail/tsc_clock.hpp"
 #include "caf/detail/tuple_vals.hpp"
 #include "caf/detail/type_erased_tuple_view.hpp"
 
 namespace caf {
 
-class mailbox_element : public memory_managed, public message_view {
+/// Header of all messages in a mailbox. Subtypes store the content inline
+/// right after the header, which fits into a single cache line on 64-bit
+/// platforms (one virtual table pointer, two list pointers, sender, ID, an
+/// inline forwarding stack, the `marked` flag and the enqueue timestamp).
+class mailbox_element : public message_view {
 public:
-  using forwarding_stack = std::vector<strong_actor_ptr>;
+  using forwarding_stack = detail::forwarding_stack;
 
   /// Intrusive pointer to the next mailbox element.
   mailbox_element* next;
@@ -50,9 +56,6 @@ public:
   /// Intrusive pointer to the previous mailbox element.
   mailbox_element* prev;
 
-  /// Avoids multi-processing in blocking actors via flagging.
-  bool marked;
-
   /// Source of this message and receiver of the final response.
   strong_actor_ptr sender;
 
@@ -63,6 +66,13 @@ public:
   /// if this is empty then the original sender receives the response.
   forwarding_stack stages;
 
+  /// Avoids multi-processing in blocking actors via flagging.
+  bool marked;
+
+  /// Stores when this element entered the mailbox of an instrumented actor.
+  /// Fits into the padding bytes after `marked`.
+  detail::tsc_clock::stamp_type enqueued;
+
   mailbox_element();
 
   mailbox_element(strong_actor_ptr&& x, message_id y,
@@ -88,7 +98,8 @@ public:
   }
 
 protected:
-  empty_type_erased_tuple dummy_;
+  /// Returns an empty tuple shared by all elements without content.
+  static type_erased_tuple& dummy();
 };
 
 /// @relates mailbox_element
@@ -112,6 +123,18 @@ public:
     // nop
   }
 
+  static void* operator new(size_t n) {
+    using allocator =
+      detail::small_message_allocator<mailbox_element_vals, Ts...>;
+    return allocator::allocate(n);
+  }
+
+  static void operator delete(void* ptr) noexcept {
+    using allocator =
+      detail::small_message_allocator<mailbox_element_vals, Ts...>;
+    allocator::deallocate(ptr);
+  }
+
   type_erased_tuple& content() override {
     return *this;
   }
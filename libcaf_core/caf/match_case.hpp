@@ -31,6 +31,7 @@
 #include "caf/detail/int_list.hpp"
 #include "caf/detail/try_match.hpp"
 #include "caf/detail/type_list.hpp"
+#include "caf/detail/type_list_id.hpp"
 #include "caf/detail/apply_args.hpp"
 #include "caf/detail/type_traits.hpp"
 #include "caf/detail/pseudo_tuple.hpp"
@@ -138,6 +139,26 @@ public:
       detail::pseudo_tuple
     >::type;
 
+  /// Allows invoking `fun_` directly on native tuples, unless it takes
+  /// arguments of type `param<T>`.
+  using has_native_access =
+    std::integral_constant<
+      bool,
+      std::is_same<decayed_arg_types, pattern>::value
+    >;
+
+  using native_tuple =
+    typename detail::tl_apply<
+      pattern,
+      std::tuple
+    >::type;
+
+  using native_id =
+    typename detail::tl_apply<
+      pattern,
+      detail::type_list_id
+    >::type;
+
   trivial_match_case(trivial_match_case&&) = default;
   trivial_match_case(const trivial_match_case&) = default;
   trivial_match_case& operator=(trivial_match_case&&) = default;
@@ -151,6 +172,28 @@ public:
 
   match_case::result invoke(detail::invoke_result_visitor& f,
                             type_erased_tuple& xs) override {
+    return invoke_impl(f, xs, has_native_access{});
+  }
+
+protected:
+  F fun_;
+
+private:
+  // Skips type checking for tuples that store exactly the types of `pattern`,
+  // e.g., messages created by sending to typed actors.
+  match_case::result invoke_impl(detail::invoke_result_visitor& f,
+                                 type_erased_tuple& xs, std::true_type) {
+    auto ptr = xs.native_tuple(native_id::get());
+    if (ptr == nullptr || (is_manipulator && xs.shared()))
+      return invoke_impl(f, xs, std::false_type{});
+    typename detail::il_indices<decayed_arg_types>::type indices;
+    lfinvoker<std::is_same<result_type, void>::value, F> fun{fun_};
+    auto fun_res = apply_args(fun, indices, *static_cast<native_tuple*>(ptr));
+    return f.visit(fun_res) ? match_case::match : match_case::skip;
+  }
+
+  match_case::result invoke_impl(detail::invoke_result_visitor& f,
+                                 type_erased_tuple& xs, std::false_type) {
     detail::meta_elements<pattern> ms;
     // check if try_match() reports success
     if (!detail::try_match(xs, ms.arr.data(), ms.arr.size()))
@@ -165,9 +208,6 @@ public:
     auto fun_res = apply_args(fun, indices, tup);
     return f.visit(fun_res) ? match_case::match : match_case::skip;
   }
-
-protected:
-  F fun_;
 };
 
 struct match_case_info {
@@ -26,6 +26,8 @@
 #include "caf/message_handler.hpp"
 #include "caf/type_erased_value.hpp"
 
+#include "caf/detail/value_descriptor.hpp"
+
 namespace caf {
 
 /// Provides a convenient interface for createing `message` objects
@@ -63,7 +65,10 @@ public:
                     typename std::decay<T>::type
                    >::type
                  >::type;
-    return emplace(make_type_erased_value<type>(std::forward<T>(x)));
+    using impl = detail::type_erased_value_impl<type>;
+    auto d = detail::make_value_descriptor<type>();
+    commit(d, new (allocate(d)) impl(std::forward<T>(x)));
+    return *this;
   }
 
   inline message_builder& append_all() {
@@ -115,6 +120,10 @@ private:
 
   message_builder& emplace(type_erased_value_ptr);
 
+  void* allocate(const detail::value_descriptor* x);
+
+  void commit(const detail::value_descriptor* x, type_erased_value* ptr);
+
   detail::dynamic_message_data* data();
 
   const detail::dynamic_message_data* data() const;
@@ -20,14 +20,16 @@
 #define CAF_MESSAGE_VIEW_HPP
 
 #include "caf/fwd.hpp"
+#include "caf/memory_managed.hpp"
 
 namespace caf {
 
 /// Represents an object pointing to a `type_erased_tuple` that
-/// is convertible to a `message`
-class message_view {
+/// is convertible to a `message`. Inherits from `memory_managed` to allow
+/// mailbox elements to get away with a single virtual table pointer.
+class message_view : public memory_managed {
 public:
-  virtual ~message_view();
+  ~message_view() override;
 
   virtual type_erased_tuple& content() = 0;
 
@@ -0,0 +1,75 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_METRICS_REGISTRY_HPP
+#define CAF_METRICS_REGISTRY_HPP
+
+#include <vector>
+#include <unordered_map>
+
+#include "caf/fwd.hpp"
+#include "caf/duration.hpp"
+#include "caf/actor_metrics.hpp"
+#include "caf/actor_control_block.hpp"
+
+#include "caf/detail/shared_spinlock.hpp"
+
+namespace caf {
+
+/// Keeps track of all local actors that record message processing latencies,
+/// i.e., of all actors spawned with the `instrumented` option or with
+/// `abstract_actor::is_instrumented_flag` set in their `actor_config`. The
+/// registry only stores weak references, i.e., it never keeps an actor alive.
+class metrics_registry {
+public:
+  friend class actor_system;
+
+  using map_type = std::unordered_map<actor_id, weak_actor_ptr>;
+
+  ~metrics_registry();
+
+  /// Adds `x` to the registry.
+  void add(const strong_actor_ptr& x);
+
+  /// Removes the actor with ID `x` from the registry.
+  void erase(actor_id x);
+
+  /// Returns all registered actors that are still alive.
+  std::vector<strong_actor_ptr> actors() const;
+
+  /// Returns the number of registered actors.
+  size_t size() const;
+
+  /// Queries all registered actors for a snapshot of their metrics. Sends
+  /// all queries at once and blocks the caller until all actors responded or
+  /// `timeout` expired, i.e., for at most `timeout` in total. Actors that fail
+  /// to respond in time are omitted from the result.
+  /// @warning Must not get called from inside an actor.
+  std::vector<actor_metrics> collect(const duration& timeout);
+
+private:
+  metrics_registry(actor_system& sys);
+
+  mutable detail::shared_spinlock mtx_;
+  map_type entries_;
+  actor_system& system_;
+};
+
+} // namespace caf
+
+#endif // CAF_METRICS_REGISTRY_HPP
@@ -32,6 +32,8 @@
 #include "caf/message_priority.hpp"
 #include "caf/check_typed_input.hpp"
 
+#include "caf/detail/fan_out.hpp"
+
 namespace caf {
 namespace mixin {
 
@@ -82,6 +84,36 @@ public:
                     dptr()->context(), std::forward<Ts>(xs)...);
   }
 
+  /// Sends `{xs...}` as an asynchronous message to all actors in `dests` with
+  /// priority `mp`. Builds the message only once, allocates all mailbox
+  /// elements at once, and schedules all receivers in a single batch.
+  template <message_priority P = message_priority::normal,
+            class Dests = std::vector<actor>, class... Ts>
+  void send_all(const Dests& dests, Ts&&... xs) {
+    static_assert(sizeof...(Ts) > 0, "no message to send");
+    using dest_type = typename std::decay<decltype(*std::begin(dests))>::type;
+    using token =
+      detail::type_list<
+        typename detail::implicit_conversions<
+          typename std::decay<Ts>::type
+        >::type...>;
+    static_assert(!statically_typed<Subtype>()
+                  || statically_typed<dest_type>(),
+                  "statically typed actors can only send() to other "
+                  "statically typed actors; use anon_send() or request() when "
+                  "communicating with dynamically typed actors");
+    static_assert(response_type_unbox<
+                    signatures_of_t<dest_type>,
+                    token
+                  >::valid,
+                  "receiver does not accept given message");
+    detail::fan_out f{dptr()->system(), dptr()->context(), dptr()->ctrl(),
+                      make_message_id(P),
+                      make_message(std::forward<Ts>(xs)...),
+                      detail::fan_out::count(dests)};
+    f.enqueue_all(dests);
+  }
+
   template <message_priority P = message_priority::normal,
             class Source = actor, class Dest = actor, class... Ts>
   void anon_send(const Dest& dest, Ts&&... xs) {
@@ -28,10 +28,14 @@
 #include "caf/stream_id.hpp"
 #include "caf/stream_msg.hpp"
 #include "caf/stream_aborter.hpp"
+#include "caf/stream_metrics.hpp"
+#include "caf/latency_histogram.hpp"
 #include "caf/actor_control_block.hpp"
 
 #include "caf/meta/type_name.hpp"
 
+#include "caf/detail/ack_window.hpp"
+
 namespace caf {
 
 /// State for a single path to a sink on a `stream_scatterer`.
@@ -76,9 +80,17 @@ public:
   /// advanced batch ID in an ACK message, since CAF uses accumulative ACKs.
   int64_t next_ack_id;
 
-  /// Caches batches until receiving an ACK.
+  /// Caches batches until receiving an ACK. Only used if `redeployable` is
+  /// `true`, since keeping the payload alive is otherwise unnecessary.
   std::deque<std::pair<int64_t, stream_msg::batch>> unacknowledged_batches;
 
+  /// Tracks IDs, sizes, and send times for all batches in the range
+  /// `[next_ack_id, next_batch_id)` without keeping their payload alive.
+  detail::ack_window in_flight;
+
+  /// Time between sending a batch and receiving its ACK.
+  latency_histogram ack_rtt;
+
   /// Caches the initiator of the stream (client) with the original request ID
   /// until the stream handshake is either confirmed or aborted. Once
   /// confirmed, the next stage takes responsibility for answering to the
@@ -106,6 +118,13 @@ public:
   /// `xs_size` and increments `next_batch_id` by 1.
   void emit_batch(long xs_size, message xs);
 
+  /// Releases all batches up to and including `acked_id` and records the
+  /// round-trip time for `acked_id`. Ignores outdated or invalid IDs.
+  void handle_ack_batch(int64_t acked_id);
+
+  /// Returns a snapshot of the state of this path.
+  outbound_path_metrics metrics() const;
+
   static void emit_irregular_shutdown(local_actor* self, const stream_id& sid,
                                       const strong_actor_ptr& hdl,
                                       error reason);
@@ -19,8 +19,9 @@
 #ifndef CAF_POLICY_PROFILED_HPP
 #define CAF_POLICY_PROFILED_HPP
 
+#include <cstddef>
+
 #include "caf/resumable.hpp"
-#include "caf/abstract_actor.hpp"
 
 namespace caf {
 
@@ -40,31 +41,31 @@ template <class Policy>
 struct profiled : Policy {
   using coordinator_type = scheduler::profiled_coordinator<profiled<Policy>>;
 
-  static actor_id id_of(resumable* job) {
-    auto ptr = dynamic_cast<abstract_actor*>(job);
-    return ptr != nullptr ? ptr->id() : 0;
+  profiled() : last_steals_(0) {
+    // nop
   }
 
   template <class Worker>
   void before_resume(Worker* worker, resumable* job) {
     Policy::before_resume(worker, job);
+    // each dequeue steals at most one job
+    auto steals = this->stolen_jobs(worker);
+    auto stolen = steals != last_steals_;
+    last_steals_ = steals;
     auto parent = static_cast<coordinator_type*>(worker->parent());
-    parent->start_measuring(worker->id(), id_of(job));
+    parent->start_measuring(worker->id(), job, stolen);
   }
 
   template <class Worker>
   void after_resume(Worker* worker, resumable* job) {
     Policy::after_resume(worker, job);
     auto parent = static_cast<coordinator_type*>(worker->parent());
-    parent->stop_measuring(worker->id(), id_of(job));
+    parent->stop_measuring(worker->id(), job);
   }
 
-  template <class Worker>
-  void after_completion(Worker* worker, resumable* job) {
-    Policy::after_completion(worker, job);
-    auto parent = static_cast<coordinator_type*>(worker->parent());
-    parent->remove_job(id_of(job));
-  }
+private:
+  // each worker has its own policy object, i.e., no synchronization needed
+  size_t last_steals_;
 };
 
 } // namespace policy
@@ -43,16 +43,31 @@ public:
   template <class Coordinator>
   void central_enqueue(Coordinator* self, resumable* job);
 
+  /// Enqueues all jobs in `[first, last)` to the coordinator.
+  template <class Coordinator>
+  void central_enqueue(Coordinator* self, resumable** first,
+                       resumable** last);
+
   /// Enqueues a new job to the worker's queue from an
   /// external source, i.e., from any other thread.
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job);
 
+  /// Enqueues all jobs in `[first, last)` to the worker's queue from an
+  /// external source, i.e., from any other thread.
+  template <class Worker>
+  void external_enqueue(Worker* self, resumable** first, resumable** last);
+
   /// Enqueues a new job to the worker's queue from an
   /// internal source, i.e., from the same thread.
   template <class Worker>
   void internal_enqueue(Worker* self, resumable* job);
 
+  /// Enqueues all jobs in `[first, last)` to the worker's queue from an
+  /// internal source, i.e., from the same thread.
+  template <class Worker>
+  void internal_enqueue(Worker* self, resumable** first, resumable** last);
+
   /// Called whenever resumable returned for reason `resumable::resume_later`.
   template <class Worker>
   void resume_job_later(Worker* self, resumable* job);
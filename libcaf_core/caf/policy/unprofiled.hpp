@@ -59,6 +59,12 @@ public:
     // nop
   }
 
+  /// Returns how many jobs the worker has stolen from other workers so far.
+  template <class Worker>
+  size_t stolen_jobs(Worker*) {
+    return 0;
+  }
+
 protected:
   // Convenience function to access the data field.
   template <class WorkerOrCoordinator>
@@ -64,21 +64,51 @@ public:
     d(self).cv.notify_one();
   }
 
+  template <class Coordinator>
+  void enqueue(Coordinator* self, resumable** first, resumable** last) {
+    if (first == last)
+      return;
+    queue_type l{first, last};
+    auto n = l.size();
+    std::unique_lock<std::mutex> guard(d(self).lock);
+    d(self).queue.splice(d(self).queue.end(), l);
+    if (n == 1)
+      d(self).cv.notify_one();
+    else
+      d(self).cv.notify_all();
+  }
+
   template <class Coordinator>
   void central_enqueue(Coordinator* self, resumable* job) {
     enqueue(self, job);
   }
 
+  template <class Coordinator>
+  void central_enqueue(Coordinator* self, resumable** first,
+                       resumable** last) {
+    enqueue(self, first, last);
+  }
+
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
     enqueue(self->parent(), job);
   }
 
+  template <class Worker>
+  void external_enqueue(Worker* self, resumable** first, resumable** last) {
+    enqueue(self->parent(), first, last);
+  }
+
   template <class Worker>
   void internal_enqueue(Worker* self, resumable* job) {
     enqueue(self->parent(), job);
   }
 
+  template <class Worker>
+  void internal_enqueue(Worker* self, resumable** first, resumable** last) {
+    enqueue(self->parent(), first, last);
+  }
+
   template <class Worker>
   void resume_job_later(Worker* self, resumable* job) {
     // job has voluntarily released the CPU to let others run instead
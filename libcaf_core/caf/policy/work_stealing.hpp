@@ -23,6 +23,7 @@
 #include <chrono>
 #include <thread>
 #include <random>
+#include <algorithm>
 #include <cstddef>
 
 #include "caf/resumable.hpp"
@@ -46,6 +47,11 @@ public:
 
   using usec = std::chrono::microseconds;
 
+  // Maximum number of consecutive jobs a worker takes from its handoff slot
+  // before checking its queue again. Prevents two actors that keep waking up
+  // each other from starving all other jobs of the worker.
+  static constexpr size_t max_handoffs = 64;
+
   // configuration for aggressive/moderate/relaxed poll strategies.
   struct poll_strategy {
     size_t attempts;
@@ -80,7 +86,11 @@ public:
              usec{p->system().config().work_stealing_moderate_sleep_duration_us}},
             {1, 0, p->system().config().work_stealing_relaxed_steal_interval,
             usec{p->system().config().work_stealing_relaxed_sleep_duration_us}}
-          } {
+          },
+          steals(0),
+          direct_handoff(p->system().config().work_stealing_direct_handoff),
+          next(nullptr),
+          handoffs(0) {
       // nop
     }
 
@@ -91,6 +101,15 @@ public:
     std::default_random_engine rengine;
     std::uniform_int_distribution<size_t> uniform;
     poll_strategy strategies[3];
+    // number of jobs this worker took from others, only accessed by the owner
+    size_t steals;
+    // configures whether `internal_enqueue` uses the handoff slot
+    bool direct_handoff;
+    // the most recently woken job, runs after the current job and is
+    // invisible to other workers (only accessed by the owner)
+    resumable* next;
+    // number of consecutive jobs taken from the handoff slot
+    size_t handoffs;
   };
 
   // Goes on a raid in quest for a shiny new job.
@@ -115,14 +134,49 @@ public:
     w->external_enqueue(job);
   }
 
+  template <class Coordinator>
+  void central_enqueue(Coordinator* self, resumable** first,
+                       resumable** last) {
+    // hand each worker at most one chunk of the batch
+    auto n = static_cast<size_t>(last - first);
+    auto workers = self->num_workers();
+    auto chunk = (n + workers - 1) / workers;
+    while (first != last) {
+      auto w = self->worker_by_id(d(self).next_worker++ % workers);
+      auto next = first + std::min(chunk, static_cast<size_t>(last - first));
+      w->external_enqueue(first, next);
+      first = next;
+    }
+  }
+
   template <class Worker>
   void external_enqueue(Worker* self, resumable* job) {
     d(self).queue.append(job);
   }
 
+  template <class Worker>
+  void external_enqueue(Worker* self, resumable** first, resumable** last) {
+    d(self).queue.append(first, last);
+  }
+
   template <class Worker>
   void internal_enqueue(Worker* self, resumable* job) {
-    d(self).queue.prepend(job);
+    auto& data = d(self);
+    if (!data.direct_handoff) {
+      data.queue.prepend(job);
+      return;
+    }
+    // the previously woken job yields the handoff slot to `job`
+    auto prev = data.next;
+    data.next = job;
+    if (prev != nullptr)
+      data.queue.prepend(prev);
+  }
+
+  template <class Worker>
+  void internal_enqueue(Worker* self, resumable** first, resumable** last) {
+    // other workers steal from the batch if we have too much to do
+    d(self).queue.prepend(first, last);
   }
 
   template <class Worker>
@@ -134,6 +188,17 @@ public:
 
   template <class Worker>
   resumable* dequeue(Worker* self) {
+    // the most recently woken job runs first, unless it got the CPU too many
+    // times in a row already
+    auto& data = d(self);
+    auto job = data.next;
+    if (job != nullptr) {
+      data.next = nullptr;
+      if (++data.handoffs <= max_handoffs)
+        return job;
+      data.queue.append(job);
+    }
+    data.handoffs = 0;
     // we wait for new jobs by polling our external queue: first, we
     // assume an active work load on the machine and perform aggresive
     // polling, then we relax our polling a bit and wait 50 us between
@@ -141,8 +206,7 @@ public:
     // on and poll every 10 ms; this strategy strives to minimize the
     // downside of "busy waiting", which still performs much better than a
     // "signalizing" implementation based on mutexes and conition variables
-    auto& strategies = d(self).strategies;
-    resumable* job = nullptr;
+    auto& strategies = data.strategies;
     for (auto& strat : strategies) {
       for (size_t i = 0; i < strat.attempts; i += strat.step_size) {
         job = d(self).queue.take_head();
@@ -151,8 +215,10 @@ public:
         // try to steal every X poll attempts
         if ((i % strat.steal_interval) == 0) {
           job = try_steal(self);
-          if (job)
+          if (job) {
+            ++d(self).steals;
             return job;
+          }
         }
         if (strat.sleep_duration.count() > 0)
           std::this_thread::sleep_for(strat.sleep_duration);
@@ -163,8 +229,17 @@ public:
     return nullptr;
   }
 
+  template <class Worker>
+  size_t stolen_jobs(Worker* self) {
+    return d(self).steals;
+  }
+
   template <class Worker, class UnaryFunction>
   void foreach_resumable(Worker* self, UnaryFunction f) {
+    if (d(self).next != nullptr) {
+      f(d(self).next);
+      d(self).next = nullptr;
+    }
     auto next = [&] { return d(self).queue.take_head(); };
     for (auto job = next(); job != nullptr; job = next()) {
       f(job);
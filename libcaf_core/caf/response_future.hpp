@@ -0,0 +1,91 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_RESPONSE_FUTURE_HPP
+#define CAF_RESPONSE_FUTURE_HPP
+
+#include "caf/fwd.hpp"
+#include "caf/sec.hpp"
+#include "caf/error.hpp"
+#include "caf/message.hpp"
+#include "caf/expected.hpp"
+#include "caf/message_handler.hpp"
+#include "caf/actor_control_block.hpp"
+
+namespace caf {
+
+/// A future-like handle to the response of a request issued by a non-actor
+/// thread via `actor_system::request`. The handle owns a pooled response
+/// slot and returns it to its pool after receiving the response or when
+/// going out of scope.
+class response_future {
+public:
+  // -- constructors, destructors, and assignment operators --------------------
+
+  response_future() = default;
+
+  response_future(response_future&&) = default;
+
+  response_future& operator=(response_future&& other);
+
+  response_future(const response_future&) = delete;
+
+  response_future& operator=(const response_future&) = delete;
+
+  explicit response_future(strong_actor_ptr slot);
+
+  ~response_future();
+
+  // -- properties -------------------------------------------------------------
+
+  /// Returns whether this handle still waits for a response.
+  inline bool valid() const {
+    return slot_ != nullptr;
+  }
+
+  // -- receiving --------------------------------------------------------------
+
+  /// Blocks until the response arrives or the request times out. Results in
+  /// `sec::invalid_argument` if called more than once.
+  expected<message> get();
+
+  /// Blocks until the response arrives and invokes `f` with its content or
+  /// calls `g` if the request failed or no handler in `f` matches.
+  template <class F, class OnError>
+  void receive(F f, OnError g) {
+    auto res = get();
+    if (!res) {
+      g(res.error());
+      return;
+    }
+    message_handler h{std::move(f)};
+    if (!res->apply(h)) {
+      error err = sec::unexpected_response;
+      g(err);
+    }
+  }
+
+private:
+  void release();
+
+  strong_actor_ptr slot_;
+};
+
+} // namespace caf
+
+#endif // CAF_RESPONSE_FUTURE_HPP
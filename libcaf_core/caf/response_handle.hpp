@@ -28,6 +28,7 @@
 #include "caf/system_messages.hpp"
 
 #include "caf/detail/type_list.hpp"
+#include "caf/detail/response_handler.hpp"
 #include "caf/detail/typed_actor_util.hpp"
 
 namespace caf {
@@ -85,7 +86,8 @@ private:
                   "response handlers are not allowed to have a return "
                   "type other than void");
     detail::type_checker<Output, F>::check();
-    self_->add_awaited_response_handler(mid_, message_handler{std::move(f)});
+    self_->add_awaited_response_handler(
+      mid_, detail::make_response_handler(std::move(f)));
   }
 
   template <class F, class OnError>
@@ -97,8 +99,8 @@ private:
                   "response handlers are not allowed to have a return "
                   "type other than void");
     detail::type_checker<Output, F>::check();
-    self_->add_awaited_response_handler(mid_, behavior{std::move(f),
-                                                       std::move(ef)});
+    self_->add_awaited_response_handler(
+      mid_, detail::make_response_handler(std::move(f), std::move(ef)));
   }
 
   template <class F>
@@ -110,7 +112,8 @@ private:
                   "response handlers are not allowed to have a return "
                   "type other than void");
     detail::type_checker<Output, F>::check();
-    self_->add_multiplexed_response_handler(mid_, behavior{std::move(f)});
+    self_->add_multiplexed_response_handler(
+      mid_, detail::make_response_handler(std::move(f)));
   }
 
   template <class F, class OnError>
@@ -122,8 +125,8 @@ private:
                   "response handlers are not allowed to have a return "
                   "type other than void");
     detail::type_checker<Output, F>::check();
-    self_->add_multiplexed_response_handler(mid_, behavior{std::move(f),
-                                                           std::move(ef)});
+    self_->add_multiplexed_response_handler(
+      mid_, detail::make_response_handler(std::move(f), std::move(ef)));
   }
 
   message_id mid_;
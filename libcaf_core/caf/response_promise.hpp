@@ -28,6 +28,8 @@
 #include "caf/response_type.hpp"
 #include "caf/check_typed_input.hpp"
 
+#include "caf/detail/forwarding_stack.hpp"
+
 namespace caf {
 
 /// A response promise can be used to deliver a uniquely identifiable
@@ -35,7 +37,7 @@ namespace caf {
 /// to the client (i.e. the sender of the request).
 class response_promise {
 public:
-  using forwarding_stack = std::vector<strong_actor_ptr>;
+  using forwarding_stack = detail::forwarding_stack;
 
   /// Constructs an invalid response promise.
   response_promise();
@@ -25,6 +25,7 @@
 #include <exception>
 #endif // CAF_NO_EXCEPTIONS
 
+#include <memory>
 #include <type_traits>
 
 #include "caf/fwd.hpp"
@@ -34,7 +35,9 @@
 #include "caf/no_stages.hpp"
 #include "caf/local_actor.hpp"
 #include "caf/actor_marker.hpp"
+#include "caf/actor_metrics.hpp"
 #include "caf/stream_result.hpp"
+#include "caf/stream_metrics.hpp"
 #include "caf/response_handle.hpp"
 #include "caf/scheduled_actor.hpp"
 #include "caf/random_gatherer.hpp"
@@ -49,6 +52,9 @@
 
 #include "caf/policy/arg.hpp"
 
+#include "caf/detail/response_handler.hpp"
+#include "caf/detail/pending_response_table.hpp"
+
 #include "caf/mixin/sender.hpp"
 #include "caf/mixin/requester.hpp"
 #include "caf/mixin/behavior_changer.hpp"
@@ -91,7 +97,8 @@ public:
   using streams_map = std::unordered_map<stream_id, stream_manager_ptr>;
 
   /// The message ID of an outstanding response with its callback.
-  using pending_response = std::pair<const message_id, behavior>;
+  using pending_response = std::pair<const message_id,
+                                     detail::response_handler>;
 
   /// A pointer to a scheduled actor.
   using pointer = scheduled_actor*;
@@ -597,6 +604,17 @@ public:
   /// manually trigger batches in a source after receiving more data to send.
   void trigger_downstreams();
 
+  /// Returns a snapshot for each stream manager of this actor. Stages appear
+  /// only once, even though they manage two stream IDs.
+  std::vector<stream_metrics> stream_metrics_snapshot();
+
+  // -- instrumentation --------------------------------------------------------
+
+  /// Returns a snapshot of the message processing latencies of this actor.
+  /// The histograms remain empty unless this actor runs with
+  /// `is_instrumented_flag`.
+  actor_metrics metrics_snapshot() const;
+
   /// @cond PRIVATE
 
   // -- timeout management -----------------------------------------------------
@@ -613,10 +631,26 @@ public:
   // -- message processing -----------------------------------------------------
 
   /// Adds a callback for an awaited response.
-  void add_awaited_response_handler(message_id response_id, behavior bhvr);
+  void add_awaited_response_handler(message_id response_id,
+                                    detail::response_handler f);
 
   /// Adds a callback for a multiplexed response.
-  void add_multiplexed_response_handler(message_id response_id, behavior bhvr);
+  void add_multiplexed_response_handler(message_id response_id,
+                                        detail::response_handler f);
+
+  /// Requests a timeout for the response to `mid`. Other than the
+  /// implementation in `local_actor`, this function only stores the
+  /// deadline in the table of pending responses and registers a single
+  /// clock entry for the earliest deadline per actor.
+  void request_response_timeout(const duration& d, message_id mid);
+
+  /// Handles all response timeouts that expired until now. Called when
+  /// receiving a message with ID `pending_response_table::timeout_id()`.
+  void handle_response_timeouts();
+
+  /// Invokes all awaited response handlers in front of the queue with
+  /// `sec::request_timeout` if their deadline passed.
+  void handle_expired_awaited_responses();
 
   /// Returns the category of `x`.
   message_category categorize(mailbox_element& x);
@@ -635,13 +669,17 @@ public:
   ///          `false` otherwise.
   bool activate(execution_unit* ctx);
 
-  /// One-shot interface for activating an actor for a single message.
+  /// One-shot interface for activating an actor for a single message. Writes
+  /// pending output of `aout` before returning.
   activation_result activate(execution_unit* ctx, mailbox_element& x);
 
   /// Interface for activating an actor any
   /// number of additional times after `activate`.
   activation_result reactivate(mailbox_element& x);
 
+  /// Calls `reactivate` and records the queueing and processing time of `x`.
+  activation_result instrumented_reactivate(mailbox_element& x);
+
   // -- behavior management ----------------------------------------------------
 
   /// Returns whether `true` if the behavior stack is not empty or
@@ -649,13 +687,17 @@ public:
   inline bool has_behavior() const {
     return !bhvr_stack_.empty()
            || !awaited_responses_.empty()
-           || !multiplexed_responses_.empty()
+           || pending_responses_.num_handlers() > 0
            || !streams_.empty();
   }
 
+  /// Returns the behavior on top of the behavior stack. Awaited response
+  /// handlers are not behaviors and therefore never returned by this
+  /// function, even if they are active.
+  /// @pre `!bhvr_stack().empty()`
   inline behavior& current_behavior() {
-    return !awaited_responses_.empty() ? awaited_responses_.front().second
-                                        : bhvr_stack_.back();
+    CAF_ASSERT(!bhvr_stack_.empty());
+    return bhvr_stack_.back();
   }
 
   /// Installs a new behavior without performing any type checks.
@@ -838,6 +880,17 @@ protected:
 
   bool handle_stream_msg(mailbox_element& x, behavior* active_behavior);
 
+  /// Handles a `stream_msg::open` sent as response to a request.
+  bool handle_stream_msg(mailbox_element& x,
+                         detail::response_handler& response_handler);
+
+  template <class Handler>
+  bool handle_stream_msg_impl(mailbox_element& x, Handler* handler);
+
+  /// Adds this actor to the system-wide stream registry when managing at
+  /// least one stream and removes it otherwise.
+  void update_stream_registry();
+
   // -- Member Variables -------------------------------------------------------
 
   /// Stores user-defined callbacks for message handling.
@@ -849,8 +902,9 @@ protected:
   /// Stores callbacks for awaited responses.
   std::forward_list<pending_response> awaited_responses_;
 
-  /// Stores callbacks for multiplexed responses.
-  std::unordered_map<message_id, behavior> multiplexed_responses_;
+  /// Stores callbacks for multiplexed responses and the deadlines of all
+  /// outstanding requests.
+  detail::pending_response_table pending_responses_;
 
   /// Customization point for setting a default `message` callback.
   default_handler default_handler_;
@@ -871,6 +925,9 @@ protected:
   /// Holds state for all streams running through this actor.
   streams_map streams_;
 
+  /// Stores latency histograms if this actor runs with `is_instrumented_flag`.
+  std::unique_ptr<actor_metrics> metrics_;
+
 # ifndef CAF_NO_EXCEPTIONS
   /// Customization point for setting a default exception callback.
   exception_handler exception_handler_;
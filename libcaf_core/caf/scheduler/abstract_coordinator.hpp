@@ -21,6 +21,7 @@
 
 #include <chrono>
 #include <atomic>
+#include <memory>
 #include <cstddef>
 
 #include "caf/fwd.hpp"
@@ -49,11 +50,19 @@ public:
 
   explicit abstract_coordinator(actor_system& sys);
 
+  ~abstract_coordinator() override;
+
   /// Returns a handle to the central printing actor.
   inline actor printer() const {
     return actor_cast<actor>(utility_actors_[printer_id]);
   }
 
+  /// Returns the sink for writing the output of {@link aout} directly to
+  /// STDOUT or `nullptr` if all output goes through the printer actor.
+  inline detail::print_sink* print_sink() const {
+    return print_sink_.get();
+  }
+
   /// Returns the number of utility actors.
   inline size_t num_utility_actors() const {
     return utility_actors_.size();
@@ -62,6 +71,10 @@ public:
   /// Puts `what` into the queue of a randomly chosen worker.
   virtual void enqueue(resumable* what) = 0;
 
+  /// Puts all jobs in `[first, last)` into the queues of the workers. The
+  /// default implementation calls `enqueue` for each job.
+  virtual void enqueue_all(resumable** first, resumable** last);
+
   inline actor_system& system() {
     return system_;
   }
@@ -104,6 +117,9 @@ protected:
   /// Background workers, e.g., printer.
   std::array<actor, max_id> utility_actors_;
 
+  /// Writes the output of {@link aout} without involving the printer actor.
+  std::unique_ptr<detail::print_sink> print_sink_;
+
   /// Reference to the host system.
   actor_system& system_;
 
@@ -142,6 +142,10 @@ protected:
     policy_.central_enqueue(this, ptr);
   }
 
+  void enqueue_all(resumable** first, resumable** last) override {
+    policy_.central_enqueue(this, first, last);
+  }
+
   detail::thread_safe_actor_clock& clock() noexcept override {
     return clock_;
   }
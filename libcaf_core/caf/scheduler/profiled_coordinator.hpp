@@ -25,19 +25,24 @@
 #include <mach/mach.h>
 #elif defined(CAF_WINDOWS)
 #include <windows.h>
-#include <psapi.h>
 #else
-#include <sys/resource.h>
+#include <time.h>
 #endif
 
-#include <cmath>
 #include <mutex>
+#include <atomic>
 #include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
 #include <vector>
+#include <cstdint>
 #include <fstream>
-#include <iomanip>
+#include <iostream>
 #include <unordered_map>
+#include <condition_variable>
 
+#include "caf/local_actor.hpp"
 #include "caf/actor_system_config.hpp"
 
 #include "caf/scheduler/coordinator.hpp"
@@ -52,132 +57,122 @@ namespace scheduler {
 
 /// A coordinator which keeps fine-grained profiling state about its workers
 /// and their jobs.
+///
+/// Each worker accumulates statistics for the jobs it runs without any
+/// synchronization and hands them off to an exporter thread once per
+/// `scheduler_profiling_ms_resolution`. Measuring CPU time requires a system
+/// call, hence the profiler only measures every N-th resume of a worker with
+/// N = `scheduler_profiling_sample_interval`.
+///
+/// The exporter writes one CSV line per worker, actor and behavior for each
+/// interval to `scheduler_profiling_output_file`. Behaviors aggregate all
+/// actors with the same name, e.g., all instances of a stateful actor. The
+/// columns are:
+/// - `clock`: UNIX timestamp of the export in microseconds
+/// - `type`: either `worker`, `actor` or `behavior`
+/// - `id`: worker or actor ID (0 for behaviors)
+/// - `name`: name of the actor or behavior (empty for workers), enclosed in
+///   double quotes if it contains a comma, a double quote or a line break
+/// - `resumes`: number of resumes in this interval
+/// - `samples`: number of resumes with CPU time measurements
+/// - `cpu_ns`: CPU time of all sampled resumes in nanoseconds
+/// - `messages`: number of consumed messages in all sampled resumes
+/// - `steals`: number of resumes after stealing the job from another worker
+///
+/// CPU time and messages per resume are `cpu_ns / samples` and
+/// `messages / samples`.
 template <class Policy = policy::profiled<policy::work_stealing>>
 class profiled_coordinator : public coordinator<Policy> {
 public:
   using super = coordinator<Policy>;
-  using clock_type = std::chrono::high_resolution_clock;
 
-  using usec = std::chrono::microseconds;
-  using msec = std::chrono::milliseconds;
-
-  class measurement {
-  public:
-#   if defined(CAF_MACOS) || defined(CAF_IOS)
-    static usec to_usec(const ::time_value_t& tv) {
-      return std::chrono::seconds(tv.seconds) + usec(tv.microseconds);
-    }
-#   elif defined(CAF_WINDOWS)
-    static usec to_usec(FILETIME const& ft) {
-      ULARGE_INTEGER time;
-      time.LowPart = ft.dwLowDateTime;
-      time.HighPart = ft.dwHighDateTime;
-
-      return std::chrono::seconds(time.QuadPart / 10000000) + usec((time.QuadPart % 10000000) / 10);
-    }
-#   else
-    static usec to_usec(const ::timeval& tv) {
-      return std::chrono::seconds(tv.tv_sec) + usec(tv.tv_usec);
-    }
-#   endif
-
-    static measurement take() {
-      auto now = clock_type::now().time_since_epoch();
-      measurement m;
-      m.runtime = std::chrono::duration_cast<usec>(now);
-#     if defined(CAF_MACOS) || defined(CAF_IOS)
-      auto tself = ::mach_thread_self();
-      ::thread_basic_info info;
-      auto count = THREAD_BASIC_INFO_COUNT;
-      auto result = ::thread_info(tself, THREAD_BASIC_INFO,
-                                  reinterpret_cast<thread_info_t>(&info),
-                                  &count);
-      if (result == KERN_SUCCESS && (info.flags & TH_FLAGS_IDLE) == 0) {
-        m.usr = to_usec(info.user_time);
-        m.sys = to_usec(info.system_time);
-      }
-      ::mach_port_deallocate(mach_task_self(), tself);
-#     elif defined(CAF_WINDOWS)
-      FILETIME creation_time, exit_time, kernel_time, user_time;
-      PROCESS_MEMORY_COUNTERS pmc;
-
-      GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time,
-        &kernel_time, &user_time);
-
-      GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc));
-
-      m.mem = pmc.PeakWorkingSetSize / 1024;
-      m.usr = to_usec(user_time);
-      m.sys = to_usec(kernel_time);
-#     elif defined(CAF_CYGWIN)
-      // TODO - decide what to do here instead of zeros
-      m.usr = usec::zero();
-      m.sys = usec::zero();
-      m.mem = 0;
-#     else
-      ::rusage ru;
-      ::getrusage(RUSAGE_THREAD, &ru);
-      m.usr = to_usec(ru.ru_utime);
-      m.sys = to_usec(ru.ru_stime);
-      m.mem = ru.ru_maxrss;
-#     endif
-      return m;
-    }
-
-    measurement& operator+=(const measurement& other) {
-      runtime += other.runtime;
-      usr += other.usr;
-      sys += other.sys;
-      mem += other.mem;
+  using clock_type = std::chrono::steady_clock;
+
+  /// Statistics for a worker, an actor or a behavior.
+  struct stats {
+    std::string name;
+    uint64_t resumes = 0;
+    uint64_t samples = 0;
+    uint64_t cpu_ns = 0;
+    uint64_t messages = 0;
+    uint64_t steals = 0;
+
+    stats& operator+=(const stats& other) {
+      resumes += other.resumes;
+      samples += other.samples;
+      cpu_ns += other.cpu_ns;
+      messages += other.messages;
+      steals += other.steals;
       return *this;
     }
-
-    measurement& operator-=(const measurement& other) {
-      runtime -= other.runtime;
-      usr -= other.usr;
-      sys -= other.sys;
-      mem -= other.mem;
-      return *this;
-    }
-
-    friend measurement operator+(const measurement& x, const measurement& y) {
-      measurement tmp(x);
-      tmp += y;
-      return tmp;
-    }
-
-    friend measurement operator-(const measurement& x, const measurement& y) {
-      measurement tmp(x);
-      tmp -= y;
-      return tmp;
-    }
-
-    friend std::ostream& operator<<(std::ostream& out, const measurement& m) {
-      using std::setw;
-      out << setw(15) << m.runtime.count()
-          << setw(15) << m.usr.count()
-          << setw(15) << m.sys.count()
-          << m.mem;
-      return out;
-    }
-
-    usec runtime = usec::zero();
-    usec usr = usec::zero();
-    usec sys = usec::zero();
-    long mem = 0;
   };
 
+  /// Statistics of all jobs of a worker for one interval.
+  using snapshot = std::unordered_map<actor_id, stats>;
+
+  /// State of a single worker. All members except `outbox` are only
+  /// accessed by the worker itself.
   struct worker_state {
-    actor_id current;
-    measurement job;
-    measurement worker;
-    clock_type::duration last_flush = clock_type::duration::zero();
+    snapshot current;
+    size_t countdown = 0;
+    stats* job = nullptr;
+    local_actor* actor = nullptr;
+    bool sampling = false;
+    uint64_t cpu_start = 0;
+    size_t dequeued_start = 0;
+    clock_type::time_point next_flush;
+    /// Hands off finished snapshots to the exporter.
+    std::atomic<snapshot*> outbox{nullptr};
+    // avoids false sharing with other workers
+    char pad[CAF_CACHE_LINE_SIZE];
+
+    ~worker_state() {
+      delete outbox.load();
+    }
   };
 
-  profiled_coordinator(actor_system& sys) : super{sys} {
+  profiled_coordinator(actor_system& sys) : super{sys}, stopped_(false) {
     // nop
   }
 
+  /// Returns the consumed CPU time of the calling thread in nanoseconds.
+  static uint64_t thread_cpu_ns() {
+#   if defined(CAF_MACOS) || defined(CAF_IOS)
+    auto tself = ::mach_thread_self();
+    ::thread_basic_info info;
+    auto count = THREAD_BASIC_INFO_COUNT;
+    auto result = ::thread_info(tself, THREAD_BASIC_INFO,
+                                reinterpret_cast<thread_info_t>(&info),
+                                &count);
+    ::mach_port_deallocate(mach_task_self(), tself);
+    if (result != KERN_SUCCESS)
+      return 0;
+    auto to_ns = [](const ::time_value_t& tv) {
+      return static_cast<uint64_t>(tv.seconds) * 1000000000u
+             + static_cast<uint64_t>(tv.microseconds) * 1000u;
+    };
+    return to_ns(info.user_time) + to_ns(info.system_time);
+#   elif defined(CAF_WINDOWS)
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time,
+                        &kernel_time, &user_time))
+      return 0;
+    auto to_ns = [](const FILETIME& ft) {
+      ULARGE_INTEGER time;
+      time.LowPart = ft.dwLowDateTime;
+      time.HighPart = ft.dwHighDateTime;
+      return static_cast<uint64_t>(time.QuadPart) * 100u;
+    };
+    return to_ns(user_time) + to_ns(kernel_time);
+#   else
+    ::timespec ts;
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+      return 0;
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000u
+           + static_cast<uint64_t>(ts.tv_nsec);
+#   endif
+  }
+
   void init(actor_system_config& cfg) override {
     super::init(cfg);
     file_.open(cfg.scheduler_profiling_output_file);
@@ -186,113 +181,165 @@ public:
                 << cfg.scheduler_profiling_output_file
                 << R"(" (no profiler output will be generated))"
                 << std::endl;
-    resolution_ = msec{cfg.scheduler_profiling_ms_resolution};
+    resolution_ = std::chrono::milliseconds{
+      cfg.scheduler_profiling_ms_resolution};
+    sample_interval_ = cfg.scheduler_profiling_sample_interval > 0
+                       ? cfg.scheduler_profiling_sample_interval
+                       : 1;
   }
 
   void start() override {
-    clock_start_ = clock_type::now().time_since_epoch();
+    auto num = this->num_workers();
+    auto next_flush = clock_type::now() + resolution_;
+    worker_states_.reserve(num);
+    for (size_t i = 0; i < num; ++i) {
+      worker_states_.emplace_back(new worker_state);
+      worker_states_.back()->next_flush = next_flush;
+    }
+    file_ << "clock,type,id,name,resumes,samples,cpu_ns,messages,steals\n";
     super::start();
-    worker_states_.resize(this->num_workers());
-    using std::setw;
-    file_.flags(std::ios::left);
-    file_ << setw(21) << "clock"     // UNIX timestamp in microseconds
-          << setw(10) << "type"      // "actor" or "worker"
-          << setw(10) << "id"        // ID of the above
-          << setw(15) << "time"      // duration of this sample (cumulative)
-          << setw(15) << "usr"       // time spent in user mode (cumulative)
-          << setw(15) << "sys"       // time spent in kernel model (cumulative)
-          << "mem"                   // used memory (cumulative)
-          << '\n';
+    exporter_ = std::thread{[=] {
+      std::unique_lock<std::mutex> guard{exporter_mtx_};
+      while (!exporter_cv_.wait_for(guard, resolution_,
+                                    [=] { return stopped_; }))
+        export_snapshots();
+    }};
   }
 
   void stop() override {
     CAF_LOG_TRACE("");
     super::stop();
-    auto now = clock_type::now().time_since_epoch();
-    auto wallclock = system_start_ + (now - clock_start_);
-    for (size_t i = 0; i < worker_states_.size(); ++i) {
-      record(wallclock, "worker", i, worker_states_[i].worker);
+    { // lifetime scope of guard
+      std::unique_lock<std::mutex> guard{exporter_mtx_};
+      stopped_ = true;
+      exporter_cv_.notify_all();
     }
+    exporter_.join();
+    // all workers are done, i.e., we can safely access their current state
+    export_snapshots();
+    for (auto& w : worker_states_)
+      w->outbox = new snapshot(std::move(w->current));
+    export_snapshots();
+    file_.flush();
   }
 
-  void start_measuring(size_t worker, actor_id job) {
-    auto& w = worker_states_[worker];
-    w.current = job;
-    w.job = measurement::take();
+  void start_measuring(size_t worker, resumable* job, bool stolen) {
+    auto& w = *worker_states_[worker];
+    auto ptr = dynamic_cast<local_actor*>(job);
+    auto aid = ptr != nullptr ? ptr->id() : 0;
+    auto i = w.current.find(aid);
+    if (i == w.current.end()) {
+      i = w.current.emplace(aid, stats{}).first;
+      if (ptr != nullptr)
+        i->second.name = ptr->name();
+    }
+    w.job = &i->second;
+    w.actor = ptr;
+    ++w.job->resumes;
+    if (stolen)
+      ++w.job->steals;
+    if (w.countdown > 0) {
+      --w.countdown;
+      w.sampling = false;
+      return;
+    }
+    w.countdown = sample_interval_ - 1;
+    w.sampling = true;
+    w.dequeued_start = ptr != nullptr ? ptr->mailbox().dequeue_count() : 0;
+    w.cpu_start = thread_cpu_ns();
   }
 
-  void stop_measuring(size_t worker, actor_id job) {
-    auto m = measurement::take();
-    auto& w = worker_states_[worker];
-    CAF_ASSERT(job == w.current);
-    auto delta = m - w.job;
-    // It's not possible that the wallclock timer is less than actual CPU time
-    // spent. Due to resolution mismatches of the C++ high-resolution clock and
-    // the system timers, this may appear to be the case sometimes. We "fix"
-    // this by adjusting the wallclock to the sum of user and system time, so
-    // that utilization never exceeds 100%.
-    if (delta.runtime < delta.usr + delta.sys) {
-      delta.runtime = delta.usr + delta.sys;
-    }
-    w.worker += delta;
-    report(job, delta);
-    if (m.runtime - w.last_flush >= resolution_) {
-      w.last_flush = m.runtime;
-      auto wallclock = system_start_ + (m.runtime - clock_start_);
-      std::lock_guard<std::mutex> file_guard{file_mtx_};
-      record(wallclock, "worker", worker, w.worker);
-      w.worker = {};
+  void stop_measuring(size_t worker, resumable*) {
+    auto& w = *worker_states_[worker];
+    if (!w.sampling)
+      return;
+    auto cpu = thread_cpu_ns() - w.cpu_start;
+    auto& job = *w.job;
+    ++job.samples;
+    job.cpu_ns += cpu;
+    // the worker still holds a reference to the job, i.e., the actor is
+    // alive; however, another worker may already run it again after it
+    // returned `awaiting_message`, hence the message count is an estimate
+    if (w.actor != nullptr)
+      job.messages += w.actor->mailbox().dequeue_count() - w.dequeued_start;
+    auto now = clock_type::now();
+    if (now < w.next_flush)
+      return;
+    w.next_flush = now + resolution_;
+    // keep accumulating until the exporter took the last snapshot
+    if (w.outbox.load(std::memory_order_acquire) == nullptr) {
+      w.outbox.store(new snapshot(std::move(w.current)),
+                     std::memory_order_release);
+      w.current = snapshot{};
     }
   }
 
-  void remove_job(actor_id job) {
-    std::lock_guard<std::mutex> job_guard{job_mtx_};
-    auto j = jobs_.find(job);
-    if (j != jobs_.end()) {
-      if (job != 0) {
-        auto now = clock_type::now().time_since_epoch();
-        auto wallclock = system_start_ + (now - clock_start_);
-        std::lock_guard<std::mutex> file_guard{file_mtx_};
-        record(wallclock, "actor", job, j->second);
+private:
+  void export_snapshots() {
+    auto now = std::chrono::system_clock::now().time_since_epoch();
+    auto t = std::chrono::duration_cast<std::chrono::microseconds>(now);
+    std::unordered_map<actor_id, stats> actors;
+    std::unordered_map<std::string, stats> behaviors;
+    for (size_t i = 0; i < worker_states_.size(); ++i) {
+      auto& w = *worker_states_[i];
+      std::unique_ptr<snapshot> ptr{
+        w.outbox.exchange(nullptr, std::memory_order_acq_rel)};
+      if (!ptr)
+        continue;
+      stats sum;
+      for (auto& kvp : *ptr) {
+        sum += kvp.second;
+        // jobs migrate between workers, so we merge them first
+        auto& x = actors[kvp.first];
+        if (x.name.empty())
+          x.name = kvp.second.name;
+        x += kvp.second;
       }
-      jobs_.erase(j);
+      record(t.count(), "worker", i, sum);
     }
+    for (auto& kvp : actors) {
+      if (kvp.first == 0)
+        continue;
+      record(t.count(), "actor", kvp.first, kvp.second);
+      auto& x = behaviors[kvp.second.name];
+      x.name = kvp.second.name;
+      x += kvp.second;
+    }
+    for (auto& kvp : behaviors)
+      record(t.count(), "behavior", 0, kvp.second);
   }
 
-  template <class Time, class Label>
-  void record(Time t, Label label, size_t rec_id, const measurement& m) {
-    using std::setw;
-    file_ << setw(21) << t.time_since_epoch().count()
-           << setw(10) << label
-           << setw(10) << rec_id
-           << m
-           << '\n';
+  template <class Rep>
+  void record(Rep t, const char* type, uint64_t id, const stats& x) {
+    file_ << t << ',' << type << ',' << id << ',';
+    write_field(x.name);
+    file_ << ',' << x.resumes << ',' << x.samples << ',' << x.cpu_ns << ','
+          << x.messages << ',' << x.steals << '\n';
   }
 
-  void report(const actor_id& job, const measurement& m) {
-    std::lock_guard<std::mutex> job_guard{job_mtx_};
-    jobs_[job] += m;
-    if (m.runtime - last_flush_ >= resolution_) {
-      last_flush_ = m.runtime;
-      auto now = clock_type::now().time_since_epoch();
-      auto wallclock = system_start_ + (now - clock_start_);
-      std::lock_guard<std::mutex> file_guard{file_mtx_};
-      for (auto& j : jobs_) {
-        record(wallclock, "actor", j.first, j.second);
-        j.second = {};
-      }
+  // quotes `x` if necessary and escapes embedded quotes by doubling them
+  void write_field(const std::string& x) {
+    if (x.find_first_of(",\"\r\n") == std::string::npos) {
+      file_ << x;
+      return;
+    }
+    file_ << '"';
+    for (auto c : x) {
+      if (c == '"')
+        file_ << '"';
+      file_ << c;
     }
+    file_ << '"';
   }
 
-  std::mutex job_mtx_;
-  std::mutex file_mtx_;
+  std::chrono::milliseconds resolution_;
+  size_t sample_interval_;
+  std::vector<std::unique_ptr<worker_state>> worker_states_;
   std::ofstream file_;
-  msec resolution_;
-  std::chrono::system_clock::time_point system_start_;
-  clock_type::duration clock_start_;
-  std::vector<worker_state> worker_states_;
-  std::unordered_map<actor_id, measurement> jobs_;
-  clock_type::duration last_flush_ = clock_type::duration::zero();
+  std::thread exporter_;
+  std::mutex exporter_mtx_;
+  std::condition_variable exporter_cv_;
+  bool stopped_;
 };
 
 } // namespace scheduler
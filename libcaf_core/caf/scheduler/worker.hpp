@@ -70,6 +70,12 @@ public:
     policy_.external_enqueue(this, job);
   }
 
+  /// Enqueues all jobs in `[first, last)` to the worker's queue from an
+  /// external source, i.e., from any other thread.
+  void external_enqueue(job_ptr* first, job_ptr* last) {
+    policy_.external_enqueue(this, first, last);
+  }
+
   /// Enqueues a new job to the worker's queue from an internal
   /// source, i.e., a job that is currently executed by this worker.
   /// @warning Must not be called from other threads.
@@ -78,6 +84,10 @@ public:
     policy_.internal_enqueue(this, job);
   }
 
+  void exec_later_all(job_ptr* first, job_ptr* last) override {
+    policy_.internal_enqueue(this, first, last);
+  }
+
   coordinator_ptr parent() {
     return parent_;
   }
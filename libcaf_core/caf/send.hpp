@@ -32,6 +32,8 @@
 #include "caf/message_priority.hpp"
 #include "caf/check_typed_input.hpp"
 
+#include "caf/detail/fan_out.hpp"
+
 namespace caf {
 
 /// Sends `to` a message under the identity of `from` with priority `prio`.
@@ -76,7 +78,7 @@ void unsafe_send_as(Source* src, const Dest& dest, Ts&&... xs) {
 
 template <class... Ts>
 void unsafe_response(local_actor* self, strong_actor_ptr src,
-                     std::vector<strong_actor_ptr> stages, message_id mid,
+                     mailbox_element::forwarding_stack stages, message_id mid,
                      Ts&&... xs) {
   strong_actor_ptr next;
   if (stages.empty()) {
@@ -107,6 +109,29 @@ void anon_send(const Dest& dest, Ts&&... xs) {
                   std::forward<Ts>(xs)...);
 }
 
+/// Anonymously sends a message to all actors in `dests`. All receivers share
+/// the same content and the mailbox elements get allocated only once.
+template <message_priority P = message_priority::normal,
+          class Dests = std::vector<actor>, class... Ts>
+void anon_send_all(const Dests& dests, Ts&&... xs) {
+  static_assert(sizeof...(Ts) > 0, "no message to send");
+  using dest_type = typename std::decay<decltype(*std::begin(dests))>::type;
+  using token = detail::type_list<detail::strip_and_convert_t<Ts>...>;
+  static_assert(response_type_unbox<signatures_of_t<dest_type>, token>::valid,
+                "receiver does not accept given message");
+  auto i = std::begin(dests);
+  auto e = std::end(dests);
+  while (i != e && !*i)
+    ++i;
+  if (i == e)
+    return;
+  auto& sys = actor_cast<abstract_actor*>(*i)->home_system();
+  detail::fan_out f{sys, nullptr, nullptr, make_message_id(P),
+                    make_message(std::forward<Ts>(xs)...),
+                    detail::fan_out::count(dests)};
+  f.enqueue_all(dests);
+}
+
 /// Anonymously sends `dest` an exit message.
 template <class Dest>
 void anon_send_exit(const Dest& dest, exit_reason reason) {
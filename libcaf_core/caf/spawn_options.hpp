@@ -35,7 +35,8 @@ enum class spawn_options : int {
   detach_flag = 0x04,
   hide_flag = 0x08,
   priority_aware_flag = 0x20,
-  lazy_init_flag = 0x40
+  lazy_init_flag = 0x40,
+  instrumented_flag = 0x80
 };
 #endif
 
@@ -72,6 +73,10 @@ constexpr spawn_options priority_aware = spawn_options::priority_aware_flag;
 /// initialization until a message arrives.
 constexpr spawn_options lazy_init = spawn_options::lazy_init_flag;
 
+/// Causes the new actor to record message processing latencies.
+/// @see metrics_registry
+constexpr spawn_options instrumented = spawn_options::instrumented_flag;
+
 /// Checks wheter `haystack` contains `needle`.
 /// @relates spawn_options
 constexpr bool has_spawn_option(spawn_options haystack, spawn_options needle) {
@@ -114,6 +119,12 @@ constexpr bool has_lazy_init_flag(spawn_options opts) {
   return has_spawn_option(opts, lazy_init);
 }
 
+/// Checks wheter the {@link instrumented} flag is set in `opts`.
+/// @relates spawn_options
+constexpr bool has_instrumented_flag(spawn_options opts) {
+  return has_spawn_option(opts, instrumented);
+}
+
 /// @}
 
 /// @cond PRIVATE
@@ -25,7 +25,9 @@
 
 #include "caf/fwd.hpp"
 #include "caf/ref_counted.hpp"
+#include "caf/stream_metrics.hpp"
 #include "caf/mailbox_element.hpp"
+#include "caf/latency_histogram.hpp"
 
 namespace caf {
 
@@ -156,6 +158,18 @@ public:
   /// messages.
   virtual bool generate_messages();
 
+  // -- instrumentation --------------------------------------------------------
+
+  /// Returns a snapshot of all paths and counters of this manager. Leaves
+  /// `owner` and `owner_name` empty, since the manager has no access to its
+  /// parent.
+  stream_metrics metrics();
+
+  /// Returns the per-element processing time of incoming batches.
+  inline const latency_histogram& processing_time() const {
+    return processing_time_;
+  }
+
 protected:
   // -- implementation hooks for sinks -----------------------------------------
 
@@ -188,6 +202,9 @@ protected:
   /// Pointer to the parent actor.
   local_actor* self_;
 
+  /// Measures `process_batch` divided by the size of each batch.
+  latency_histogram processing_time_;
+
   /// Keeps track of pending handshakes.
   
 };
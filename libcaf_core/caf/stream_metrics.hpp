@@ -0,0 +1,122 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_STREAM_METRICS_HPP
+#define CAF_STREAM_METRICS_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "caf/fwd.hpp"
+#include "caf/stream_id.hpp"
+#include "caf/actor_addr.hpp"
+#include "caf/latency_histogram.hpp"
+
+#include "caf/meta/type_name.hpp"
+
+namespace caf {
+
+/// Snapshot of an `inbound_path`, i.e., a path to a source.
+struct inbound_path_metrics {
+  /// Stream ID used on this path.
+  stream_id sid;
+
+  /// Handle to the source.
+  actor_addr hdl;
+
+  /// Amount of credit we have signaled upstream but not received yet.
+  long assigned_credit;
+
+  /// ID of the last received batch.
+  int64_t last_batch_id;
+
+  /// ID of the last acknowledged batch.
+  int64_t last_acked_batch_id;
+};
+
+/// @relates inbound_path_metrics
+template <class Inspector>
+typename Inspector::result_type inspect(Inspector& f,
+                                        inbound_path_metrics& x) {
+  return f(meta::type_name("inbound_path_metrics"), x.sid, x.hdl, x.assigned_credit,
+           x.last_batch_id, x.last_acked_batch_id);
+}
+
+/// Snapshot of an `outbound_path`, i.e., a path to a sink.
+struct outbound_path_metrics {
+  /// Stream ID used on this path.
+  stream_id sid;
+
+  /// Handle to the sink.
+  actor_addr hdl;
+
+  /// Currently available credit.
+  long open_credit;
+
+  /// Number of elements sent to the sink but not acknowledged yet.
+  long elements_in_flight;
+
+  /// Number of batches sent to the sink but not acknowledged yet.
+  int64_t batches_in_flight;
+
+  /// Time between sending a batch and receiving its ACK.
+  latency_histogram ack_rtt;
+};
+
+/// @relates outbound_path_metrics
+template <class Inspector>
+typename Inspector::result_type inspect(Inspector& f,
+                                        outbound_path_metrics& x) {
+  return f(meta::type_name("outbound_path_metrics"), x.sid, x.hdl, x.open_credit,
+           x.elements_in_flight, x.batches_in_flight, x.ack_rtt);
+}
+
+/// Snapshot of a stream manager, i.e., of all paths and buffers for one
+/// stream at one actor. A stage uses different stream IDs for its inbound
+/// and outbound paths.
+struct stream_metrics {
+  /// ID of the actor that manages the stream.
+  actor_id owner;
+
+  /// Name of the actor that manages the stream.
+  std::string owner_name;
+
+  /// Number of elements waiting in the scatterer for downstream credit.
+  long buffered;
+
+  /// Per-element processing time, measured per batch.
+  latency_histogram processing_time;
+
+  /// Snapshots of all paths to sources for this stream.
+  std::vector<inbound_path_metrics> inbound_paths;
+
+  /// Snapshots of all paths to sinks for this stream.
+  std::vector<outbound_path_metrics> outbound_paths;
+};
+
+/// @relates stream_metrics
+template <class Inspector>
+typename Inspector::result_type inspect(Inspector& f, stream_metrics& x) {
+  return f(meta::type_name("stream_metrics"), x.owner, x.owner_name,
+           x.buffered, x.processing_time, x.inbound_paths, x.outbound_paths);
+}
+
+} // namespace caf
+
+#endif // CAF_STREAM_METRICS_HPP
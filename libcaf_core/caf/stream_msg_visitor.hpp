@@ -28,6 +28,8 @@
 #include "caf/stream_manager.hpp"
 #include "caf/scheduled_actor.hpp"
 
+#include "caf/detail/response_handler.hpp"
+
 namespace caf {
 
 class stream_msg_visitor {
@@ -39,6 +41,9 @@ public:
   stream_msg_visitor(scheduled_actor* self, const stream_msg& msg,
                      behavior* bhvr);
 
+  stream_msg_visitor(scheduled_actor* self, const stream_msg& msg,
+                     detail::response_handler* response_handler);
+
   result_type operator()(stream_msg::open& x);
 
   result_type operator()(stream_msg::ack_open& x);
@@ -80,6 +85,7 @@ private:
   const stream_id& sid_;
   const actor_addr& sender_;
   behavior* bhvr_;
+  detail::response_handler* response_handler_;
 };
 
 } // namespace caf
@@ -77,12 +77,13 @@ protected:
 
   error process_batch(message& msg) override {
     CAF_LOG_TRACE(CAF_ARG(msg));
-    using vec_type = std::vector<output_type>;
+    using vec_type = std::vector<input_type>;
     if (msg.match_elements<vec_type>()) {
       auto& xs = msg.get_as<vec_type>(0);
       downstream<typename DownstreamPolicy::value_type> ds{out_.buf()};
       for (auto& x : xs)
         fun_(state_, ds, x);
+      end_batch(fun_, ds, 0);
       return none;
     }
     CAF_LOG_ERROR("received unexpected batch type");
@@ -110,6 +111,18 @@ protected:
   }
 
 private:
+  /// Calls `f.end_batch(state, out)` if `F` provides this member function.
+  template <class F, class Downstream>
+  auto end_batch(F& f, Downstream& out, int)
+  -> decltype(f.end_batch(std::declval<state_type&>(), out)) {
+    return f.end_batch(state_, out);
+  }
+
+  template <class F, class Downstream>
+  void end_batch(F&, Downstream&, long) {
+    // nop
+  }
+
   state_type state_;
   Fun fun_;
   Cleanup cleanup_;
@@ -0,0 +1,167 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#ifndef CAF_TUPLE_VIEW_HPP
+#define CAF_TUPLE_VIEW_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "caf/fwd.hpp"
+#include "caf/type_erased_tuple.hpp"
+
+namespace caf {
+
+/// A non-owning view to a subset of one or more type-erased tuples. Other
+/// than `message::drop`, `message::slice`, or `message::concat`, creating a
+/// view neither allocates memory nor adds a layer of indirection, since
+/// each view refers to the original tuples directly. Views can be passed to
+/// behaviors and message handlers as-is.
+///
+/// A view must not outlive the tuples it refers to. Use `to_message` to
+/// create an independent message from a view.
+///
+/// Note that `message::drop`, `message::slice`, and `operator+` on messages
+/// still allocate, because the resulting message owns its data. Code that
+/// only needs to inspect or dispatch the result should build a view from
+/// the original message instead. Since each view stores at most
+/// `max_segments` ranges, concatenating many unrelated tuples requires
+/// converting intermediate results via `to_message`.
+class tuple_view : public type_erased_tuple {
+public:
+  // -- constants --------------------------------------------------------------
+
+  /// Maximum number of distinct ranges a single view can refer to.
+  static constexpr size_t max_segments = 4;
+
+  // -- member types -----------------------------------------------------------
+
+  /// A contiguous range of elements in a tuple.
+  struct segment {
+    const type_erased_tuple* source;
+    size_t offset;
+    size_t size;
+  };
+
+  // -- constructors, destructors, and assignment operators --------------------
+
+  tuple_view();
+
+  tuple_view(const tuple_view&) = default;
+
+  tuple_view& operator=(const tuple_view&) = default;
+
+  /// Creates a view to all elements of `xs`. Passing a view as
+  /// `type_erased_tuple` creates a view to that view rather than a copy.
+  tuple_view(const type_erased_tuple& xs);
+
+  /// Creates a view to all elements of `xs`.
+  tuple_view(const message& xs);
+
+  ~tuple_view() override;
+
+  // -- overridden modifiers of type_erased_tuple ------------------------------
+
+  void* get_mutable(size_t pos) override;
+
+  error load(size_t pos, deserializer& source) override;
+
+  // -- overridden observers of type_erased_tuple ------------------------------
+
+  size_t size() const noexcept override;
+
+  uint32_t type_token() const noexcept override;
+
+  rtti_pair type(size_t pos) const noexcept override;
+
+  const void* get(size_t pos) const noexcept override;
+
+  std::string stringify(size_t pos) const override;
+
+  type_erased_value_ptr copy(size_t pos) const override;
+
+  error save(size_t pos, serializer& sink) const override;
+
+  /// Always returns `true`, because changes to the elements of a view are
+  /// visible to the owners of the viewed tuples.
+  bool shared() const noexcept override;
+
+  // -- views ------------------------------------------------------------------
+
+  /// Returns a view to `n` elements, starting at position `pos`.
+  tuple_view slice(size_t pos, size_t n) const;
+
+  /// Returns a view without the first `n` elements.
+  tuple_view drop(size_t n) const;
+
+  /// Returns a view without the last `n` elements.
+  tuple_view drop_right(size_t n) const;
+
+  /// Returns a view to the first `n` elements.
+  inline tuple_view take(size_t n) const {
+    return slice(0, n);
+  }
+
+  /// Returns a view to the last `n` elements.
+  inline tuple_view take_right(size_t n) const {
+    return n >= size_ ? *this : drop(size_ - n);
+  }
+
+  /// Returns a view to all elements of `xs` followed by all elements of `ys`.
+  /// Adjacent ranges of the same tuple collapse into a single segment.
+  /// @pre the result consists of no more than `max_segments` segments
+  /// @throws std::runtime_error if the result has more than `max_segments`
+  ///         segments
+  friend tuple_view operator+(const tuple_view& xs, const tuple_view& ys);
+
+  // -- observers --------------------------------------------------------------
+
+  /// Returns the number of segments in this view.
+  inline size_t num_segments() const noexcept {
+    return num_segments_;
+  }
+
+  /// Copies all elements of this view into a new message.
+  message to_message() const;
+
+private:
+  // -- utility functions ------------------------------------------------------
+
+  /// Appends the range `[offset, offset + n)` of `xs`.
+  void append(const type_erased_tuple& xs, size_t offset, size_t n);
+
+  /// Returns the tuple and position of the element at `pos`.
+  std::pair<type_erased_tuple*, size_t> select(size_t pos) const noexcept;
+
+  // -- data members -----------------------------------------------------------
+
+  std::array<segment, max_segments> segments_;
+  size_t num_segments_;
+  size_t size_;
+  uint32_t type_token_;
+};
+
+/// @relates tuple_view
+tuple_view operator+(const tuple_view& xs, const tuple_view& ys);
+
+} // namespace caf
+
+#endif // CAF_TUPLE_VIEW_HPP
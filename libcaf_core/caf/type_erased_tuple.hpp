@@ -62,6 +62,13 @@ public:
   /// Load the content for the tuple from `source`.
   error load(deserializer& source);
 
+  /// Returns a pointer to all elements as `std::tuple<Ts...>` if this tuple
+  /// stores its elements in a native tuple and `id` is the result of
+  /// `detail::type_list_id<Ts...>::get()`, otherwise `nullptr`. Allows
+  /// callers with static type information to skip runtime type checks.
+  /// The default implementation returns `nullptr`.
+  virtual void* native_tuple(const void* id) noexcept;
+
   // -- pure virtual observers -------------------------------------------------
 
   /// Returns the size of this tuple.
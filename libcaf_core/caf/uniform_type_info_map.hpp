@@ -74,6 +74,10 @@ public:
 
   type_erased_value_ptr make_value(const std::type_info& x) const;
 
+  /// Returns the descriptor for in-place construction of values with the
+  /// portable name `x` or `nullptr` if no descriptor was found.
+  const detail::value_descriptor* descriptor(const std::string& x) const;
+
   /// Returns the portable name for given type information or `nullptr`
   /// if no mapping was found.
   const std::string* portable_name(uint16_t nr, const std::type_info* ti) const;
@@ -97,6 +101,7 @@ private:
 
   // message types
   std::array<value_factory_kvp, type_nrs - 1> builtin_;
+  std::array<const detail::value_descriptor*, type_nrs - 1> builtin_descriptors_;
   value_factories_by_name ad_hoc_;
   mutable detail::shared_spinlock ad_hoc_mtx_;
 
@@ -42,6 +42,8 @@
 
 #include "caf/policy/work_stealing.hpp"
 
+#include "caf/detail/print_sink.hpp"
+
 #include "caf/logger.hpp"
 
 namespace caf {
@@ -244,6 +246,9 @@ void abstract_coordinator::start() {
   // launch utility actors
   static constexpr auto fs = hidden + detached;
   utility_actors_[printer_id] = system_.spawn<printer_actor, fs>();
+#ifndef CAF_NO_THREAD_LOCAL
+  print_sink_.reset(new detail::print_sink(printer()));
+#endif
 }
 
 void abstract_coordinator::init(actor_system_config& cfg) {
@@ -275,6 +280,15 @@ abstract_coordinator::abstract_coordinator(actor_system& sys)
   // nop
 }
 
+abstract_coordinator::~abstract_coordinator() {
+  // nop
+}
+
+void abstract_coordinator::enqueue_all(resumable** first, resumable** last) {
+  for (; first != last; ++first)
+    enqueue(*first);
+}
+
 void abstract_coordinator::cleanup_and_release(resumable* ptr) {
   class dummy_unit : public execution_unit {
   public:
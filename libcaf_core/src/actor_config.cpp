@@ -45,6 +45,7 @@ std::string to_string(const actor_config& x) {
   add(abstract_actor::is_blocking_flag, "blocking_flag");
   add(abstract_actor::is_priority_aware_flag, "priority_aware_flag");
   add(abstract_actor::is_hidden_flag, "hidden_flag");
+  add(abstract_actor::is_instrumented_flag, "instrumented_flag");
   result += ")";
   return result;
 }
@@ -23,23 +23,37 @@
 #include "caf/abstract_actor.hpp"
 #include "caf/default_attachable.hpp"
 
+#include "caf/detail/print_sink.hpp"
+
 #include "caf/scheduler/abstract_coordinator.hpp"
 
 namespace caf {
 
 actor_ostream::actor_ostream(local_actor* self)
     : self_(self->id()),
-      printer_(self->home_system().scheduler().printer()) {
+      sink_(self->home_system().scheduler().print_sink()),
+      deferred_(!self->getf(abstract_actor::is_blocking_flag)) {
   init(self);
 }
 
 actor_ostream::actor_ostream(scoped_actor& self)
     : self_(self->id()),
-      printer_(self->home_system().scheduler().printer()) {
+      sink_(self->home_system().scheduler().print_sink()),
+      deferred_(false) {
   init(actor_cast<abstract_actor*>(self));
 }
 
+actor_ostream::~actor_ostream() {
+  // event-based actors flush at the end of each resume
+  if (sink_ != nullptr && !deferred_)
+    sink_->flush();
+}
+
 actor_ostream& actor_ostream::write(std::string arg) {
+  if (sink_ != nullptr) {
+    sink_->write(self_, std::move(arg));
+    return *this;
+  }
   printer_->enqueue(make_mailbox_element(nullptr, make_message_id(), {},
                                          add_atom::value, self_,
                                          std::move(arg)),
@@ -48,6 +62,10 @@ actor_ostream& actor_ostream::write(std::string arg) {
 }
 
 actor_ostream& actor_ostream::flush() {
+  if (sink_ != nullptr) {
+    sink_->flush(self_);
+    return *this;
+  }
   printer_->enqueue(make_mailbox_element(nullptr, make_message_id(), {},
                                           flush_atom::value, self_),
                     nullptr);
@@ -57,7 +75,12 @@ actor_ostream& actor_ostream::flush() {
 void actor_ostream::redirect(abstract_actor* self, std::string fn, int flags) {
   if (self == nullptr)
     return;
-  auto pr = self->home_system().scheduler().printer();
+  auto& sched = self->home_system().scheduler();
+  if (sched.print_sink() != nullptr) {
+    sched.print_sink()->redirect(self->id(), std::move(fn), flags);
+    return;
+  }
+  auto pr = sched.printer();
   pr->enqueue(make_mailbox_element(nullptr, make_message_id(), {},
                                     redirect_atom::value, self->id(),
                                     std::move(fn), flags),
@@ -65,6 +88,10 @@ void actor_ostream::redirect(abstract_actor* self, std::string fn, int flags) {
 }
 
 void actor_ostream::redirect_all(actor_system& sys, std::string fn, int flags) {
+  if (sys.scheduler().print_sink() != nullptr) {
+    sys.scheduler().print_sink()->redirect_all(std::move(fn), flags);
+    return;
+  }
   auto pr = sys.scheduler().printer();
   pr->enqueue(make_mailbox_element(nullptr, make_message_id(), {},
                                     redirect_atom::value,
@@ -75,6 +102,8 @@ void actor_ostream::redirect_all(actor_system& sys, std::string fn, int flags) {
 void actor_ostream::init(abstract_actor* self) {
   if (!self->getf(abstract_actor::has_used_aout_flag))
     self->setf(abstract_actor::has_used_aout_flag);
+  if (sink_ == nullptr)
+    printer_ = self->home_system().scheduler().printer();
 }
 
 actor_ostream aout(local_actor* self) {
@@ -20,10 +20,16 @@
 
 #include <atomic>
 #include <random>
+#include <cstdint>
+#include <unordered_map>
 
+#include "caf/sec.hpp"
 #include "caf/send.hpp"
+#include "caf/logger.hpp"
+#include "caf/local_actor.hpp"
 #include "caf/default_attachable.hpp"
 
+#include "caf/detail/fan_out.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
 
 namespace caf {
@@ -54,9 +60,10 @@ void broadcast_dispatch(actor_system&, actor_pool::uplock&,
                         const actor_pool::actor_vec& vec,
                         mailbox_element_ptr& ptr, execution_unit* host) {
   CAF_ASSERT(!vec.empty());
-  auto msg = ptr->move_content_to_message();
-  for (auto& worker : vec)
-    worker->enqueue(ptr->sender, ptr->mid, msg, host);
+  auto& sys = vec.front()->home_system();
+  detail::fan_out f{sys, host, ptr->sender, ptr->mid,
+                    ptr->move_content_to_message(), vec.size()};
+  f.enqueue_all(vec);
 }
 
 } // namespace <anonymous>
@@ -65,28 +72,165 @@ actor_pool::policy actor_pool::broadcast() {
   return broadcast_dispatch;
 }
 
+namespace {
+
+/// A lock-free pseudo random number generator based on SplitMix64. Allows
+/// dispatching to random workers while holding only a shared lock.
+class atomic_rng {
+public:
+  atomic_rng() : state_(seed()) {
+    // nop
+  }
+
+  atomic_rng(const atomic_rng&) : state_(seed()) {
+    // nop
+  }
+
+  /// Returns a random number in the range `[0, n)`.
+  size_t operator()(size_t n) {
+    auto x = state_.fetch_add(0x9e3779b97f4a7c15ULL, std::memory_order_relaxed)
+             + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return static_cast<size_t>(x % n);
+  }
+
+private:
+  static uint64_t seed() {
+    std::random_device rd;
+    return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+  }
+
+  std::atomic<uint64_t> state_;
+};
+
+/// Returns the number of messages waiting for `x` or 0 for non-local actors.
+size_t queue_depth(const actor& x) {
+  auto ptr = dynamic_cast<local_actor*>(actor_cast<abstract_actor*>(x));
+  return ptr != nullptr ? ptr->mailbox_size_estimate() : 0;
+}
+
+/// Enables `queue_depth` for `x`, since mailboxes do not count enqueue
+/// operations by default.
+void track_queue_depth(const actor& x) {
+  auto ptr = dynamic_cast<local_actor*>(actor_cast<abstract_actor*>(x));
+  if (ptr != nullptr)
+    ptr->mailbox().enable_size_estimate();
+}
+
+} // namespace <anonymous>
+
 actor_pool::policy actor_pool::random() {
   struct impl {
-    impl() : rd_() {
+    void operator()(actor_system&, uplock& guard, const actor_vec& vec,
+                    mailbox_element_ptr& ptr, execution_unit* host) {
+      CAF_ASSERT(!vec.empty());
+      actor selected = vec[rng_(vec.size())];
+      guard.unlock();
+      selected->enqueue(std::move(ptr), host);
+    }
+    atomic_rng rng_;
+  };
+  return impl{};
+}
+
+actor_pool::policy actor_pool::join_shortest_queue() {
+  struct impl {
+    impl() : pos_(0) {
       // nop
     }
-    impl(const impl&) : rd_() {
+    impl(const impl&) : pos_(0) {
       // nop
     }
     void operator()(actor_system&, uplock& guard, const actor_vec& vec,
                     mailbox_element_ptr& ptr, execution_unit* host) {
-      upgrade_to_unique_lock<detail::shared_spinlock> unique_guard{guard};
-      auto selected =
-          vec[dis_(rd_, decltype(dis_)::param_type(0, vec.size() - 1))];
-      unique_guard.unlock();
+      CAF_ASSERT(!vec.empty());
+      // start at a rotating offset to spread ties evenly
+      auto n = vec.size();
+      auto first = pos_++ % n;
+      auto best = first;
+      auto best_depth = queue_depth(vec[first]);
+      for (size_t i = 1; i < n && best_depth > 0; ++i) {
+        auto j = (first + i) % n;
+        auto depth = queue_depth(vec[j]);
+        if (depth < best_depth) {
+          best = j;
+          best_depth = depth;
+        }
+      }
+      actor selected = vec[best];
+      guard.unlock();
       selected->enqueue(std::move(ptr), host);
     }
-    std::random_device rd_;
-    std::uniform_int_distribution<size_t> dis_;
+    std::atomic<size_t> pos_;
   };
   return impl{};
 }
 
+actor_pool::policy actor_pool::power_of_two_choices() {
+  struct impl {
+    void operator()(actor_system&, uplock& guard, const actor_vec& vec,
+                    mailbox_element_ptr& ptr, execution_unit* host) {
+      CAF_ASSERT(!vec.empty());
+      auto n = vec.size();
+      auto i = rng_(n);
+      if (n > 1) {
+        // pick a second worker that differs from the first one
+        auto j = (i + 1 + rng_(n - 1)) % n;
+        if (queue_depth(vec[j]) < queue_depth(vec[i]))
+          i = j;
+      }
+      actor selected = vec[i];
+      guard.unlock();
+      selected->enqueue(std::move(ptr), host);
+    }
+    atomic_rng rng_;
+  };
+  return impl{};
+}
+
+struct actor_pool::elastic_state {
+  using time_point = actor_clock::time_point;
+
+  using rep = actor_clock::duration_type::rep;
+
+  /// Mailbox statistics of a single worker from the previous sample.
+  struct worker_sample {
+    size_t dequeued;
+    time_point last_progress;
+  };
+
+  elasticity cfg;
+  factory fac;
+
+  /// Time of the next sample as ticks since the epoch of the clock.
+  std::atomic<rep> next_sample;
+
+  time_point last_sample;
+  time_point low_since;
+  bool low;
+  std::unordered_map<actor_id, worker_sample> samples;
+
+  elastic_state(elasticity x, factory f, time_point now)
+      : cfg(x),
+        fac(std::move(f)),
+        next_sample((now + x.interval).time_since_epoch().count()),
+        last_sample(now),
+        low(false) {
+    // nop
+  }
+
+  /// Returns whether the caller shall take the next sample.
+  bool claim_sample(time_point now) {
+    auto t = now.time_since_epoch().count();
+    auto next = next_sample.load(std::memory_order_relaxed);
+    return t >= next
+           && next_sample.compare_exchange_strong(
+                next, (now + cfg.interval).time_since_epoch().count());
+  }
+};
+
 actor_pool::~actor_pool() {
   // nop
 }
@@ -110,12 +254,32 @@ actor actor_pool::make(execution_unit* eu, size_t num_workers,
   for (size_t i = 0; i < num_workers; ++i) {
     auto worker = fac();
     worker->attach(default_attachable::make_monitor(worker.address(), res_addr));
+    track_queue_depth(worker);
     ptr->workers_.push_back(std::move(worker));
   }
   return res;
 }
 
+expected<actor> actor_pool::make(execution_unit* eu, const elasticity& cfg,
+                                 factory fac, policy pol) {
+  if (cfg.min_workers == 0 || cfg.min_workers > cfg.max_workers
+      || cfg.shrink_threshold >= cfg.grow_threshold) {
+    CAF_LOG_WARNING("invalid elasticity config:" << CAF_ARG(cfg.min_workers)
+                    << CAF_ARG(cfg.max_workers)
+                    << CAF_ARG(cfg.shrink_threshold)
+                    << CAF_ARG(cfg.grow_threshold));
+    return sec::invalid_argument;
+  }
+  auto res = make(eu, cfg.min_workers, fac, std::move(pol));
+  auto ptr = static_cast<actor_pool*>(actor_cast<abstract_actor*>(res));
+  auto now = eu->system().clock().now();
+  ptr->elastic_.reset(new elastic_state(cfg, std::move(fac), now));
+  return res;
+}
+
 void actor_pool::enqueue(mailbox_element_ptr what, execution_unit* eu) {
+  if (elastic_ && elastic_->claim_sample(home_system().clock().now()))
+    resize();
   upgrade_lock<detail::shared_spinlock> guard{workers_mtx_};
   if (filter(guard, what->sender, what->mid, *what, eu))
     return;
@@ -172,6 +336,7 @@ bool actor_pool::filter(upgrade_lock<detail::shared_spinlock>& guard,
     auto& worker = content.get_as<actor>(2);
     worker->attach(default_attachable::make_monitor(worker.address(),
                                                     address()));
+    track_queue_depth(worker);
     upgrade_to_unique_lock<detail::shared_spinlock> unique_guard{guard};
     workers_.push_back(worker);
     return true;
@@ -218,6 +383,100 @@ bool actor_pool::filter(upgrade_lock<detail::shared_spinlock>& guard,
   return false;
 }
 
+void actor_pool::resize() {
+  CAF_LOG_TRACE("");
+  auto& st = *elastic_;
+  auto& cfg = st.cfg;
+  using rep = elastic_state::rep;
+  auto now = home_system().clock().now();
+  unique_lock<detail::shared_spinlock> guard{workers_mtx_};
+  auto n = workers_.size();
+  // an empty pool has either quit or is about to quit
+  if (n == 0)
+    return;
+  auto dt = now - st.last_sample;
+  st.last_sample = now;
+  // collect the aggregate queue depth and check whether any worker falls
+  // behind, estimating its latency via Little's law
+  size_t total_depth = 0;
+  bool slow = false;
+  std::unordered_map<actor_id, elastic_state::worker_sample> samples;
+  for (auto& worker : workers_) {
+    auto ptr = dynamic_cast<local_actor*>(actor_cast<abstract_actor*>(worker));
+    if (ptr == nullptr)
+      continue;
+    auto depth = ptr->mailbox_size_estimate();
+    auto dequeued = ptr->mailbox().dequeue_count();
+    total_depth += depth;
+    elastic_state::worker_sample x{dequeued, now};
+    auto i = st.samples.find(worker.id());
+    if (i != st.samples.end()) {
+      auto done = dequeued - i->second.dequeued;
+      if (done == 0) {
+        x.last_progress = i->second.last_progress;
+        if (depth > 0 && now - x.last_progress > cfg.max_latency)
+          slow = true;
+      } else if (depth > 0 && dt * static_cast<rep>(depth)
+                                / static_cast<rep>(done) > cfg.max_latency) {
+        slow = true;
+      }
+    }
+    samples.emplace(worker.id(), x);
+  }
+  st.samples.swap(samples);
+  CAF_LOG_DEBUG(CAF_ARG(n) << CAF_ARG(total_depth) << CAF_ARG(slow));
+  if (n < cfg.min_workers
+      || ((slow || total_depth > cfg.grow_threshold * n)
+          && n < cfg.max_workers)) {
+    st.low = false;
+    guard.unlock();
+    // spawning may take a while, hence we do not block senders meanwhile
+    auto worker = st.fac();
+    worker->attach(default_attachable::make_monitor(worker.address(),
+                                                    address()));
+    track_queue_depth(worker);
+    guard.lock();
+    // the pool may have quit or grown in the meantime
+    if (!workers_.empty() && workers_.size() < cfg.max_workers) {
+      workers_.push_back(std::move(worker));
+      return;
+    }
+    guard.unlock();
+    retire(worker);
+    return;
+  }
+  if (slow || total_depth > cfg.shrink_threshold * n
+      || n <= cfg.min_workers) {
+    st.low = false;
+    return;
+  }
+  if (!st.low) {
+    st.low = true;
+    st.low_since = now;
+    return;
+  }
+  if (now - st.low_since < cfg.shrink_delay)
+    return;
+  // retire the most recently added worker among the least loaded ones and
+  // restart the delay for retiring the next one
+  st.low_since = now;
+  auto i = std::min_element(workers_.rbegin(), workers_.rend(),
+                            [](const actor& x, const actor& y) {
+                              return queue_depth(x) < queue_depth(y);
+                            });
+  auto retired = std::move(*i);
+  workers_.erase(std::next(i).base());
+  st.samples.erase(retired.id());
+  guard.unlock();
+  retire(retired);
+}
+
+void actor_pool::retire(const actor& worker) {
+  default_attachable::observe_token tk{address(), default_attachable::monitor};
+  worker->detach(tk);
+  anon_send_exit(worker, exit_reason::user_shutdown);
+}
+
 void actor_pool::quit(execution_unit* host) {
   // we can safely run our cleanup code here without holding
   // workers_mtx_ because abstract_actor has its own lock
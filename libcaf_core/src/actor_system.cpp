@@ -26,6 +26,8 @@
 #include "caf/actor_system_config.hpp"
 #include "caf/raw_event_based_actor.hpp"
 
+#include "caf/detail/response_slot.hpp"
+
 #include "caf/policy/work_sharing.hpp"
 #include "caf/policy/work_stealing.hpp"
 
@@ -208,7 +210,10 @@ actor_system::actor_system(actor_system_config& cfg)
       logger_(new caf::logger(*this), false),
       registry_(*this),
       groups_(*this),
+      streams_(*this),
+      metrics_(*this),
       dummy_execution_unit_(this),
+      response_slots_(new detail::response_slot_pool(*this)),
       await_actors_before_shutdown_(true),
       detached(0),
       cfg_(cfg),
@@ -355,6 +360,14 @@ group_manager& actor_system::groups() {
   return groups_;
 }
 
+stream_registry& actor_system::streams() {
+  return streams_;
+}
+
+metrics_registry& actor_system::metrics() {
+  return metrics_;
+}
+
 bool actor_system::has_middleman() const {
   return modules_[module::middleman] != nullptr;
 }
@@ -408,6 +421,24 @@ actor_clock& actor_system::clock() noexcept {
   return scheduler().clock();
 }
 
+response_future actor_system::request_impl(strong_actor_ptr dest,
+                                           const duration& timeout,
+                                           message msg) {
+  // non-actor threads have no logger set, which make_actor needs for
+  // logging the spawn of a new response slot
+  CAF_SET_LOGGER_SYS(this);
+  auto slot = response_slots_->acquire();
+  auto ptr = static_cast<detail::response_slot*>(
+    actor_cast<abstract_actor*>(slot));
+  auto mid = ptr->arm(timeout);
+  if (dest)
+    dest->enqueue(slot, mid, std::move(msg), nullptr);
+  else
+    ptr->enqueue(nullptr, mid.response_id(),
+                 make_message(make_error(sec::invalid_argument)), nullptr);
+  return response_future{std::move(slot)};
+}
+
 
 void actor_system::inc_detached_threads() {
   ++detached;
@@ -117,6 +117,8 @@ actor_system_config::actor_system_config()
   scheduler_max_throughput = std::numeric_limits<size_t>::max();
   scheduler_enable_profiling = false;
   scheduler_profiling_ms_resolution = 100;
+  scheduler_profiling_sample_interval = 1;
+  scheduler_blocking_spin_budget = 1000;
   work_stealing_aggressive_poll_attempts = 100;
   work_stealing_aggressive_steal_interval = 10;
   work_stealing_moderate_poll_attempts = 500;
@@ -124,12 +126,14 @@ actor_system_config::actor_system_config()
   work_stealing_moderate_sleep_duration_us = 50;
   work_stealing_relaxed_steal_interval = 1;
   work_stealing_relaxed_sleep_duration_us = 10000;
+  work_stealing_direct_handoff = false;
   logger_file_name = "actor_log_[PID]_[TIMESTAMP]_[NODE].log";
   logger_file_format = "%r %c %p %a %t %C %M %F:%L %m%n";
   logger_console = atom("none");
   logger_console_format = "%m";
   logger_verbosity = atom("trace");
   logger_inline_output = false;
+  logger_binary_output = false;
   middleman_network_backend = atom("default");
   middleman_enable_automatic_connections = false;
   middleman_max_consecutive_reads = 50;
@@ -140,6 +144,7 @@ actor_system_config::actor_system_config()
   middleman_enable_udp = false;
   middleman_cached_udp_buffers = 10;
   middleman_max_pending_msgs = 10;
+  middleman_max_stream_backlog = 1024 * 1024;
   // fill our options vector for creating INI and CLI parsers
   opt_group{options_, "scheduler"}
   .add(scheduler_policy, "policy",
@@ -152,8 +157,12 @@ actor_system_config::actor_system_config()
        "enables or disables profiler output")
   .add(scheduler_profiling_ms_resolution, "profiling-ms-resolution",
        "sets the rate in ms in which the profiler collects data")
+  .add(scheduler_profiling_sample_interval, "profiling-sample-interval",
+       "sets how often the profiler measures CPU time (every N-th resume)")
   .add(scheduler_profiling_output_file, "profiling-output-file",
-       "sets the output file for the profiler");
+       "sets the output file for the profiler")
+  .add(scheduler_blocking_spin_budget, "blocking-spin-budget",
+       "sets how often blocking actors poll their mailbox before sleeping");
   opt_group(options_, "work-stealing")
   .add(work_stealing_aggressive_poll_attempts, "aggressive-poll-attempts",
        "sets the number of zero-sleep-interval polling attempts")
@@ -168,7 +177,9 @@ actor_system_config::actor_system_config()
   .add(work_stealing_relaxed_steal_interval, "relaxed-steal-interval",
        "sets the frequency of steal attempts during relaxed polling")
   .add(work_stealing_relaxed_sleep_duration_us, "relaxed-sleep-duration",
-       "sets the sleep interval between poll attempts during relaxed polling");
+       "sets the sleep interval between poll attempts during relaxed polling")
+  .add(work_stealing_direct_handoff, "direct-handoff",
+       "runs the most recently woken actor next on the same worker");
   opt_group{options_, "logger"}
   .add(logger_file_name, "file-name",
        "sets the filesystem path of the log file")
@@ -184,6 +195,8 @@ actor_system_config::actor_system_config()
        "sets the verbosity (quiet|error|warning|info|debug|trace)")
   .add(logger_inline_output, "inline-output",
        "sets whether a separate thread is used for I/O")
+  .add(logger_binary_output, "binary-output",
+       "sets whether the log file stores binary records (see caf-vec)")
   .add(logger_file_name, "filename",
        "deprecated (use file-name instead)")
   .add(logger_component_filter, "filter",
@@ -212,7 +225,10 @@ actor_system_config::actor_system_config()
        "(default: 10)")
   .add(middleman_max_pending_msgs, "max-pending-messages",
        "sets the max number of UDP pending messages due to ordering "
-       "(default: 10)");
+       "(default: 10)")
+  .add(middleman_max_stream_backlog, "max-stream-backlog",
+       "sets the max number of unsent bytes per connection before BASP "
+       "withholds credit from stream sources, 0 disables (default: 1MB)");
   opt_group(options_, "opencl")
   .add(opencl_device_ids, "device-ids",
        "restricts which OpenCL devices are accessed by CAF");
@@ -0,0 +1,232 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/binary_log.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+// Reads raw values from a payload.
+class payload_reader {
+public:
+  payload_reader(const char* first, const char* last)
+      : pos_(first),
+        last_(last) {
+    // nop
+  }
+
+  bool at_end() const {
+    return pos_ == last_;
+  }
+
+  template <class T>
+  bool read(T& x) {
+    if (static_cast<size_t>(last_ - pos_) < sizeof(T))
+      return false;
+    memcpy(&x, pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return true;
+  }
+
+  bool read(std::string& x) {
+    uint32_t n;
+    if (!read(n) || static_cast<size_t>(last_ - pos_) < n)
+      return false;
+    x.assign(pos_, n);
+    pos_ += n;
+    return true;
+  }
+
+  // Renders a value the same way `deep_to_string` does on the logging thread.
+  bool read_value(std::string& x) {
+    char type;
+    if (!read(type))
+      return false;
+    switch (type) {
+      case rendered_value:
+        return read(x);
+      case int_value: {
+        int64_t y;
+        if (!read(y))
+          return false;
+        x = std::to_string(y);
+        return true;
+      }
+      case uint_value: {
+        uint64_t y;
+        if (!read(y))
+          return false;
+        x = std::to_string(y);
+        return true;
+      }
+      case double_value: {
+        double y;
+        if (!read(y))
+          return false;
+        x = std::to_string(y);
+        return true;
+      }
+      case bool_value: {
+        char y;
+        if (!read(y))
+          return false;
+        x = y != 0 ? "true" : "false";
+        return true;
+      }
+      case string_value: {
+        std::string y;
+        if (!read(y))
+          return false;
+        x = deep_to_string(y);
+        return true;
+      }
+      case atom_raw_value: {
+        uint64_t y;
+        if (!read(y))
+          return false;
+        x = deep_to_string(static_cast<atom_value>(y));
+        return true;
+      }
+      case duration_value: {
+        uint32_t unit;
+        duration y;
+        if (!read(unit) || !read(y.count))
+          return false;
+        y.unit = static_cast<time_unit>(unit);
+        x = deep_to_string(y);
+        return true;
+      }
+      case message_id_value: {
+        uint64_t y;
+        if (!read(y))
+          return false;
+        x = deep_to_string(make_message_id(y));
+        return true;
+      }
+      case actor_value: {
+        actor_id aid;
+        char valid;
+        if (!read(aid) || !read(valid))
+          return false;
+        node_id nid;
+        if (valid != 0) {
+          uint32_t pid;
+          node_id::host_id_type hid;
+          if (!read(pid) || !read(hid))
+            return false;
+          nid = node_id{pid, hid};
+        }
+        // mirrors `to_string(const strong_actor_ptr&)`
+        x = std::to_string(aid);
+        x += '@';
+        append_to_string(x, nid);
+        return true;
+      }
+      default:
+        return false;
+    }
+  }
+
+private:
+  const char* pos_;
+  const char* last_;
+};
+
+} // namespace <anonymous>
+
+constexpr size_t log_ring::capacity;
+
+bool render_log_payload(std::string& result, const char* buf, size_t n) {
+  // mirrors the output of logger::line_builder
+  payload_reader rd{buf, buf + n};
+  bool behind_arg = false;
+  std::string tmp;
+  while (!rd.at_end()) {
+    char kind;
+    rd.read(kind);
+    switch (kind) {
+      case text_item:
+        if (!rd.read(tmp))
+          return false;
+        if (!result.empty())
+          result += ' ';
+        result += tmp;
+        behind_arg = false;
+        break;
+      case value_item:
+        if (!rd.read_value(tmp))
+          return false;
+        if (!result.empty())
+          result += ' ';
+        result += tmp;
+        behind_arg = false;
+        break;
+      case arg_item:
+        if (!rd.read(tmp))
+          return false;
+        if (behind_arg)
+          result += ", ";
+        else if (!result.empty())
+          result += ' ';
+        result += tmp;
+        result += " = ";
+        if (!rd.read_value(tmp))
+          return false;
+        result += tmp;
+        behind_arg = true;
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+void write_log_header(std::ostream& out, int64_t t0) {
+  out.write(binary_log_magic, binary_log_magic_size);
+  write_log_raw(out, t0);
+}
+
+void write_log_site(std::ostream& out, uint32_t id, int level,
+                    const char* component, const char* pretty_fun,
+                    const char* file_name, int line_number) {
+  out.put(site_block);
+  write_log_raw(out, id);
+  write_log_raw(out, static_cast<int32_t>(level));
+  write_log_raw(out, static_cast<int32_t>(line_number));
+  write_log_string(out, component);
+  write_log_string(out, pretty_fun);
+  write_log_string(out, file_name);
+}
+
+void write_log_thread(std::ostream& out, uint32_t num,
+                      const std::string& str) {
+  out.put(thread_block);
+  write_log_raw(out, num);
+  write_log_string(out, str);
+}
+
+void write_log_record(std::ostream& out, const log_record& x) {
+  out.put(record_block);
+  out.write(reinterpret_cast<const char*>(&x), sizeof(log_record));
+}
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,125 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/block_cache.hpp"
+
+namespace caf {
+namespace detail {
+
+constexpr size_t block_cache::max_blocks;
+constexpr size_t block_cache::batch_size;
+constexpr size_t block_cache::max_depot_blocks;
+
+#ifndef CAF_NO_BLOCK_CACHE
+
+namespace {
+
+// Set after releasing all cached blocks of the current thread.
+thread_local bool released;
+
+// Releases all cached blocks when the current thread terminates.
+struct releaser {
+  block_cache::list* head = nullptr;
+
+  ~releaser() {
+    released = true;
+    while (head != nullptr) {
+      auto xs = head;
+      head = xs->next;
+      while (xs->head != nullptr) {
+        auto x = xs->head;
+        xs->head = x->next;
+        ::operator delete(x);
+      }
+      xs->size = 0;
+      xs->next = nullptr;
+      xs->enrolled = false;
+    }
+  }
+};
+
+} // namespace <anonymous>
+
+bool block_cache::enroll(list& xs) noexcept {
+  if (released)
+    return false;
+  static thread_local releaser instance;
+  xs.next = instance.head;
+  xs.enrolled = true;
+  instance.head = &xs;
+  return true;
+}
+
+void* block_cache::refill(list& xs, size_t n) {
+  if (!xs.enrolled && !enroll(xs))
+    return ::operator new(n);
+  auto& d = **xs.shared;
+  node* first;
+  size_t count = 0;
+  { // lock scope
+    std::unique_lock<std::mutex> guard{d.mtx};
+    first = d.head;
+    if (first == nullptr)
+      return ::operator new(n);
+    auto last = first;
+    for (count = 1; count < batch_size && last->next != nullptr; ++count)
+      last = last->next;
+    d.head = last->next;
+    d.size.store(d.size.load(std::memory_order_relaxed) - count,
+                 std::memory_order_relaxed);
+    last->next = nullptr;
+  }
+  xs.head = first->next;
+  xs.size = count - 1;
+  return first;
+}
+
+void block_cache::spill(list& xs) noexcept {
+  auto first = xs.head;
+  auto last = first;
+  for (size_t i = 1; i < batch_size; ++i)
+    last = last->next;
+  xs.head = last->next;
+  xs.size -= batch_size;
+  auto d = *xs.shared;
+  if (d != nullptr) {
+    std::unique_lock<std::mutex> guard{d->mtx};
+    auto size = d->size.load(std::memory_order_relaxed);
+    if (size + batch_size <= max_depot_blocks) {
+      last->next = d->head;
+      d->head = first;
+      d->size.store(size + batch_size, std::memory_order_relaxed);
+      return;
+    }
+  }
+  last->next = nullptr;
+  while (first != nullptr) {
+    auto x = first;
+    first = x->next;
+    ::operator delete(x);
+  }
+}
+
+block_cache::depot::depot() : head(nullptr), size(0) {
+  // nop
+}
+
+#endif // CAF_NO_BLOCK_CACHE
+
+} // namespace detail
+} // namespace caf
@@ -16,13 +16,16 @@
  * http://www.boost.org/LICENSE_1_0.txt.                                      *
  ******************************************************************************/
 
+#include <thread>
 #include <utility>
+#include <algorithm>
 
 #include "caf/blocking_actor.hpp"
 
 #include "caf/logger.hpp"
 #include "caf/actor_system.hpp"
 #include "caf/actor_registry.hpp"
+#include "caf/actor_system_config.hpp"
 
 #include "caf/detail/sync_request_bouncer.hpp"
 #include "caf/detail/invoke_result_visitor.hpp"
@@ -52,7 +55,11 @@ bool blocking_actor::accept_one_cond::post() {
 
 blocking_actor::blocking_actor(actor_config& cfg)
     : extended_base(cfg.add_flag(local_actor::is_blocking_flag)) {
-  // nop
+  // spinning only makes sense if a sender can run in parallel
+  spin_budget_ = std::thread::hardware_concurrency() > 1
+                 ? home_system().config().scheduler_blocking_spin_budget
+                 : 0;
+  spin_limit_ = spin_budget_;
 }
 
 blocking_actor::~blocking_actor() {
@@ -66,15 +73,20 @@ void blocking_actor::enqueue(mailbox_element_ptr ptr, execution_unit*) {
   CAF_LOG_SEND_EVENT(ptr);
   auto mid = ptr->mid;
   auto src = ptr->sender;
-  // returns false if mailbox has been closed
-  if (!mailbox().synchronized_enqueue(mtx_, cv_, ptr.release())) {
-    CAF_LOG_REJECT_EVENT();
-    if (mid.is_request()) {
-      detail::sync_request_bouncer srb{exit_reason()};
-      srb(src, mid);
-    }
-  } else {
-    CAF_LOG_ACCEPT_EVENT(false);
+  switch (mailbox().enqueue(ptr.release())) {
+    case detail::enqueue_result::unblocked_reader:
+      parker_.unpark();
+      CAF_LOG_ACCEPT_EVENT(true);
+      break;
+    case detail::enqueue_result::success:
+      CAF_LOG_ACCEPT_EVENT(false);
+      break;
+    case detail::enqueue_result::queue_closed:
+      CAF_LOG_REJECT_EVENT();
+      if (mid.is_request()) {
+        detail::sync_request_bouncer srb{exit_reason()};
+        srb(src, mid);
+      }
   }
 }
 
@@ -414,14 +426,35 @@ void blocking_actor::receive_impl(receive_cond& rcc,
 }
 
 void blocking_actor::await_data() {
-  if (!has_next_message())
-    mailbox().synchronized_await(mtx_, cv_);
+  if (has_next_message() || spin())
+    return;
+  // try_block fails if a new message arrived in the meantime
+  if (mailbox().try_block())
+    parker_.park([&] { return !mailbox().blocked(); });
 }
 
 bool blocking_actor::await_data(timeout_type timeout) {
-  if (has_next_message())
+  if (has_next_message() || spin())
+    return true;
+  if (!mailbox().try_block()
+      || parker_.park_until([&] { return !mailbox().blocked(); }, timeout))
     return true;
-  return mailbox().synchronized_await(mtx_, cv_, timeout);
+  // if we're unable to set the queue from blocked to empty,
+  // than there's a new element in the list
+  return !mailbox().try_unblock();
+}
+
+bool blocking_actor::spin() {
+  for (size_t i = 0; i < spin_limit_; ++i) {
+    detail::cpu_relax();
+    if (mailbox().can_fetch_more()) {
+      spin_limit_ = std::min(spin_budget_, spin_limit_ * 2);
+      return true;
+    }
+  }
+  // never drop to zero, otherwise spinning could never pay off again
+  spin_limit_ = std::max(spin_budget_ / 16, spin_limit_ / 2);
+  return false;
 }
 
 mailbox_element_ptr blocking_actor::dequeue() {
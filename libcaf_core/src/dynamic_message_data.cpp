@@ -18,34 +18,107 @@
 
 #include "caf/detail/dynamic_message_data.hpp"
 
+#include <new>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
 #include "caf/error.hpp"
 #include "caf/make_counted.hpp"
 
 namespace caf {
 namespace detail {
 
-dynamic_message_data::dynamic_message_data() : type_token_(0xFFFFFFFF) {
-  // nop
+namespace {
+
+// Wraps values that were created by a factory without value descriptor.
+class boxed_value : public type_erased_value {
+public:
+  boxed_value(type_erased_value_ptr ptr) : ptr_(std::move(ptr)) {
+    // nop
+  }
+
+  void* get_mutable() override {
+    return ptr_->get_mutable();
+  }
+
+  error load(deserializer& source) override {
+    return ptr_->load(source);
+  }
+
+  rtti_pair type() const override {
+    return ptr_->type();
+  }
+
+  const void* get() const override {
+    return ptr_->get();
+  }
+
+  error save(serializer& sink) const override {
+    return ptr_->save(sink);
+  }
+
+  std::string stringify() const override {
+    return ptr_->stringify();
+  }
+
+  type_erased_value_ptr copy() const override {
+    return ptr_->copy();
+  }
+
+  static type_erased_value* copy(void* storage, const type_erased_value& x) {
+    return new (storage) boxed_value(x.copy());
+  }
+
+  static type_erased_value* move(void* storage, type_erased_value& x) {
+    auto& y = static_cast<boxed_value&>(x);
+    auto result = new (storage) boxed_value(std::move(y.ptr_));
+    y.~boxed_value();
+    return result;
+  }
+
+private:
+  type_erased_value_ptr ptr_;
+};
+
+constexpr value_descriptor boxed_value_descriptor{
+  sizeof(boxed_value), alignof(boxed_value), nullptr, boxed_value::copy,
+  boxed_value::move};
+
+// Blocks start at addresses aligned to max_align_t. Keeping the size of each
+// block a multiple of this alignment aligns the end of each block as well.
+constexpr size_t block_alignment = alignof(std::max_align_t);
+
+inline size_t align_to(size_t x, size_t alignment) {
+  return (x + alignment - 1) / alignment * alignment;
 }
 
-dynamic_message_data::dynamic_message_data(elements&& data)
-    : elements_(std::move(data)),
+} // namespace <anonymous>
+
+dynamic_message_data::dynamic_message_data()
+    : block_(nullptr),
+      capacity_(0),
+      size_(0),
+      values_size_(0),
       type_token_(0xFFFFFFFF) {
-  for (auto& e : elements_)
-    add_to_type_token(e->type().first);
+  // nop
 }
 
 dynamic_message_data::dynamic_message_data(const dynamic_message_data& other)
-    : detail::message_data(other),
-      type_token_(0xFFFFFFFF) {
-  for (auto& e : other.elements_) {
-    add_to_type_token(e->type().first);
-    elements_.emplace_back(e->copy());
+    : dynamic_message_data() {
+  // the delegating constructor makes sure the destructor cleans up if
+  // copying an element throws
+  reserve(other.size_, other.values_size_);
+  for (size_t i = 0; i < other.size_; ++i) {
+    auto x = other.elements()[i].descriptor;
+    commit(x, x->copy(allocate(x), *other.value(i)));
   }
 }
 
 dynamic_message_data::~dynamic_message_data() {
-  // nop
+  for (size_t i = 0; i < size_; ++i)
+    value(i)->~type_erased_value();
+  ::operator delete(block_);
 }
 
 message_data::cow_ptr dynamic_message_data::copy() const {
@@ -54,16 +127,16 @@ message_data::cow_ptr dynamic_message_data::copy() const {
 
 void* dynamic_message_data::get_mutable(size_t pos) {
   CAF_ASSERT(pos < size());
-  return elements_[pos]->get_mutable();
+  return value(pos)->get_mutable();
 }
 
 error dynamic_message_data::load(size_t pos, deserializer& source) {
   CAF_ASSERT(pos < size());
-  return elements_[pos]->load(source);
+  return value(pos)->load(source);
 }
 
 size_t dynamic_message_data::size() const noexcept {
-  return elements_.size();
+  return size_;
 }
 
 uint32_t dynamic_message_data::type_token() const noexcept {
@@ -72,42 +145,93 @@ uint32_t dynamic_message_data::type_token() const noexcept {
 
 auto dynamic_message_data::type(size_t pos) const noexcept -> rtti_pair {
   CAF_ASSERT(pos < size());
-  return elements_[pos]->type();
+  return value(pos)->type();
 }
 
 const void* dynamic_message_data::get(size_t pos) const noexcept {
   CAF_ASSERT(pos < size());
-  return elements_[pos]->get();
+  return value(pos)->get();
 }
 
 std::string dynamic_message_data::stringify(size_t pos) const {
   CAF_ASSERT(pos < size());
-  return elements_[pos]->stringify();
+  return value(pos)->stringify();
 }
 
 type_erased_value_ptr dynamic_message_data::copy(size_t pos) const {
   CAF_ASSERT(pos < size());
-  return elements_[pos]->copy();
+  return value(pos)->copy();
 }
 
 error dynamic_message_data::save(size_t pos, serializer& sink) const {
   CAF_ASSERT(pos < size());
-  return elements_[pos]->save(sink);
+  return value(pos)->save(sink);
 }
 
 void dynamic_message_data::clear() {
-  elements_.clear();
+  for (size_t i = 0; i < size_; ++i)
+    value(i)->~type_erased_value();
+  size_ = 0;
+  values_size_ = 0;
   type_token_ = 0xFFFFFFFF;
 }
 
+void dynamic_message_data::reserve(size_t n, size_t value_bytes) {
+  auto required = (size_ + n) * sizeof(element) + values_size_ + value_bytes;
+  if (required > capacity_)
+    grow(required);
+}
+
+void* dynamic_message_data::allocate(const value_descriptor* x) {
+  CAF_ASSERT(x->alignment <= block_alignment);
+  auto offset = align_to(values_size_ + x->size, x->alignment);
+  auto required = (size_ + 1) * sizeof(element) + offset;
+  if (required > capacity_)
+    grow(std::max(2 * capacity_, required));
+  return block_ + capacity_ - offset;
+}
+
+void dynamic_message_data::commit(const value_descriptor* x,
+                                  type_erased_value* ptr) {
+  auto offset = static_cast<size_t>(block_ + capacity_
+                                    - reinterpret_cast<char*>(ptr));
+  CAF_ASSERT(offset == align_to(values_size_ + x->size, x->alignment));
+  elements()[size_] = element{offset, x};
+  values_size_ = offset;
+  ++size_;
+  add_to_type_token(ptr->type().first);
+}
+
+type_erased_value* dynamic_message_data::emplace(const value_descriptor* x) {
+  CAF_ASSERT(x->make != nullptr);
+  auto ptr = x->make(allocate(x));
+  commit(x, ptr);
+  return ptr;
+}
+
 void dynamic_message_data::append(type_erased_value_ptr x) {
-  add_to_type_token(x->type().first);
-  elements_.emplace_back(std::move(x));
+  auto d = &boxed_value_descriptor;
+  commit(d, new (allocate(d)) boxed_value(std::move(x)));
 }
 
 void dynamic_message_data::add_to_type_token(uint16_t typenr) {
   type_token_ = (type_token_ << 6) | typenr;
 }
 
+void dynamic_message_data::grow(size_t new_capacity) {
+  new_capacity = align_to(new_capacity, block_alignment);
+  auto new_block = static_cast<char*>(::operator new(new_capacity));
+  // Offsets are relative to the end of the block and thus remain valid.
+  if (size_ > 0)
+    memcpy(new_block, block_, size_ * sizeof(element));
+  for (size_t i = 0; i < size_; ++i) {
+    auto& e = elements()[i];
+    e.descriptor->move(new_block + new_capacity - e.offset, *value(i));
+  }
+  ::operator delete(block_);
+  block_ = new_block;
+  capacity_ = new_capacity;
+}
+
 } // namespace detail
 } // namespace caf
@@ -30,4 +30,9 @@ execution_unit::~execution_unit() {
   // nop
 }
 
+void execution_unit::exec_later_all(resumable** first, resumable** last) {
+  for (; first != last; ++first)
+    exec_later(*first);
+}
+
 } // namespace caf
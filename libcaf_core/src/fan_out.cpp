@@ -0,0 +1,206 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/fan_out.hpp"
+
+#include <new>
+#include <atomic>
+#include <cstddef>
+
+#include "caf/config.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/abstract_actor.hpp"
+#include "caf/mailbox_element.hpp"
+
+#include "caf/scheduler/abstract_coordinator.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+/// State that all mailbox elements of a slab share. Elements neither copy the
+/// message nor acquire their own reference to the sender. Instead, the
+/// `fan_out` acquires one reference to the sender per element with a single
+/// atomic operation and the last element releases all references that are
+/// still in the slab with another one. Disposing an element usually takes a
+/// single atomic operation on `rc`, which has a cache line of its own. Hence,
+/// receivers only share read-only cache lines otherwise.
+struct slab_state {
+  /// Counts all elements that are not yet disposed, including elements the
+  /// `fan_out` did not construct yet, plus one for the `fan_out`.
+  std::atomic<size_t> rc;
+
+  // keeps writes to `rc` away from all other members
+  char pad[CAF_CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+
+  /// Counts elements that gave up their reference to `sender` on their own,
+  /// e.g., because the receiver moved it into a response promise.
+  std::atomic<size_t> moved;
+
+  /// Number of elements this slab can store.
+  size_t capacity;
+
+  /// Sender of all elements.
+  strong_actor_ptr sender;
+
+  /// Content of all elements.
+  message msg;
+
+  /// Second reference to the content of all elements. Keeps the content
+  /// shared, i.e., receivers never modify it in place.
+  message pin;
+
+  slab_state(size_t n, strong_actor_ptr x, message y)
+      : rc(n + 1),
+        moved(0),
+        capacity(n),
+        sender(std::move(x)),
+        msg(std::move(y)),
+        pin(msg) {
+    // pay for the references of all elements at once
+    if (sender)
+      sender->strong_refs.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  /// Drops `n` from the reference count and destroys the slab when it reaches
+  /// zero, releasing all references to `sender` that no element took along.
+  void release(size_t n = 1) noexcept {
+    if (rc.fetch_sub(n, std::memory_order_acq_rel) == n) {
+      // cannot drop to zero, since `sender` still holds one reference
+      auto k = capacity - moved.load(std::memory_order_relaxed);
+      if (sender && k > 0)
+        sender->strong_refs.fetch_sub(k, std::memory_order_acq_rel);
+      this->~slab_state();
+      ::operator delete(static_cast<void*>(this));
+    }
+  }
+};
+
+/// A mailbox element that lives in a slab of a `fan_out`.
+class slab_element : public mailbox_element {
+public:
+  slab_element(slab_state* st, message_id x)
+      : mailbox_element(strong_actor_ptr{st->sender.get(), false}, x,
+                        forwarding_stack{}),
+        st_(st) {
+    // nop
+  }
+
+  type_erased_tuple& content() override {
+    auto ptr = st_->msg.vals().raw_ptr();
+    if (ptr != nullptr)
+      return *ptr;
+    return dummy();
+  }
+
+  message move_content_to_message() override {
+    return st_->msg;
+  }
+
+  message copy_content_to_message() const override {
+    return st_->msg;
+  }
+
+  void request_deletion(bool) noexcept override {
+    auto st = st_;
+    // the slab releases our reference unless the receiver moved the sender
+    // elsewhere, e.g., into a promise
+    if (sender && sender.get() == st->sender.get())
+      sender.detach();
+    else if (st->sender)
+      st->moved.fetch_add(1, std::memory_order_relaxed);
+    this->~slab_element();
+    st->release();
+  }
+
+private:
+  slab_state* st_;
+};
+
+} // namespace <anonymous>
+
+/// Raw memory for mailbox elements, followed by `slab_element[capacity]`.
+struct fan_out::slab : slab_state {
+  using slab_state::slab_state;
+
+  static size_t offset() {
+    auto align = alignof(slab_element);
+    return (sizeof(slab) + align - 1) / align * align;
+  }
+
+  slab_element* at(size_t pos) {
+    auto base = reinterpret_cast<char*>(this) + offset();
+    return reinterpret_cast<slab_element*>(base) + pos;
+  }
+
+  static slab* make(size_t capacity, strong_actor_ptr sender, message msg) {
+    static_assert(sizeof(slab) == sizeof(slab_state),
+                  "slab_state::release assumes no additional members");
+    auto mem = ::operator new(offset() + capacity * sizeof(slab_element));
+    return new (mem) slab(capacity, std::move(sender), std::move(msg));
+  }
+};
+
+fan_out::fan_out(actor_system& sys, execution_unit* ctx,
+                 strong_actor_ptr sender, message_id mid, message msg,
+                 size_t max_receivers)
+    : execution_unit(&sys),
+      ctx_(ctx),
+      mid_(mid),
+      slab_(max_receivers > 0
+            ? slab::make(max_receivers, std::move(sender), std::move(msg))
+            : nullptr),
+      used_(0) {
+  if (ctx != nullptr)
+    proxies_ = ctx->proxy_registry_ptr();
+  jobs_.reserve(max_receivers);
+}
+
+fan_out::~fan_out() {
+  submit();
+  // drops our own reference and the ones of all elements we did not create
+  if (slab_ != nullptr)
+    slab_->release(slab_->capacity - used_ + 1);
+}
+
+void fan_out::enqueue(abstract_actor* dest) {
+  CAF_ASSERT(dest != nullptr);
+  CAF_ASSERT(slab_ != nullptr && used_ < slab_->capacity);
+  auto ptr = new (slab_->at(used_++)) slab_element(slab_, mid_);
+  dest->enqueue(mailbox_element_ptr{ptr}, this);
+}
+
+void fan_out::submit() {
+  if (jobs_.empty())
+    return;
+  auto first = jobs_.data();
+  auto last = first + jobs_.size();
+  if (ctx_ != nullptr)
+    ctx_->exec_later_all(first, last);
+  else
+    system().scheduler().enqueue_all(first, last);
+  jobs_.clear();
+}
+
+void fan_out::exec_later(resumable* ptr) {
+  jobs_.push_back(ptr);
+}
+
+} // namespace detail
+} // namespace caf
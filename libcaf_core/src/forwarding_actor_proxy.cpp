@@ -45,12 +45,15 @@ void forwarding_actor_proxy::forward_msg(strong_actor_ptr sender,
                 << CAF_ARG(mid) << CAF_ARG(msg));
   if (msg.match_elements<exit_msg>())
     unlink_from(msg.get_as<exit_msg>(0).source);
-  forwarding_stack tmp;
+  // BASP serializes forwarding stacks as vectors
+  std::vector<strong_actor_ptr> stages;
+  if (fwd != nullptr)
+    stages.assign(fwd->begin(), fwd->end());
   shared_lock<detail::shared_spinlock> guard(mtx_);
   if (broker_)
     broker_->enqueue(nullptr, invalid_message_id,
                      make_message(forward_atom::value, std::move(sender),
-                                  fwd != nullptr ? *fwd : tmp,
+                                  std::move(stages),
                                   strong_actor_ptr{ctrl()}, mid,
                                   std::move(msg)),
                      nullptr);
@@ -0,0 +1,152 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/forwarding_stack.hpp"
+
+#include <new>
+#include <algorithm>
+
+namespace caf {
+namespace detail {
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+forwarding_stack::forwarding_stack() noexcept
+    : size_(0),
+      capacity_(inline_capacity) {
+  new (&xs_.local) value_type;
+}
+
+forwarding_stack::forwarding_stack(std::initializer_list<value_type> xs)
+    : forwarding_stack() {
+  reserve(xs.size());
+  std::copy(xs.begin(), xs.end(), data());
+  size_ = static_cast<uint32_t>(xs.size());
+}
+
+forwarding_stack::forwarding_stack(std::vector<value_type> xs)
+    : forwarding_stack() {
+  reserve(xs.size());
+  std::move(xs.begin(), xs.end(), data());
+  size_ = static_cast<uint32_t>(xs.size());
+}
+
+forwarding_stack::forwarding_stack(forwarding_stack&& other) noexcept
+    : forwarding_stack() {
+  steal(other);
+}
+
+forwarding_stack::forwarding_stack(const forwarding_stack& other)
+    : forwarding_stack() {
+  reserve(other.size());
+  std::copy(other.begin(), other.end(), data());
+  size_ = other.size_;
+}
+
+forwarding_stack& forwarding_stack::operator=(forwarding_stack&& other) noexcept {
+  if (this != &other) {
+    reset();
+    steal(other);
+  }
+  return *this;
+}
+
+forwarding_stack& forwarding_stack::operator=(const forwarding_stack& other) {
+  if (this != &other) {
+    clear();
+    reserve(other.size());
+    std::copy(other.begin(), other.end(), data());
+    size_ = other.size_;
+  }
+  return *this;
+}
+
+forwarding_stack::~forwarding_stack() {
+  if (is_inline())
+    xs_.local.~value_type();
+  else
+    delete[] xs_.heap;
+}
+
+// -- modifiers ----------------------------------------------------------------
+
+forwarding_stack::iterator forwarding_stack::insert(const_iterator pos,
+                                                    value_type x) {
+  auto offset = pos - begin();
+  push_back(std::move(x));
+  auto first = begin() + offset;
+  std::rotate(first, end() - 1, end());
+  return first;
+}
+
+void forwarding_stack::clear() noexcept {
+  std::fill(begin(), end(), nullptr);
+  size_ = 0;
+}
+
+void forwarding_stack::reserve(size_type n) {
+  if (n > capacity_)
+    grow(n);
+}
+
+void forwarding_stack::grow(size_type n) {
+  CAF_ASSERT(n > capacity_);
+  auto ys = new value_type[n];
+  std::move(begin(), end(), ys);
+  if (is_inline())
+    xs_.local.~value_type();
+  else
+    delete[] xs_.heap;
+  xs_.heap = ys;
+  capacity_ = static_cast<uint32_t>(n);
+}
+
+void forwarding_stack::reset() noexcept {
+  if (is_inline()) {
+    xs_.local = nullptr;
+  } else {
+    delete[] xs_.heap;
+    new (&xs_.local) value_type;
+    capacity_ = inline_capacity;
+  }
+  size_ = 0;
+}
+
+void forwarding_stack::steal(forwarding_stack& other) noexcept {
+  CAF_ASSERT(empty() && is_inline());
+  if (other.is_inline()) {
+    xs_.local = std::move(other.xs_.local);
+  } else {
+    xs_.local.~value_type();
+    xs_.heap = other.xs_.heap;
+    capacity_ = other.capacity_;
+    new (&other.xs_.local) value_type;
+    other.capacity_ = inline_capacity;
+  }
+  size_ = other.size_;
+  other.size_ = 0;
+}
+
+// -- free functions -----------------------------------------------------------
+
+bool operator==(const forwarding_stack& x, const forwarding_stack& y) {
+  return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+}
+
+} // namespace detail
+} // namespace caf
@@ -18,7 +18,13 @@
 
 #include <set>
 #include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
 #include <sstream>
+#include <algorithm>
+#include <functional>
 #include <stdexcept>
 #include <condition_variable>
 
@@ -33,6 +39,9 @@
 
 #include "caf/group_manager.hpp"
 
+#include "caf/detail/fan_out.hpp"
+#include "caf/detail/scope_guard.hpp"
+
 namespace caf {
 
 namespace {
@@ -61,12 +70,22 @@ void await_all_locals_down(actor_system& sys, std::initializer_list<actor> xs) {
 
 class local_group : public abstract_group {
 public:
+  /// An immutable, sorted snapshot of all subscribers.
+  using subscriber_vec = std::vector<strong_actor_ptr>;
+
   void send_all_subscribers(const strong_actor_ptr& sender, const message& msg,
                             execution_unit* host) {
     CAF_LOG_TRACE(CAF_ARG(sender) << CAF_ARG(msg));
-    shared_guard guard(mtx_);
-    for (auto& s : subscribers_)
-      s->enqueue(sender, invalid_message_id, msg, host);
+    // Membership changes swap in a new snapshot instead of modifying the
+    // current one, i.e., publishers never wait for subscribe or unsubscribe.
+    // All subscribers share the content of `msg`.
+    read_subscribers([&](const subscriber_vec& xs) {
+      if (xs.empty())
+        return;
+      detail::fan_out f{system(), host, sender, invalid_message_id, msg,
+                        xs.size()};
+      f.enqueue_all(xs);
+    });
   }
 
   void enqueue(strong_actor_ptr sender, message_id, message msg,
@@ -78,29 +97,38 @@ public:
 
   std::pair<bool, size_t> add_subscriber(strong_actor_ptr who) {
     CAF_LOG_TRACE(CAF_ARG(who));
+    std::unique_lock<std::mutex> guard{mtx_};
+    // only writers replace the snapshot, i.e., `xs` stays valid
+    auto xs = subscribers_.load(std::memory_order_relaxed);
     if (!who)
-      return {false, subscribers_.size()};
-    exclusive_guard guard(mtx_);
-    auto res = subscribers_.emplace(std::move(who)).second;
-    return {res, subscribers_.size()};
+      return {false, xs->size()};
+    auto i = std::lower_bound(xs->begin(), xs->end(), who.get(), less_ptr);
+    if (i != xs->end() && i->get() == who.get())
+      return {false, xs->size()};
+    std::unique_ptr<subscriber_vec> ys{new subscriber_vec};
+    ys->reserve(xs->size() + 1);
+    ys->insert(ys->end(), xs->begin(), i);
+    ys->emplace_back(std::move(who));
+    ys->insert(ys->end(), i, xs->end());
+    auto result = ys->size();
+    replace_subscribers(ys.release());
+    return {true, result};
   }
 
   std::pair<bool, size_t> erase_subscriber(const actor_control_block* who) {
     CAF_LOG_TRACE(""); // serializing who would cause a deadlock
-    exclusive_guard guard(mtx_);
-    auto e = subscribers_.end();
-#if __cplusplus > 201103L
-    auto i = subscribers_.find(who);
-#else
-    auto cmp = [&](const strong_actor_ptr& lhs) {
-      return lhs.get() == who;
-    };
-    auto i = std::find_if(subscribers_.begin(), e, cmp);
-#endif
-    if(i == e)
-      return {false, subscribers_.size()};
-    subscribers_.erase(i);
-    return {true, subscribers_.size()};
+    std::unique_lock<std::mutex> guard{mtx_};
+    auto xs = subscribers_.load(std::memory_order_relaxed);
+    auto i = std::lower_bound(xs->begin(), xs->end(), who, less_ptr);
+    if (i == xs->end() || i->get() != who)
+      return {false, xs->size()};
+    std::unique_ptr<subscriber_vec> ys{new subscriber_vec};
+    ys->reserve(xs->size() - 1);
+    ys->insert(ys->end(), xs->begin(), i);
+    ys->insert(ys->end(), i + 1, xs->end());
+    auto result = ys->size();
+    replace_subscribers(ys.release());
+    return {true, result};
   }
 
   bool subscribe(strong_actor_ptr who) override {
@@ -124,18 +152,61 @@ public:
     return broker_;
   }
 
+  /// Calls `f` with the current snapshot of all subscribers without taking
+  /// any lock. Readers announce themselves in one of two counters, selected
+  /// by the parity of `epoch_`. Flipping the parity keeps a steady stream of
+  /// readers from starving writers.
+  template <class F>
+  void read_subscribers(F f) const {
+    auto& n = readers_[epoch_.load() & 1];
+    n.fetch_add(1);
+    auto guard = detail::make_scope_guard([&] {
+      n.fetch_sub(1, std::memory_order_release);
+    });
+    f(*subscribers_.load());
+  }
+
   local_group(local_group_module& mod, std::string id, node_id nid,
               optional<actor> lb);
 
   ~local_group() override;
 
 protected:
-  detail::shared_spinlock mtx_;
-#if __cplusplus > 201103L
-  std::set<strong_actor_ptr, std::less<>> subscribers_;
-#else
-  std::set<strong_actor_ptr> subscribers_;
-#endif
+  static bool less_ptr(const strong_actor_ptr& x,
+                       const actor_control_block* y) {
+    return std::less<const actor_control_block*>{}(x.get(), y);
+  }
+
+  /// Publishes `xs` and deletes the previous snapshot after all readers that
+  /// may still see it are done.
+  /// @pre `mtx_` is locked
+  void replace_subscribers(subscriber_vec* xs) {
+    auto old = subscribers_.exchange(xs);
+    // readers that arrive after the exchange only see `xs`, while all others
+    // are still counted in one of the two counters
+    for (int i = 0; i < 2; ++i) {
+      auto& n = readers_[epoch_.fetch_add(1) & 1];
+      while (n.load() != 0)
+        std::this_thread::yield();
+    }
+    delete old;
+  }
+
+  // Serializes writers, i.e., subscribe and unsubscribe operations.
+  std::mutex mtx_;
+
+  // Current snapshot, replaced only by writers.
+  std::atomic<subscriber_vec*> subscribers_;
+
+  // Selects the counter for new readers.
+  std::atomic<size_t> epoch_;
+
+  // Keeps the counters that readers write to away from `subscribers_`.
+  char pad_[CAF_CACHE_LINE_SIZE];
+
+  // Counts the readers per epoch parity.
+  mutable std::atomic<size_t> readers_[2];
+
   actor broker_;
 };
 
@@ -420,12 +491,15 @@ private:
 local_group::local_group(local_group_module& mod, std::string id, node_id nid,
                          optional<actor> lb)
     : abstract_group(mod, std::move(id), std::move(nid)),
+      subscribers_(new subscriber_vec),
+      epoch_(0),
+      readers_(),
       broker_(lb ? *lb : mod.system().spawn<local_broker, hidden>(this)) {
   CAF_LOG_TRACE(CAF_ARG(id) << CAF_ARG(nid));
 }
 
 local_group::~local_group() {
-  // nop
+  delete subscribers_.load();
 }
 
 error local_group::save(serializer& sink) const {
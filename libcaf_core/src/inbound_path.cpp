@@ -31,8 +31,8 @@ inbound_path::inbound_path(local_actor* selfptr, const stream_id& id,
       sid(std::move(id)),
       hdl(std::move(ptr)),
       prio(stream_priority::normal),
-      last_acked_batch_id(0),
-      last_batch_id(0),
+      last_acked_batch_id(-1),
+      last_batch_id(-1),
       assigned_credit(0),
       redeployable(false) {
   // nop
@@ -76,6 +76,11 @@ void inbound_path::emit_ack_batch(long new_demand) {
                                              last_batch_id));
 }
 
+inbound_path_metrics inbound_path::metrics() const {
+  return {sid, hdl ? hdl->address() : actor_addr{}, assigned_credit,
+          last_batch_id, last_acked_batch_id};
+}
+
 void inbound_path::emit_irregular_shutdown(local_actor* self,
                                            const stream_id& sid,
                                            const strong_actor_ptr& hdl,
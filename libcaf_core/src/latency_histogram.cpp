@@ -0,0 +1,115 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/latency_histogram.hpp"
+
+#include <limits>
+#include <algorithm>
+
+namespace caf {
+
+constexpr size_t latency_histogram::num_buckets;
+
+latency_histogram::latency_histogram() {
+  reset();
+}
+
+void latency_histogram::record(duration_type x) {
+  auto ns = x.count() > 0 ? static_cast<uint64_t>(x.count()) : uint64_t{0};
+  ++count_;
+  sum_ += ns;
+  min_ = std::min(min_, ns);
+  max_ = std::max(max_, ns);
+  ++buckets_[bucket_of(ns)];
+}
+
+void latency_histogram::merge(const latency_histogram& other) {
+  count_ += other.count_;
+  sum_ += other.sum_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  for (size_t i = 0; i < num_buckets; ++i)
+    buckets_[i] += other.buckets_[i];
+}
+
+void latency_histogram::reset() {
+  count_ = 0;
+  sum_ = 0;
+  min_ = std::numeric_limits<uint64_t>::max();
+  max_ = 0;
+  buckets_.fill(0);
+}
+
+latency_histogram::duration_type latency_histogram::min() const {
+  return duration_type{count_ > 0 ? static_cast<int64_t>(min_) : 0};
+}
+
+latency_histogram::duration_type latency_histogram::max() const {
+  return duration_type{static_cast<int64_t>(max_)};
+}
+
+latency_histogram::duration_type latency_histogram::mean() const {
+  return duration_type{count_ > 0 ? static_cast<int64_t>(sum_ / count_) : 0};
+}
+
+latency_histogram::duration_type latency_histogram::percentile(double q) const {
+  if (count_ == 0)
+    return duration_type{0};
+  auto rank = static_cast<uint64_t>(q * static_cast<double>(count_));
+  rank = std::max(uint64_t{1}, std::min(rank, count_));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < num_buckets; ++i) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      // the upper bound of bucket i is 2^i - 1, but never exceeds max_
+      auto upper = (uint64_t{1} << i) - 1;
+      return duration_type{static_cast<int64_t>(std::min(upper, max_))};
+    }
+  }
+  return max();
+}
+
+size_t latency_histogram::bucket_of(uint64_t x) {
+  size_t result = 0;
+  while (x != 0) {
+    ++result;
+    x >>= 1;
+  }
+  return std::min(result, num_buckets - 1);
+}
+
+std::string to_string(const latency_histogram& x) {
+  std::string result = "latency_histogram(count = ";
+  result += std::to_string(x.count());
+  auto add = [&](const char* name, latency_histogram::duration_type y) {
+    result += ", ";
+    result += name;
+    result += " = ";
+    result += std::to_string(y.count());
+    result += "ns";
+  };
+  add("min", x.min());
+  add("mean", x.mean());
+  add("p50", x.percentile(0.5));
+  add("p99", x.percentile(0.99));
+  add("max", x.max());
+  result += ')';
+  return result;
+}
+
+} // namespace caf
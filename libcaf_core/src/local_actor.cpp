@@ -33,6 +33,7 @@
 #include "caf/default_attachable.hpp"
 #include "caf/binary_deserializer.hpp"
 
+#include "caf/detail/print_sink.hpp"
 #include "caf/detail/private_thread.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
 
@@ -183,6 +184,12 @@ bool local_actor::cleanup(error&& fail_state, execution_unit* host) {
     detail::sync_request_bouncer f{fail_state};
     mailbox_.close(f);
   }
+  // write pending output of aout before anyone can observe our termination
+  if (getf(abstract_actor::has_used_aout_flag)) {
+    auto sink = home_system().scheduler().print_sink();
+    if (sink != nullptr)
+      sink->erase(id());
+  }
   // tell registry we're done
   unregister_from_system();
   monitorable_actor::cleanup(std::move(fail_state), host);
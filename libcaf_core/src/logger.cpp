@@ -19,11 +19,14 @@
 #include "caf/logger.hpp"
 
 #include <ctime>
+#include <deque>
 #include <thread>
 #include <cstring>
 #include <iomanip>
 #include <fstream>
+#include <sstream>
 #include <algorithm>
+#include <unordered_map>
 #include <condition_variable>
 
 #include "caf/config.hpp"
@@ -110,6 +113,166 @@ inline logger* get_current_logger() {
 }
 #endif // CAF_LOG_LEVEL
 
+// -- state for binary output --------------------------------------------------
+
+/// Describes the origin of log events in a binary log.
+struct call_site {
+  int level;
+  const char* component;
+  const char* pretty_fun;
+  const char* file_name;
+  int line_number;
+};
+
+/// Stores all call sites that logged at least once in binary format. Sites
+/// are shared among all loggers, because each site registers only once.
+struct site_registry {
+  std::mutex mtx;
+  std::vector<call_site> sites;
+};
+
+site_registry& sites() {
+  static site_registry instance;
+  return instance;
+}
+
+/// Generates unique IDs for all loggers in this process.
+std::atomic<uint64_t> s_logger_instances;
+
+/// Gives each thread access to its ring buffer for the most recently used
+/// logger.
+struct ring_cache {
+  uint64_t instance = 0;
+  std::shared_ptr<detail::log_ring> ring;
+
+  ~ring_cache() {
+    // allows the logger to release the buffer after draining it
+    if (ring)
+      ring->retire();
+  }
+};
+
+#ifndef CAF_NO_THREAD_LOCAL
+
+thread_local ring_cache s_ring_cache;
+
+thread_local std::string s_record_buf;
+
+#endif // CAF_NO_THREAD_LOCAL
+
+std::string& record_buf() {
+#ifndef CAF_NO_THREAD_LOCAL
+  return s_record_buf;
+#else
+  // binary output is disabled on platforms without thread_local
+  static std::string dummy;
+  return dummy;
+#endif
+}
+
+// -- per-thread actor IDs -----------------------------------------------------
+
+/// Stores the actor ID of a single thread. Only the owning thread writes to
+/// `aid`, other threads only read it while enumerating all threads.
+struct aid_slot {
+  std::atomic<actor_id> aid;
+};
+
+/// Keeps track of all slots for enumerating threads. Threads register their
+/// slot once when setting an actor ID for the first time and remove it again
+/// when terminating.
+struct aid_registry {
+  std::mutex mtx;
+  std::vector<std::pair<std::thread::id, aid_slot*>> slots;
+};
+
+aid_registry& aids() {
+  static aid_registry instance;
+  return instance;
+}
+
+void register_aid_slot(aid_slot* x) {
+  auto tid = std::this_thread::get_id();
+  auto& reg = aids();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  reg.slots.emplace_back(tid, x);
+}
+
+void unregister_aid_slot(aid_slot* x) {
+  auto& reg = aids();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  auto pred = [=](const std::pair<std::thread::id, aid_slot*>& y) {
+    return y.second == x;
+  };
+  auto i = std::find_if(reg.slots.begin(), reg.slots.end(), pred);
+  if (i != reg.slots.end())
+    reg.slots.erase(i);
+}
+
+#ifndef CAF_NO_THREAD_LOCAL
+
+// Plain data with constant initialization, i.e., accessing it compiles to a
+// TLS offset without any initialization guard.
+thread_local aid_slot s_aid_slot;
+
+thread_local bool s_aid_slot_registered;
+
+/// Removes `s_aid_slot` from the registry on thread exit.
+struct aid_slot_guard {
+  aid_slot_guard() {
+    register_aid_slot(&s_aid_slot);
+  }
+
+  ~aid_slot_guard() {
+    unregister_aid_slot(&s_aid_slot);
+  }
+};
+
+inline aid_slot* local_aid_slot() {
+  return &s_aid_slot;
+}
+
+aid_slot* registered_local_aid_slot() {
+  if (!s_aid_slot_registered) {
+    s_aid_slot_registered = true;
+    static thread_local aid_slot_guard guard;
+  }
+  return &s_aid_slot;
+}
+
+#else // CAF_NO_THREAD_LOCAL
+
+pthread_key_t s_aid_key;
+pthread_once_t s_aid_key_once = PTHREAD_ONCE_INIT;
+
+void aid_slot_destructor(void* ptr) {
+  auto x = reinterpret_cast<aid_slot*>(ptr);
+  unregister_aid_slot(x);
+  delete x;
+}
+
+void make_aid_key() {
+  pthread_key_create(&s_aid_key, aid_slot_destructor);
+}
+
+aid_slot* local_aid_slot() {
+  pthread_once(&s_aid_key_once, make_aid_key);
+  return reinterpret_cast<aid_slot*>(pthread_getspecific(s_aid_key));
+}
+
+aid_slot* registered_local_aid_slot() {
+  auto x = local_aid_slot();
+  if (x == nullptr) {
+    x = new aid_slot;
+    x->aid = 0;
+    register_aid_slot(x);
+    pthread_setspecific(s_aid_key, x);
+  }
+  return x;
+}
+
+#endif // CAF_NO_THREAD_LOCAL
+
 } // namespace <anonymous>
 
 logger::line_builder::line_builder() : behind_arg_(false) {
@@ -136,30 +299,51 @@ std::string logger::line_builder::get() const {
   return std::move(str_);
 }
 
+logger::record_builder::record_builder() : buf_(record_buf()) {
+  buf_.clear();
+}
+
+logger::record_builder&
+logger::record_builder::operator<<(const std::string& str) {
+  buf_ += static_cast<char>(detail::text_item);
+  detail::append_log_string(buf_, str);
+  return *this;
+}
+
+logger::record_builder& logger::record_builder::operator<<(const char* str) {
+  buf_ += static_cast<char>(detail::text_item);
+  detail::append_log_string(buf_, str);
+  return *this;
+}
+
 // returns the actor ID for the current thread
 actor_id logger::thread_local_aid() {
-  shared_lock<detail::shared_spinlock> guard{aids_lock_};
-  auto i = aids_.find(std::this_thread::get_id());
-  if (i != aids_.end())
-    return i->second;
-  return 0;
+  auto x = local_aid_slot();
+#ifdef CAF_NO_THREAD_LOCAL
+  if (x == nullptr)
+    return 0;
+#endif
+  return x->aid.load(std::memory_order_relaxed);
 }
 
 actor_id logger::thread_local_aid(actor_id aid) {
-  auto tid = std::this_thread::get_id();
-  upgrade_lock<detail::shared_spinlock> guard{aids_lock_};
-  auto i = aids_.find(tid);
-  if (i != aids_.end()) {
-    // we modify it despite the shared lock because the elements themselves
-    // are considered thread-local
-    auto res = i->second;
-    i->second = aid;
-    return res;
+  auto x = registered_local_aid_slot();
+  // no need for an atomic exchange, since only this thread writes to its slot
+  auto res = x->aid.load(std::memory_order_relaxed);
+  x->aid.store(aid, std::memory_order_relaxed);
+  return res;
+}
+
+std::vector<std::pair<std::thread::id, actor_id>> logger::thread_aids() {
+  std::vector<std::pair<std::thread::id, actor_id>> result;
+  auto& reg = aids();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  result.reserve(reg.slots.size());
+  for (auto& x : reg.slots) {
+    auto aid = x.second->aid.load(std::memory_order_relaxed);
+    result.emplace_back(x.first, aid);
   }
-  // upgrade to unique lock and insert new element
-  upgrade_to_unique_lock<detail::shared_spinlock> uguard{guard};
-  aids_.emplace(tid, aid);
-  return 0; // was empty before
+  return result;
 }
 
 void logger::log(event* x) {
@@ -172,6 +356,76 @@ void logger::log(event* x) {
   }
 }
 
+void logger::log(uint32_t site, const std::string& payload) {
+  auto ring = local_ring();
+  if (ring == nullptr)
+    return;
+  detail::log_record header;
+  header.site = site;
+  header.thread = ring->thread();
+  header.aid = thread_local_aid();
+  header.tstamp = make_timestamp().time_since_epoch().count();
+  auto n = detail::log_record_count(payload.size());
+  if (n > detail::log_ring::capacity) {
+    // never block on payloads that cannot fit into the buffer
+    return;
+  }
+  // wait for the logger thread rather than dropping events
+  while (ring->available() < n) {
+    if (!binary_running_)
+      return;
+    wake_binary();
+    std::this_thread::yield();
+  }
+  size_t i = 0;
+  detail::split_log_payload(header, payload, [&]() -> detail::log_record& {
+    return ring->at(i++);
+  });
+  ring->publish(n);
+  if (binary_idle_.load())
+    wake_binary();
+}
+
+void logger::wake_binary() {
+  { // lock scope
+    std::unique_lock<std::mutex> guard{binary_mtx_};
+    binary_idle_ = false;
+  }
+  binary_cv_.notify_one();
+}
+
+uint32_t logger::register_site(int level, const char* component,
+                               const char* pretty_fun, const char* file_name,
+                               int line_number) {
+  auto& reg = sites();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  reg.sites.emplace_back(
+    call_site{level, component, pretty_fun, file_name, line_number});
+  return static_cast<uint32_t>(reg.sites.size() - 1);
+}
+
+detail::log_ring* logger::local_ring() {
+#ifndef CAF_NO_THREAD_LOCAL
+  auto& cache = s_ring_cache;
+  if (cache.instance != instance_) {
+    if (!binary_running_)
+      return nullptr;
+    std::ostringstream tid;
+    tid << std::this_thread::get_id();
+    std::unique_lock<std::mutex> guard{rings_mtx_};
+    if (cache.ring)
+      cache.ring->retire();
+    auto num = next_thread_num_++;
+    cache.ring = std::make_shared<detail::log_ring>(num, tid.str());
+    cache.instance = instance_;
+    rings_.push_back(cache.ring);
+  }
+  return cache.ring.get();
+#else
+  return nullptr;
+#endif
+}
+
 void logger::set_current_actor_system(actor_system* x) {
   if (x != nullptr)
     set_current_logger(&x->logger());
@@ -205,7 +459,14 @@ logger::~logger() {
   system_.logger_dtor_cv_.notify_one();
 }
 
-logger::logger(actor_system& sys) : system_(sys), inline_output_(false) {
+logger::logger(actor_system& sys)
+    : system_(sys),
+      inline_output_(false),
+      binary_output_(false),
+      instance_(++s_logger_instances),
+      binary_running_(false),
+      next_thread_num_(1),
+      binary_idle_(false) {
   // nop
 }
 
@@ -213,6 +474,14 @@ void logger::init(actor_system_config& cfg) {
   CAF_IGNORE_UNUSED(cfg);
 #if defined(CAF_LOG_LEVEL)
   inline_output_ = cfg.logger_inline_output;
+  binary_output_ = cfg.logger_binary_output;
+#ifdef CAF_NO_THREAD_LOCAL
+  if (binary_output_) {
+    std::cerr << "binary log output requires thread_local support"
+              << std::endl;
+    binary_output_ = false;
+  }
+#endif
   // Parse the configured log level.
   switch (static_cast<uint64_t>(cfg.logger_verbosity)) {
     case atom_uint("quiet"):
@@ -314,23 +583,143 @@ void logger::render_date(std::ostream& out, timestamp x) {
 void logger::render(std::ostream& out, const line_format& lf,
                     const event& x) const {
   for (auto& f : lf)
-    switch (f.kind) {
-      case category_field: out << x.category_name; break;
-      case class_name_field: render_fun_prefix(out, x.pretty_fun); break;
-      case date_field: render_date(out, x.tstamp); break;
-      case file_field: out << x.file_name; break;
-      case line_field: out << x.line_number; break;
-      case message_field: out << x.message; break;
-      case method_field: render_fun_name(out, x.pretty_fun); break;
-      case newline_field: out << std::endl; break;
-      case priority_field: out << log_level_name[x.level]; break;
-      case runtime_field: render_time_diff(out, t0_, x.tstamp); break;
-      case thread_field: out << x.tid; break;
-      case actor_field: out << "actor" << x.aid; break;
-      case percent_sign_field: out << '%'; break;
-      case plain_text_field: out.write(f.first, f.last - f.first); break;
-      default: ; // nop
+    if (f.kind == thread_field)
+      out << x.tid;
+    else
+      render_field(out, f, x, t0_);
+}
+
+void logger::render_field(std::ostream& out, const field& f, const event& x,
+                          timestamp t0) {
+  switch (f.kind) {
+    case category_field: out << x.category_name; break;
+    case class_name_field: render_fun_prefix(out, x.pretty_fun); break;
+    case date_field: render_date(out, x.tstamp); break;
+    case file_field: out << x.file_name; break;
+    case line_field: out << x.line_number; break;
+    case message_field: out << x.message; break;
+    case method_field: render_fun_name(out, x.pretty_fun); break;
+    case newline_field: out << std::endl; break;
+    case priority_field: out << log_level_name[x.level]; break;
+    case runtime_field: render_time_diff(out, t0, x.tstamp); break;
+    case actor_field: out << "actor" << x.aid; break;
+    case percent_sign_field: out << '%'; break;
+    case plain_text_field: out.write(f.first, f.last - f.first); break;
+    default: ; // nop
+  }
+}
+
+bool logger::render_binary(std::istream& in, std::ostream& out,
+                           const line_format& lf) {
+  using namespace detail;
+  struct site_info {
+    int32_t level;
+    int32_t line_number;
+    std::string component;
+    std::string pretty_fun;
+    std::string file_name;
+  };
+  struct decoded_event {
+    const site_info* site;
+    uint32_t thread;
+    uint64_t aid;
+    int64_t tstamp;
+    std::string message;
+  };
+  auto read_str = [&](std::string& x) {
+    uint32_t n;
+    if (!in.read(reinterpret_cast<char*>(&n), sizeof(n)))
+      return false;
+    x.resize(n);
+    return n == 0 || static_cast<bool>(in.read(&x[0], n));
+  };
+  auto read_raw = [&](void* x, size_t n) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(x),
+                                     static_cast<std::streamsize>(n)));
+  };
+  char magic[binary_log_magic_size];
+  int64_t t0;
+  if (!read_raw(magic, sizeof(magic))
+      || memcmp(magic, binary_log_magic, sizeof(magic)) != 0
+      || !read_raw(&t0, sizeof(t0)))
+    return false;
+  std::unordered_map<uint32_t, site_info> sites;
+  std::unordered_map<uint32_t, std::string> threads;
+  // collects the payload of events that span multiple records
+  std::unordered_map<uint32_t, std::string> pending;
+  std::vector<decoded_event> events;
+  char tag;
+  while (in.get(tag)) {
+    switch (tag) {
+      case site_block: {
+        uint32_t id;
+        site_info x;
+        if (!read_raw(&id, sizeof(id)) || !read_raw(&x.level, sizeof(x.level))
+            || !read_raw(&x.line_number, sizeof(x.line_number))
+            || !read_str(x.component) || !read_str(x.pretty_fun)
+            || !read_str(x.file_name)
+            || x.level < CAF_LOG_LEVEL_ERROR || x.level > CAF_LOG_LEVEL_TRACE)
+          return false;
+        sites[id] = std::move(x);
+        break;
+      }
+      case thread_block: {
+        uint32_t num;
+        std::string str;
+        if (!read_raw(&num, sizeof(num)) || !read_str(str))
+          return false;
+        threads[num] = std::move(str);
+        break;
+      }
+      case record_block: {
+        log_record x;
+        if (!read_raw(&x, sizeof(x)) || x.size > log_record_payload_size)
+          return false;
+        auto site = sites.find(x.site);
+        if (site == sites.end())
+          return false;
+        auto& buf = pending[x.thread];
+        buf.append(x.payload, x.size);
+        if ((x.flags & log_record_continued) != 0)
+          break;
+        decoded_event y{&site->second, x.thread, x.aid, x.tstamp, {}};
+        if (!render_log_payload(y.message, buf.data(), buf.size()))
+          return false;
+        buf.clear();
+        events.push_back(std::move(y));
+        break;
+      }
+      default:
+        return false;
     }
+  }
+  // each thread writes its events in order, but the logger thread drains
+  // the buffers of multiple threads in batches
+  std::stable_sort(events.begin(), events.end(),
+                   [](const decoded_event& x, const decoded_event& y) {
+                     return x.tstamp < y.tstamp;
+                   });
+  timestamp t0_ts{timestamp::duration{t0}};
+  for (auto& x : events) {
+    auto& site = *x.site;
+    event ev{nullptr,
+             nullptr,
+             site.level,
+             site.component.c_str(),
+             site.pretty_fun.c_str(),
+             site.file_name.c_str(),
+             site.line_number,
+             std::move(x.message),
+             std::thread::id{},
+             x.aid,
+             timestamp{timestamp::duration{x.tstamp}}};
+    for (auto& f : lf)
+      if (f.kind == thread_field)
+        out << threads[x.thread];
+      else
+        render_field(out, f, ev, t0_ts);
+  }
+  return true;
 }
 
 logger::line_format logger::parse_format(const char* format_str) {
@@ -432,6 +821,15 @@ void logger::log_first_line() {
   msg += to_string(system_.config().logger_verbosity);
   msg += ", node = ";
   msg += to_string(system_.node());
+  if (binary_output_) {
+    static const auto site = register_site(CAF_LOG_LEVEL_INFO,
+                                           CAF_LOG_COMPONENT, CAF_PRETTY_FUN,
+                                           __FILE__, __LINE__);
+    // use the start time to make sure this remains the first line after
+    // sorting events by their timestamp
+    write_binary(site, msg, t0_);
+    return;
+  }
   event tmp{nullptr,
             nullptr,
             CAF_LOG_LEVEL_INFO,
@@ -447,6 +845,13 @@ void logger::log_first_line() {
 }
 
 void logger::log_last_line() {
+  if (binary_output_) {
+    static const auto site = register_site(CAF_LOG_LEVEL_INFO,
+                                           CAF_LOG_COMPONENT, CAF_PRETTY_FUN,
+                                           __FILE__, __LINE__);
+    write_binary(site, "EOF", make_timestamp());
+    return;
+  }
   event tmp{nullptr,
             nullptr,
             CAF_LOG_LEVEL_INFO,
@@ -461,6 +866,96 @@ void logger::log_last_line() {
   handle_event(tmp);
 }
 
+void logger::write_binary(uint32_t site, const std::string& msg,
+                          timestamp t) {
+  write_site(site);
+  record_builder payload;
+  payload << msg;
+  detail::log_record header;
+  header.site = site;
+  header.thread = 0;
+  header.aid = 0;
+  header.tstamp = t.time_since_epoch().count();
+  auto& buf = payload.get();
+  std::vector<detail::log_record> xs(detail::log_record_count(buf.size()));
+  size_t i = 0;
+  detail::split_log_payload(header, buf, [&]() -> detail::log_record& {
+    return xs[i++];
+  });
+  for (auto& x : xs)
+    detail::write_log_record(file_, x);
+}
+
+void logger::write_site(uint32_t site) {
+  if (site < known_sites_.size() && known_sites_[site])
+    return;
+  if (site >= known_sites_.size())
+    known_sites_.resize(site + 1, false);
+  known_sites_[site] = true;
+  auto& reg = sites();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  auto& x = reg.sites[site];
+  detail::write_log_site(file_, site, x.level, x.component, x.pretty_fun,
+                         x.file_name, x.line_number);
+}
+
+size_t logger::drain_rings() {
+  { // lock scope
+    std::unique_lock<std::mutex> guard{rings_mtx_};
+    for (auto& ring : rings_) {
+      detail::write_log_thread(file_, ring->thread(), ring->thread_str());
+      known_rings_.push_back(std::move(ring));
+    }
+    rings_.clear();
+  }
+  size_t result = 0;
+  auto i = known_rings_.begin();
+  while (i != known_rings_.end()) {
+    // check the flag first, since the thread may publish its last records
+    // between consuming and checking the flag otherwise
+    auto retired = (*i)->retired();
+    result += (*i)->consume([&](const detail::log_record& x) {
+      write_site(x.site);
+      detail::write_log_record(file_, x);
+    });
+    if (retired)
+      i = known_rings_.erase(i);
+    else
+      ++i;
+  }
+  return result;
+}
+
+void logger::run_binary() {
+#if defined(CAF_LOG_LEVEL)
+  detail::write_log_header(file_, t0_.time_since_epoch().count());
+  std::ostringstream tid;
+  tid << std::this_thread::get_id();
+  detail::write_log_thread(file_, 0, tid.str());
+  log_first_line();
+  // Writers only wake up the logger thread after it went idle. Otherwise, the
+  // logger thread keeps draining the ring buffers without any notification.
+  // A writer may miss the idle flag while the logger thread goes to sleep,
+  // hence the logger thread sleeps for at most `max_idle`.
+  constexpr auto max_idle = std::chrono::milliseconds(10);
+  while (binary_running_) {
+    binary_idle_ = true;
+    if (drain_rings() > 0) {
+      binary_idle_ = false;
+      continue;
+    }
+    std::unique_lock<std::mutex> guard{binary_mtx_};
+    binary_cv_.wait_for(guard, max_idle, [&] {
+      return !binary_idle_ || !binary_running_;
+    });
+    binary_idle_ = false;
+  }
+  drain_rings();
+  log_last_line();
+  file_.flush();
+#endif
+}
+
 void logger::start() {
 #if defined(CAF_LOG_LEVEL)
   parent_thread_ = std::this_thread::get_id();
@@ -495,12 +990,29 @@ void logger::start() {
       auto nid = to_string(system_.node());
       f.replace(i, i + sizeof(node) - 1, nid);
     }
-    file_.open(f, std::ios::out | std::ios::app);
+    if (binary_output_)
+      file_.open(f, std::ios::out | std::ios::trunc | std::ios::binary);
+    else
+      file_.open(f, std::ios::out | std::ios::app);
     if (!file_) {
       std::cerr << "unable to open log file " << f << std::endl;
       return;
     }
   }
+  if (binary_output_) {
+    if (!file_.is_open()) {
+      // binary output only goes to a file
+      binary_output_ = false;
+    } else {
+      binary_running_ = true;
+      thread_ = std::thread{[this] {
+        this->system_.thread_started();
+        this->run_binary();
+        this->system_.thread_terminates();
+      }};
+      return;
+    }
+  }
   if (inline_output_)
     log_first_line();
   else
@@ -514,6 +1026,13 @@ void logger::start() {
 
 void logger::stop() {
 #if defined(CAF_LOG_LEVEL)
+  if (binary_output_) {
+    binary_running_ = false;
+    wake_binary();
+    if (thread_.joinable())
+      thread_.join();
+    return;
+  }
   if (inline_output_) {
     log_last_line();
     return;
@@ -36,7 +36,7 @@ public:
     auto ptr = msg_.vals().raw_ptr();
     if (ptr != nullptr)
       return *ptr;
-    return dummy_;
+    return dummy();
   }
 
   message move_content_to_message() override {
@@ -57,7 +57,8 @@ private:
 mailbox_element::mailbox_element()
     : next(nullptr),
       prev(nullptr),
-      marked(false) {
+      marked(false),
+      enqueued(0) {
   // nop
 }
 
@@ -65,10 +66,11 @@ mailbox_element::mailbox_element(strong_actor_ptr&& x, message_id y,
                                  forwarding_stack&& z)
     : next(nullptr),
       prev(nullptr),
-      marked(false),
       sender(std::move(x)),
       mid(y),
-      stages(std::move(z)) {
+      stages(std::move(z)),
+      marked(false),
+      enqueued(0) {
   // nop
 }
 
@@ -77,7 +79,7 @@ mailbox_element::~mailbox_element() {
 }
 
 type_erased_tuple& mailbox_element::content() {
-  return dummy_;
+  return dummy();
 }
 
 message mailbox_element::move_content_to_message() {
@@ -88,6 +90,12 @@ message mailbox_element::copy_content_to_message() const {
   return {};
 }
 
+type_erased_tuple& mailbox_element::dummy() {
+  // empty tuples are stateless and thus safe to share between threads
+  static empty_type_erased_tuple instance;
+  return instance;
+}
+
 const type_erased_tuple& mailbox_element::content() const {
   return const_cast<mailbox_element*>(this)->content();
 }
@@ -21,6 +21,7 @@
 #include <iostream>
 #include <utility>
 #include <utility>
+#include <vector>
 
 #include "caf/serializer.hpp"
 #include "caf/actor_system.hpp"
@@ -28,6 +29,7 @@
 #include "caf/message_builder.hpp"
 #include "caf/message_handler.hpp"
 #include "caf/string_algorithms.hpp"
+#include "caf/tuple_view.hpp"
 
 #include "caf/detail/decorated_tuple.hpp"
 #include "caf/detail/concatenated_tuple.hpp"
@@ -35,6 +37,27 @@
 
 namespace caf {
 
+namespace {
+
+// Calls `f` for each type name in the range `[first, last)` of names
+// separated by '+' signs.
+template <class F>
+error for_each_type(std::string::iterator first, std::string::iterator last,
+                    std::string& tmp, F f) {
+  auto i = first;
+  do {
+    auto n = std::find(i, last, '+');
+    tmp.assign(i, n);
+    auto err = f(tmp);
+    if (err)
+      return err;
+    i = n != last ? n + 1 : last;
+  } while (i != last);
+  return none;
+}
+
+} // namespace <anonymous>
+
 message::message(none_t) noexcept {
   // nop
 }
@@ -123,9 +146,10 @@ optional<message> message::apply(message_handler handler) {
 
 message message::extract_impl(size_t start, message_handler handler) const {
   auto s = size();
+  tuple_view xs{*this};
   for (size_t i = start; i < s; ++i) {
     for (size_t n = (s - i) ; n > 0; --n) {
-      auto next_slice = slice(i, n);
+      auto next_slice = xs.slice(i, n);
       auto res = handler(next_slice);
       if (res) {
         std::vector<size_t> mapping(s);
@@ -452,30 +476,40 @@ error inspect(deserializer& source, message& msg) {
   if (tname.compare(0, 4, "@<>+") != 0)
     return sec::unknown_type;
   // iterate over concatenated type names
+  auto first = tname.begin() + 4; // skip "@<>+"
   auto eos = tname.end();
-  auto next = [&](std::string::iterator iter) {
-    return std::find(iter, eos, '+');
-  };
   auto& types = source.context()->system().types();
   auto dmd = make_counted<detail::dynamic_message_data>();
   std::string tmp;
-  std::string::iterator i = next(tname.begin());
-  ++i; // skip first '+' sign
-  do {
-    auto n = next(i);
-    tmp.assign(i, n);
-    auto ptr = types.make_value(tmp);
+  // allocate the memory for all elements at once, remembering the
+  // descriptors to avoid a second lookup per element
+  std::vector<const detail::value_descriptor*> descriptors;
+  size_t value_bytes = 0;
+  for_each_type(first, eos, tmp, [&](const std::string& name) {
+    auto x = types.descriptor(name);
+    if (x != nullptr)
+      value_bytes += detail::dynamic_message_data::storage_size(x);
+    descriptors.push_back(x);
+    return error{};
+  });
+  dmd->reserve(descriptors.size(), value_bytes);
+  auto next = descriptors.begin();
+  err = for_each_type(first, eos, tmp, [&](const std::string& name) -> error {
+    auto x = *next++;
+    if (x != nullptr && x->make != nullptr)
+      return dmd->emplace(x)->load(source);
+    // fall back to the factory for types without descriptor
+    auto ptr = types.make_value(name);
     if (!ptr)
-      return make_error(sec::unknown_type, tmp);
-    err = ptr->load(source);
-    if (err)
-      return err;
+      return make_error(sec::unknown_type, name);
+    auto e = ptr->load(source);
+    if (e)
+      return e;
     dmd->append(std::move(ptr));
-    if (n != eos)
-      i = n + 1;
-    else
-      i = eos;
-  } while (i != eos);
+    return error{};
+  });
+  if (err)
+    return err;
   err = source.end_object();
   if (err)
     return err;
@@ -57,6 +57,15 @@ message_builder& message_builder::emplace(type_erased_value_ptr x) {
   return *this;
 }
 
+void* message_builder::allocate(const detail::value_descriptor* x) {
+  return data()->allocate(x);
+}
+
+void message_builder::commit(const detail::value_descriptor* x,
+                             type_erased_value* ptr) {
+  data()->commit(x, ptr);
+}
+
 message message_builder::to_message() const {
   // this const_cast is safe, because the message is
   // guaranteed to detach its data before modifying it
@@ -18,6 +18,8 @@
 
 #include "caf/outbound_path.hpp"
 
+#include <algorithm>
+
 #include "caf/send.hpp"
 #include "caf/logger.hpp"
 #include "caf/no_stages.hpp"
@@ -81,9 +83,33 @@ void outbound_path::emit_batch(long xs_size, message xs) {
   stream_msg::batch batch{static_cast<int32_t>(xs_size), std::move(xs), bid};
   if (redeployable)
     unacknowledged_batches.emplace_back(bid, batch);
+  in_flight.push(xs_size, detail::ack_window::clock_type::now());
   unsafe_send_as(self, hdl, stream_msg{sid, self->address(), std::move(batch)});
 }
 
+void outbound_path::handle_ack_batch(int64_t acked_id) {
+  CAF_LOG_TRACE(CAF_ARG(acked_id));
+  auto x = in_flight.release(acked_id);
+  if (x == nullptr)
+    return;
+  ack_rtt.record(detail::ack_window::clock_type::now() - x->sent);
+  next_ack_id = in_flight.first_id();
+  if (!unacknowledged_batches.empty()) {
+    // Batch IDs are consecutive, so we can compute the range to release.
+    auto n = acked_id - unacknowledged_batches.front().first + 1;
+    auto size = static_cast<int64_t>(unacknowledged_batches.size());
+    if (n > 0) {
+      auto first = unacknowledged_batches.begin();
+      unacknowledged_batches.erase(first, first + std::min(n, size));
+    }
+  }
+}
+
+outbound_path_metrics outbound_path::metrics() const {
+  return {sid, hdl ? hdl->address() : actor_addr{}, open_credit,
+          in_flight.elements(), in_flight.batches(), ack_rtt};
+}
+
 void outbound_path::emit_irregular_shutdown(local_actor* self,
                                             const stream_id& sid,
                                             const strong_actor_ptr& hdl,
@@ -0,0 +1,190 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/pending_response_table.hpp"
+
+namespace caf {
+namespace detail {
+
+constexpr size_t pending_response_table::min_capacity;
+
+constexpr size_t pending_response_table::npos;
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+pending_response_table::pending_response_table()
+    : size_(0),
+      num_handlers_(0) {
+  // nop
+}
+
+// -- properties ---------------------------------------------------------------
+
+optional<pending_response_table::time_point>
+pending_response_table::next_timeout() const {
+  if (timeouts_.empty())
+    return none;
+  return timeouts_.front().first;
+}
+
+bool pending_response_table::expired(message_id id) const noexcept {
+  auto i = find(id);
+  return i != npos && slots_[i].timeout == expired_mark();
+}
+
+// -- modifiers ----------------------------------------------------------------
+
+void pending_response_table::add_handler(message_id id, response_handler f) {
+  CAF_ASSERT(id.valid());
+  auto& x = slots_[emplace(id)];
+  if (!x.handler)
+    ++num_handlers_;
+  x.handler = std::move(f);
+}
+
+bool pending_response_table::add_timeout(message_id id, time_point t) {
+  CAF_ASSERT(id.valid());
+  slots_[emplace(id)].timeout = t;
+  if (timeouts_.size() > 2 * size_ + min_capacity)
+    compact_timeouts();
+  auto earliest = timeouts_.empty() || t < timeouts_.front().first;
+  timeouts_.emplace_back(t, id);
+  std::push_heap(timeouts_.begin(), timeouts_.end(), heap_order{});
+  return earliest;
+}
+
+response_handler pending_response_table::take(message_id id) {
+  response_handler result;
+  auto i = find(id);
+  if (i != npos) {
+    auto& x = slots_[i];
+    if (x.handler) {
+      result = std::move(x.handler);
+      --num_handlers_;
+    }
+    erase_at(i);
+  }
+  return result;
+}
+
+void pending_response_table::erase(message_id id) {
+  auto i = find(id);
+  if (i != npos)
+    erase_at(i);
+}
+
+void pending_response_table::clear() {
+  slots_.clear();
+  timeouts_.clear();
+  size_ = 0;
+  num_handlers_ = 0;
+}
+
+// -- utility functions --------------------------------------------------------
+
+size_t pending_response_table::find(message_id id) const noexcept {
+  if (size_ == 0)
+    return npos;
+  auto mask = slots_.size() - 1;
+  for (size_t i = home(id), d = 0;; i = (i + 1) & mask, ++d) {
+    auto& x = slots_[i];
+    // entries closer to their home slot than `d` end the probe sequence
+    if (!x.id.valid() || distance(i) < d)
+      return npos;
+    if (x.id == id)
+      return i;
+  }
+}
+
+size_t pending_response_table::emplace(message_id id) {
+  auto i = find(id);
+  if (i != npos)
+    return i;
+  // keep the load factor below 3/4
+  if (4 * (size_ + 1) > 3 * slots_.size())
+    grow();
+  slot x;
+  x.id = id;
+  ++size_;
+  return insert(std::move(x));
+}
+
+size_t pending_response_table::insert(slot x) {
+  auto result = npos;
+  auto mask = slots_.size() - 1;
+  for (size_t i = home(x.id), d = 0;; i = (i + 1) & mask, ++d) {
+    auto& y = slots_[i];
+    if (!y.id.valid()) {
+      y = std::move(x);
+      return result != npos ? result : i;
+    }
+    // Robin Hood: take the slot from entries closer to their home slot
+    auto dy = distance(i);
+    if (dy < d) {
+      std::swap(x, y);
+      if (result == npos)
+        result = i;
+      d = dy;
+    }
+  }
+}
+
+void pending_response_table::erase_at(size_t pos) {
+  CAF_ASSERT(pos < slots_.size() && slots_[pos].id.valid());
+  if (slots_[pos].handler)
+    --num_handlers_;
+  --size_;
+  // Close the gap by shifting back all following entries until reaching an
+  // empty slot or an entry in its home slot (no tombstones needed).
+  auto mask = slots_.size() - 1;
+  auto i = pos;
+  for (auto j = (i + 1) & mask; slots_[j].id.valid() && distance(j) > 0;
+       j = (j + 1) & mask) {
+    slots_[i] = std::move(slots_[j]);
+    i = j;
+  }
+  auto& x = slots_[i];
+  x.id = invalid_message_id;
+  x.timeout = time_point{};
+  x.handler.reset();
+  // answered requests no longer need their deadlines
+  if (size_ == 0)
+    timeouts_.clear();
+}
+
+void pending_response_table::grow() {
+  std::vector<slot> tmp;
+  tmp.swap(slots_);
+  slots_.resize(std::max(min_capacity, tmp.size() * 2));
+  for (auto& x : tmp)
+    if (x.id.valid())
+      insert(std::move(x));
+}
+
+void pending_response_table::compact_timeouts() {
+  auto pred = [&](const heap_entry& x) {
+    auto i = find(x.second);
+    return i == npos || slots_[i].timeout != x.first;
+  };
+  auto e = std::remove_if(timeouts_.begin(), timeouts_.end(), pred);
+  timeouts_.erase(e, timeouts_.end());
+  std::make_heap(timeouts_.begin(), timeouts_.end(), heap_order{});
+}
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,335 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/print_sink.hpp"
+
+#include <vector>
+#include <utility>
+#include <unordered_set>
+
+#include "caf/atom.hpp"
+#include "caf/config.hpp"
+#include "caf/message_id.hpp"
+#include "caf/mailbox_element.hpp"
+
+#ifdef CAF_WINDOWS
+#include <iostream>
+#else
+#include <cerrno>
+#include <climits>
+#include <unistd.h>
+#include <sys/uio.h>
+#endif
+
+// The sink buffers output in thread-local storage. Without `thread_local`,
+// the scheduler creates no sink and `aout` only uses the printer actor.
+#ifndef CAF_NO_THREAD_LOCAL
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+// flush the thread-local buffer early when exceeding this many bytes
+constexpr size_t max_buffered_bytes = 64 * 1024;
+
+// sinks that are still alive, leaked on purpose to remain usable for threads
+// exiting during static destruction
+struct sink_registry {
+  std::mutex mtx;
+  std::unordered_set<const print_sink*> sinks;
+};
+
+sink_registry& live_sinks() {
+  static auto result = new sink_registry;
+  return *result;
+}
+
+struct output_buffer {
+  // sink that owns the buffered output
+  print_sink* owner = nullptr;
+  // size of all buffered strings
+  size_t bytes = 0;
+  // buffered output grouped by actor
+  std::vector<std::pair<actor_id, std::string>> entries;
+
+  ~output_buffer() {
+    // writes output of actors that never flushed on this thread
+    if (entries.empty())
+      return;
+    auto& reg = live_sinks();
+    std::unique_lock<std::mutex> guard{reg.mtx};
+    if (reg.sinks.count(owner) > 0)
+      owner->flush();
+  }
+};
+
+thread_local output_buffer s_buf;
+
+#ifdef CAF_WINDOWS
+
+void write_lines(const std::vector<std::string*>& xs) {
+  for (auto x : xs)
+    std::cout.write(x->data(), static_cast<std::streamsize>(x->size()));
+  std::cout.flush();
+}
+
+#else // CAF_WINDOWS
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+void write_lines(const std::vector<std::string*>& xs) {
+  std::vector<iovec> iov;
+  iov.reserve(xs.size());
+  for (auto x : xs)
+    iov.push_back(iovec{const_cast<char*>(x->data()), x->size()});
+  auto first = iov.data();
+  auto last = first + iov.size();
+  while (first != last) {
+    auto n = std::min(static_cast<ptrdiff_t>(IOV_MAX), last - first);
+    auto res = ::writev(STDOUT_FILENO, first, static_cast<int>(n));
+    if (res < 0) {
+      if (errno == EINTR)
+        continue;
+      return; // nothing we could do about it
+    }
+    // skip over all bytes written and resume after a partial write
+    auto written = static_cast<size_t>(res);
+    while (first != last && written >= first->iov_len) {
+      written -= first->iov_len;
+      ++first;
+    }
+    if (written > 0) {
+      first->iov_base = static_cast<char*>(first->iov_base) + written;
+      first->iov_len -= written;
+    }
+  }
+}
+
+#endif // CAF_WINDOWS
+
+} // namespace <anonymous>
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+print_sink::print_sink(actor printer)
+    : printer_(std::move(printer)),
+      redirected_all_(false),
+      any_redirect_(false) {
+  auto& reg = live_sinks();
+  std::unique_lock<std::mutex> guard{reg.mtx};
+  reg.sinks.insert(this);
+}
+
+print_sink::~print_sink() {
+  { // lifetime scope of guard
+    auto& reg = live_sinks();
+    std::unique_lock<std::mutex> guard{reg.mtx};
+    reg.sinks.erase(this);
+  }
+  // only the calling thread may have buffered output at this point
+  flush();
+  // a later sink may reuse the address of this sink
+  s_buf.owner = nullptr;
+  std::unique_lock<std::mutex> guard{mtx_};
+  std::vector<std::string*> xs;
+  for (auto& kvp : tails_)
+    xs.push_back(&kvp.second);
+  write_lines(xs);
+}
+
+// -- output -------------------------------------------------------------------
+
+void print_sink::write(actor_id aid, std::string str) {
+  if (str.empty() || aid == invalid_actor_id || forward_to_printer(aid, str))
+    return;
+  auto& buf = s_buf;
+  if (buf.owner != this) {
+    // the buffer is empty unless the calling thread uses multiple systems
+    if (!buf.entries.empty())
+      buf.owner->flush();
+    buf.owner = this;
+  }
+  buf.bytes += str.size();
+  auto i = buf.entries.rbegin();
+  auto e = buf.entries.rend();
+  while (i != e && i->first != aid)
+    ++i;
+  if (i != e)
+    i->second += str;
+  else
+    buf.entries.emplace_back(aid, std::move(str));
+  if (buf.bytes > max_buffered_bytes)
+    flush();
+}
+
+void print_sink::flush(actor_id forced) {
+  auto& buf = s_buf;
+  if (buf.owner != this) {
+    if (!buf.entries.empty())
+      buf.owner->flush();
+    buf.owner = this;
+  }
+  if (buf.entries.empty() && forced == invalid_actor_id)
+    return;
+  std::vector<std::string*> xs;
+  std::unique_lock<std::mutex> guard{mtx_};
+  auto forced_pending = forced != invalid_actor_id;
+  for (auto& x : buf.entries) {
+    auto& str = x.second;
+    auto t = tails_.find(x.first);
+    if (t != tails_.end()) {
+      str.insert(0, t->second);
+      tails_.erase(t);
+    }
+    if (x.first == forced) {
+      forced_pending = false;
+    } else {
+      // keep the incomplete line until the actor completes it
+      auto pos = str.rfind('\n');
+      if (pos == std::string::npos) {
+        tails_.emplace(x.first, std::move(str));
+        continue;
+      }
+      if (pos + 1 < str.size()) {
+        tails_.emplace(x.first, str.substr(pos + 1));
+        str.erase(pos + 1);
+      }
+    }
+    xs.push_back(&str);
+  }
+  std::string forced_tail;
+  if (forced_pending) {
+    auto t = tails_.find(forced);
+    if (t != tails_.end()) {
+      forced_tail = std::move(t->second);
+      tails_.erase(t);
+      xs.push_back(&forced_tail);
+    }
+  }
+  if (!xs.empty())
+    write_lines(xs);
+  guard.unlock();
+  buf.entries.clear();
+  buf.bytes = 0;
+}
+
+void print_sink::erase(actor_id aid) {
+  flush(aid);
+  if (any_redirect_) {
+    std::unique_lock<std::mutex> guard{mtx_};
+    redirected_.erase(aid);
+  }
+}
+
+// -- redirection --------------------------------------------------------------
+
+void print_sink::redirect(actor_id aid, std::string fn, int flags) {
+  flush();
+  std::unique_lock<std::mutex> guard{mtx_};
+  // move the incomplete line to the printer to keep it in order
+  auto t = tails_.find(aid);
+  if (t != tails_.end()) {
+    send_to_printer(aid, std::move(t->second));
+    tails_.erase(t);
+  }
+  printer_->enqueue(make_mailbox_element(nullptr, make_message_id(), {},
+                                         redirect_atom::value, aid,
+                                         std::move(fn), flags),
+                    nullptr);
+  redirected_.emplace(aid);
+  any_redirect_ = true;
+}
+
+void print_sink::redirect_all(std::string fn, int flags) {
+  flush();
+  std::unique_lock<std::mutex> guard{mtx_};
+  printer_->enqueue(make_mailbox_element(nullptr, make_message_id(), {},
+                                         redirect_atom::value,
+                                         std::move(fn), flags),
+                    nullptr);
+  for (auto& kvp : tails_)
+    send_to_printer(kvp.first, std::move(kvp.second));
+  tails_.clear();
+  redirected_all_ = true;
+  any_redirect_ = true;
+}
+
+bool print_sink::forward_to_printer(actor_id aid, std::string& str) {
+  if (!any_redirect_.load(std::memory_order_relaxed))
+    return false;
+  std::unique_lock<std::mutex> guard{mtx_};
+  if (!redirected_all_ && redirected_.count(aid) == 0)
+    return false;
+  send_to_printer(aid, std::move(str));
+  return true;
+}
+
+void print_sink::send_to_printer(actor_id aid, std::string str) {
+  printer_->enqueue(make_mailbox_element(nullptr, make_message_id(), {},
+                                         add_atom::value, aid, std::move(str)),
+                    nullptr);
+}
+
+} // namespace detail
+} // namespace caf
+
+#else // CAF_NO_THREAD_LOCAL
+
+namespace caf {
+namespace detail {
+
+// Never called, because the scheduler creates no sink in this case.
+
+print_sink::print_sink(actor printer)
+    : printer_(std::move(printer)),
+      redirected_all_(false),
+      any_redirect_(false) {
+  // nop
+}
+
+print_sink::~print_sink() {
+  // nop
+}
+
+void print_sink::write(actor_id, std::string) {
+  // nop
+}
+
+void print_sink::flush(actor_id) {
+  // nop
+}
+
+void print_sink::erase(actor_id) {
+  // nop
+}
+
+void print_sink::redirect(actor_id, std::string, int) {
+  // nop
+}
+
+void print_sink::redirect_all(std::string, int) {
+  // nop
+}
+
+} // namespace detail
+} // namespace caf
+
+#endif // CAF_NO_THREAD_LOCAL
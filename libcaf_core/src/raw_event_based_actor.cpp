@@ -31,12 +31,18 @@ invoke_message_result raw_event_based_actor::consume(mailbox_element& x) {
   CAF_LOG_TRACE(CAF_ARG(x));
   current_element_ = &x;
   CAF_LOG_RECEIVE_EVENT(current_element_);
+  // expired deadlines of outstanding requests
+  if (x.mid == detail::pending_response_table::timeout_id()) {
+    handle_response_timeouts();
+    return im_success;
+  }
   // short-circuit awaited responses
   if (!awaited_responses_.empty()) {
     auto& pr = awaited_responses_.front();
     // skip all messages until we receive the currently awaited response
     if (x.mid != pr.first)
       return im_skipped;
+    pending_responses_.erase(x.mid);
     if (!pr.second(x.content())) {
       // try again with error if first attempt failed
       auto msg = make_message(make_error(sec::unexpected_response,
@@ -44,21 +50,21 @@ invoke_message_result raw_event_based_actor::consume(mailbox_element& x) {
       pr.second(msg);
     }
     awaited_responses_.pop_front();
+    handle_expired_awaited_responses();
     return im_success;
   }
   // handle multiplexed responses
   if (x.mid.is_response()) {
-    auto mrh = multiplexed_responses_.find(x.mid);
+    auto f = pending_responses_.take(x.mid);
     // neither awaited nor multiplexed, probably an expired timeout
-    if (mrh == multiplexed_responses_.end())
+    if (!f)
       return im_dropped;
-    if (!mrh->second(x.content())) {
+    if (!f(x.content())) {
       // try again with error if first attempt failed
       auto msg = make_message(make_error(sec::unexpected_response,
                                          x.move_content_to_message()));
-      mrh->second(msg);
+      f(msg);
     }
-    multiplexed_responses_.erase(mrh);
     return im_success;
   }
   auto& content = x.content();
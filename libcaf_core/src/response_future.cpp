@@ -0,0 +1,67 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/response_future.hpp"
+
+#include "caf/actor_cast.hpp"
+
+#include "caf/detail/response_slot.hpp"
+
+namespace caf {
+
+namespace {
+
+detail::response_slot* get_slot(const strong_actor_ptr& x) {
+  return static_cast<detail::response_slot*>(actor_cast<abstract_actor*>(x));
+}
+
+} // namespace <anonymous>
+
+response_future::response_future(strong_actor_ptr slot)
+    : slot_(std::move(slot)) {
+  // nop
+}
+
+response_future& response_future::operator=(response_future&& other) {
+  release();
+  slot_ = std::move(other.slot_);
+  return *this;
+}
+
+response_future::~response_future() {
+  release();
+}
+
+expected<message> response_future::get() {
+  if (!slot_)
+    return sec::invalid_argument;
+  auto ptr = get_slot(slot_);
+  auto result = ptr->await();
+  ptr->pool()->release(std::move(slot_));
+  return result;
+}
+
+void response_future::release() {
+  if (!slot_)
+    return;
+  auto ptr = get_slot(slot_);
+  ptr->cancel();
+  ptr->pool()->release(std::move(slot_));
+}
+
+} // namespace caf
@@ -0,0 +1,56 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/response_handler.hpp"
+
+#include "caf/make_type_erased_tuple_view.hpp"
+
+#include "caf/detail/message_data.hpp"
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+struct behavior_fun {
+  behavior bhvr;
+
+  bool operator()(type_erased_tuple& xs) {
+    return bhvr(xs) != none;
+  }
+};
+
+} // namespace <anonymous>
+
+response_handler::response_handler(behavior bhvr) : vtbl_(nullptr) {
+  if (bhvr)
+    *this = make(behavior_fun{std::move(bhvr)});
+}
+
+bool response_handler::operator()(message& xs) {
+  if (xs.empty()) {
+    auto tup = make_type_erased_tuple_view();
+    return (*this)(tup);
+  }
+  // the following const-cast is safe, because response handlers are aware
+  // of copy-on-write and do not modify xs if it's shared
+  return (*this)(*const_cast<message_data*>(xs.cvals().get()));
+}
+
+} // namespace detail
+} // namespace caf
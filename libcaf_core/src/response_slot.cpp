@@ -0,0 +1,157 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/response_slot.hpp"
+
+#include <thread>
+
+#include "caf/sec.hpp"
+#include "caf/logger.hpp"
+#include "caf/make_actor.hpp"
+#include "caf/actor_cast.hpp"
+#include "caf/actor_config.hpp"
+#include "caf/actor_system.hpp"
+#include "caf/mailbox_element.hpp"
+
+namespace caf {
+namespace detail {
+
+// -- response_slot ------------------------------------------------------------
+
+response_slot::response_slot(actor_config& cfg, response_slot_pool* pool)
+    : monitorable_actor(cfg),
+      pool_(pool),
+      awaited_(0),
+      current_(0),
+      has_deadline_(false),
+      state_(idle) {
+  // nop
+}
+
+response_slot::~response_slot() {
+  // nop
+}
+
+void response_slot::enqueue(mailbox_element_ptr what, execution_unit*) {
+  CAF_ASSERT(what != nullptr);
+  // only the first response to the current request may pass
+  auto mid = what->mid.integer_value();
+  auto expected = mid;
+  if (mid == 0 || !awaited_.compare_exchange_strong(expected, 0)) {
+    CAF_LOG_DEBUG("drop unexpected message:" << CAF_ARG(what->mid));
+    return;
+  }
+  result_ = what->move_content_to_message();
+  // senders only pay for the mutex if the receiver blocks
+  if (state_.exchange(ready, std::memory_order_acq_rel) == waiting) {
+    std::unique_lock<std::mutex> guard{mtx_};
+    cv_.notify_one();
+  }
+}
+
+const char* response_slot::name() const {
+  return "response_slot";
+}
+
+message_id response_slot::arm(const duration& timeout) {
+  CAF_ASSERT(awaited_ == 0);
+  auto mid = ++last_request_id_;
+  current_ = mid.response_id().integer_value();
+  has_deadline_ = timeout.valid();
+  if (has_deadline_) {
+    deadline_ = clock_type::now();
+    deadline_ += timeout;
+  }
+  state_.store(idle, std::memory_order_relaxed);
+  awaited_.store(current_, std::memory_order_release);
+  return mid;
+}
+
+expected<message> response_slot::await() {
+  if (state_.load(std::memory_order_acquire) != ready) {
+    std::unique_lock<std::mutex> guard{mtx_};
+    auto pred = [&] {
+      return state_.load(std::memory_order_acquire) == ready;
+    };
+    int expected = idle;
+    if (state_.compare_exchange_strong(expected, waiting)) {
+      if (!has_deadline_) {
+        cv_.wait(guard, pred);
+      } else if (!cv_.wait_until(guard, deadline_, pred)) {
+        // cancel the request unless a response claimed the slot in between
+        auto mid = current_;
+        if (awaited_.compare_exchange_strong(mid, 0)) {
+          state_.store(idle, std::memory_order_relaxed);
+          return sec::request_timeout;
+        }
+        cv_.wait(guard, pred);
+      }
+    }
+  }
+  auto result = std::move(result_);
+  result_.reset();
+  state_.store(idle, std::memory_order_relaxed);
+  if (result.match_elements<error>())
+    return std::move(result.get_mutable_as<error>(0));
+  return result;
+}
+
+void response_slot::cancel() {
+  auto mid = current_;
+  if (!awaited_.compare_exchange_strong(mid, 0)) {
+    // a response claimed this slot already, wait until it finished writing
+    while (state_.load(std::memory_order_acquire) != ready)
+      std::this_thread::yield();
+    result_.reset();
+  }
+  state_.store(idle, std::memory_order_relaxed);
+}
+
+// -- response_slot_pool -------------------------------------------------------
+
+response_slot_pool::response_slot_pool(actor_system& sys) : system_(sys) {
+  // nop
+}
+
+response_slot_pool::~response_slot_pool() {
+  // nop
+}
+
+strong_actor_ptr response_slot_pool::acquire() {
+  { // lifetime scope of guard
+    std::unique_lock<std::mutex> guard{mtx_};
+    if (!slots_.empty()) {
+      auto result = std::move(slots_.back());
+      slots_.pop_back();
+      return result;
+    }
+  }
+  actor_config cfg{system_.dummy_execution_unit()};
+  cfg.flags = abstract_actor::is_hidden_flag;
+  return make_actor<response_slot, strong_actor_ptr>(
+    system_.next_actor_id(), system_.node(), &system_, cfg, this);
+}
+
+void response_slot_pool::release(strong_actor_ptr slot) {
+  CAF_ASSERT(slot != nullptr);
+  std::unique_lock<std::mutex> guard{mtx_};
+  slots_.push_back(std::move(slot));
+}
+
+} // namespace detail
+} // namespace caf
@@ -18,17 +18,36 @@
 
 #include "caf/scheduled_actor.hpp"
 
+#include <algorithm>
+
 #include "caf/config.hpp"
 #include "caf/to_string.hpp"
 #include "caf/actor_ostream.hpp"
 #include "caf/stream_msg_visitor.hpp"
 
+#include "caf/detail/print_sink.hpp"
 #include "caf/detail/private_thread.hpp"
+#include "caf/detail/tsc_clock.hpp"
 #include "caf/detail/sync_request_bouncer.hpp"
 #include "caf/detail/default_invoke_result_visitor.hpp"
 
+#include "caf/scheduler/abstract_coordinator.hpp"
+
 namespace caf {
 
+namespace {
+
+// writes pending output of `aout` before another worker can resume `self`
+void flush_aout(scheduled_actor* self) {
+  if (self->getf(abstract_actor::has_used_aout_flag)) {
+    auto sink = self->home_system().scheduler().print_sink();
+    if (sink != nullptr)
+      sink->flush();
+  }
+}
+
+} // namespace <anonymous>
+
 // -- related free functions ---------------------------------------------------
 
 result<message> reflect(scheduled_actor*, message_view& x) {
@@ -106,7 +125,10 @@ scheduled_actor::scheduled_actor(actor_config& cfg)
       , exception_handler_(default_exception_handler)
 # endif // CAF_NO_EXCEPTIONS
       {
-  // nop
+  if (getf(is_instrumented_flag)) {
+    detail::tsc_clock::calibrate();
+    metrics_.reset(new actor_metrics());
+  }
 }
 
 scheduled_actor::~scheduled_actor() {
@@ -123,6 +145,8 @@ void scheduled_actor::enqueue(mailbox_element_ptr ptr, execution_unit* eu) {
   CAF_ASSERT(!getf(is_blocking_flag));
   CAF_LOG_TRACE(CAF_ARG(*ptr));
   CAF_LOG_SEND_EVENT(ptr);
+  if (getf(is_instrumented_flag))
+    ptr->enqueued = detail::tsc_clock::stamp();
   auto mid = ptr->mid;
   auto sender = ptr->sender;
   switch (mailbox().enqueue(ptr.release())) {
@@ -167,6 +191,8 @@ void scheduled_actor::launch(execution_unit* eu, bool lazy, bool hide) {
   CAF_ASSERT(!getf(is_blocking_flag));
   if (!hide)
     register_at_system();
+  if (metrics_ != nullptr)
+    home_system().metrics().add(ctrl());
   if (getf(is_detached_flag)) {
     private_thread_ = new detail::private_thread(this);
     private_thread_->start();
@@ -191,7 +217,7 @@ bool scheduled_actor::cleanup(error&& fail_state, execution_unit* host) {
   }
   // Clear all state.
   awaited_responses_.clear();
-  multiplexed_responses_.clear();
+  pending_responses_.clear();
   if (fail_state != none)
     for (auto& kvp : streams_)
       kvp.second->abort(fail_state);
@@ -199,6 +225,9 @@ bool scheduled_actor::cleanup(error&& fail_state, execution_unit* host) {
     for (auto& kvp : streams_)
       kvp.second->close();
   streams_.clear();
+  update_stream_registry();
+  if (metrics_ != nullptr)
+    home_system().metrics().erase(id());
   // Dispatch to parent's `cleanup` function.
   return local_actor::cleanup(std::move(fail_state), host);
 }
@@ -233,11 +262,14 @@ scheduled_actor::resume(execution_unit* ctx, size_t max_throughput) {
       ptr = next_message();
       if (!ptr) {
         reset_timeout_if_needed();
+        flush_aout(this);
         if (mailbox().try_block())
           return resumable::awaiting_message;
       }
     } while (!ptr);
-    switch (reactivate(*ptr)) {
+    auto res = metrics_ == nullptr ? reactivate(*ptr)
+                                   : instrumented_reactivate(*ptr);
+    switch (res) {
       case activation_result::terminated:
         return resume_result::done;
       case activation_result::success:
@@ -261,6 +293,7 @@ scheduled_actor::resume(execution_unit* ctx, size_t max_throughput) {
     }
   }
   reset_timeout_if_needed();
+  flush_aout(this);
   if (!has_next_message() && mailbox().try_block())
     return resumable::awaiting_message;
   // time's up
@@ -288,6 +321,33 @@ void scheduled_actor::trigger_downstreams() {
     s.second->push();
 }
 
+std::vector<stream_metrics> scheduled_actor::stream_metrics_snapshot() {
+  std::vector<stream_metrics> result;
+  std::vector<stream_manager*> visited;
+  for (auto& kvp : streams_) {
+    auto ptr = kvp.second.get();
+    if (std::find(visited.begin(), visited.end(), ptr) != visited.end())
+      continue;
+    visited.push_back(ptr);
+    result.emplace_back(ptr->metrics());
+    auto& x = result.back();
+    x.owner = id();
+    x.owner_name = name();
+  }
+  return result;
+}
+
+// -- instrumentation ----------------------------------------------------------
+
+actor_metrics scheduled_actor::metrics_snapshot() const {
+  actor_metrics result;
+  if (metrics_ != nullptr)
+    result = *metrics_;
+  result.owner = id();
+  result.owner_name = name();
+  return result;
+}
+
 // -- timeout management -------------------------------------------------------
 
 uint32_t scheduled_actor::request_timeout(const duration& d) {
@@ -321,18 +381,50 @@ bool scheduled_actor::is_active_timeout(uint32_t tid) const {
 
 // -- message processing -------------------------------------------------------
 
-void scheduled_actor::add_awaited_response_handler(message_id response_id,
-                                                   behavior bhvr) {
-  if (bhvr.timeout().valid())
-    request_response_timeout(bhvr.timeout(), response_id);
-  awaited_responses_.emplace_front(response_id, std::move(bhvr));
+void scheduled_actor::add_awaited_response_handler(
+  message_id response_id, detail::response_handler f) {
+  awaited_responses_.emplace_front(response_id, std::move(f));
+}
+
+void scheduled_actor::add_multiplexed_response_handler(
+  message_id response_id, detail::response_handler f) {
+  pending_responses_.add_handler(response_id, std::move(f));
+}
+
+void scheduled_actor::request_response_timeout(const duration& d,
+                                               message_id mid) {
+  CAF_LOG_TRACE(CAF_ARG(d) << CAF_ARG(mid));
+  if (!d.valid())
+    return;
+  auto t = clock().now();
+  t += d;
+  // Setting the timeout for `timeout_id()` replaces the previous clock entry.
+  if (pending_responses_.add_timeout(mid.response_id(), t))
+    clock().set_request_timeout(t, this,
+                                detail::pending_response_table::timeout_id());
 }
 
-void scheduled_actor::add_multiplexed_response_handler(message_id response_id,
-                                                       behavior bhvr) {
-  if (bhvr.timeout().valid())
-    request_response_timeout(bhvr.timeout(), response_id);
-  multiplexed_responses_.emplace(response_id, std::move(bhvr));
+void scheduled_actor::handle_response_timeouts() {
+  CAF_LOG_TRACE("");
+  // Stale firings, e.g., for a deadline that moved or for an answered
+  // request, expire nothing and only re-arm the clock entry.
+  pending_responses_.expire(clock().now(), [&](message_id id) {
+    // Keep expired entries of awaited responses until they become active.
+    auto pred = [&](const pending_response& x) { return x.first == id; };
+    if (std::any_of(awaited_responses_.begin(), awaited_responses_.end(),
+                    pred))
+      return;
+    auto f = pending_responses_.take(id);
+    if (f) {
+      auto msg = make_message(make_error(sec::request_timeout));
+      f(msg);
+    }
+  });
+  handle_expired_awaited_responses();
+  auto t = pending_responses_.next_timeout();
+  if (t)
+    clock().set_request_timeout(*t, this,
+                                detail::pending_response_table::timeout_id());
 }
 
 scheduled_actor::message_category
@@ -350,6 +442,20 @@ scheduled_actor::categorize(mailbox_element& x) {
                                   {}, ok_atom::value, std::move(what),
                                   strong_actor_ptr{ctrl()}, name()),
             context());
+        } else if (what == "streams") {
+          CAF_LOG_DEBUG("reply to 'streams' message");
+          x.sender->enqueue(
+            make_mailbox_element(ctrl(), x.mid.response_id(),
+                                  {}, ok_atom::value, std::move(what),
+                                  stream_metrics_snapshot()),
+            context());
+        } else if (what == "metrics") {
+          CAF_LOG_DEBUG("reply to 'metrics' message");
+          x.sender->enqueue(
+            make_mailbox_element(ctrl(), x.mid.response_id(),
+                                  {}, ok_atom::value, std::move(what),
+                                  metrics_snapshot()),
+            context());
         } else {
           x.sender->enqueue(
             make_mailbox_element(ctrl(), x.mid.response_id(),
@@ -399,21 +505,34 @@ scheduled_actor::categorize(mailbox_element& x) {
   }
 }
 
+void scheduled_actor::handle_expired_awaited_responses() {
+  while (!awaited_responses_.empty()
+         && pending_responses_.expired(awaited_responses_.front().first)) {
+    auto id = awaited_responses_.front().first;
+    auto f = std::move(awaited_responses_.front().second);
+    awaited_responses_.pop_front();
+    pending_responses_.erase(id);
+    auto msg = make_message(make_error(sec::request_timeout));
+    f(msg);
+  }
+}
+
 invoke_message_result scheduled_actor::consume(mailbox_element& x) {
   CAF_LOG_TRACE(CAF_ARG(x));
   current_element_ = &x;
   CAF_LOG_RECEIVE_EVENT(current_element_);
   // Helper function for dispatching a message to a response handler.
   using ptr_t = scheduled_actor*;
-  using fun_t = bool (*)(ptr_t, behavior&, mailbox_element&);
-  auto ordinary_invoke = [](ptr_t, behavior& f, mailbox_element& in) -> bool {
-    return f(in.content()) != none;
+  using handler_t = detail::response_handler;
+  using fun_t = bool (*)(ptr_t, handler_t&, mailbox_element&);
+  auto ordinary_invoke = [](ptr_t, handler_t& f, mailbox_element& in) {
+    return f(in.content());
   };
-  auto stream_invoke = [](ptr_t p, behavior& f, mailbox_element& in) -> bool {
+  auto stream_invoke = [](ptr_t p, handler_t& f, mailbox_element& in) {
     // The only legal stream message in a response is `stream_open`.
     auto& var = in.content().get_as<stream_msg>(0).content;
     if (holds_alternative<stream_msg::open>(var))
-      return p->handle_stream_msg(in, &f);
+      return p->handle_stream_msg(in, f);
     return false;
   };
   auto select_invoke_fun = [&]() -> fun_t {
@@ -421,6 +540,11 @@ invoke_message_result scheduled_actor::consume(mailbox_element& x) {
       return ordinary_invoke;
     return stream_invoke;
   };
+  // Expired deadlines of outstanding requests share a single clock entry.
+  if (x.mid == detail::pending_response_table::timeout_id()) {
+    handle_response_timeouts();
+    return im_success;
+  }
   // Short-circuit awaited responses.
   if (!awaited_responses_.empty()) {
     auto invoke = select_invoke_fun();
@@ -430,28 +554,29 @@ invoke_message_result scheduled_actor::consume(mailbox_element& x) {
       return im_skipped;
     auto f = std::move(pr.second);
     awaited_responses_.pop_front();
+    pending_responses_.erase(x.mid);
     if (!invoke(this, f, x)) {
       // try again with error if first attempt failed
       auto msg = make_message(make_error(sec::unexpected_response,
                                          x.move_content_to_message()));
       f(msg);
     }
+    handle_expired_awaited_responses();
     return im_success;
   }
   // Handle multiplexed responses.
   if (x.mid.is_response()) {
     auto invoke = select_invoke_fun();
-    auto mrh = multiplexed_responses_.find(x.mid);
+    auto f = pending_responses_.take(x.mid);
     // neither awaited nor multiplexed, probably an expired timeout
-    if (mrh == multiplexed_responses_.end())
+    if (!f)
       return im_dropped;
-    if (!invoke(this, mrh->second, x)) {
+    if (!invoke(this, f, x)) {
       // try again with error if first attempt failed
       auto msg = make_message(make_error(sec::unexpected_response,
                                          x.move_content_to_message()));
-      mrh->second(msg);
+      f(msg);
     }
-    multiplexed_responses_.erase(mrh);
     return im_success;
   }
   // Dispatch on the content of x.
@@ -589,6 +714,8 @@ auto scheduled_actor::activate(execution_unit* ctx, mailbox_element& x)
   auto res = reactivate(x);
   if (res == activation_result::success && !bhvr_stack_.empty())
     request_timeout(bhvr_stack_.back().timeout());
+  // brokers handle IO events without calling `resume`
+  flush_aout(this);
   return res;
 }
 
@@ -628,6 +755,22 @@ auto scheduled_actor::reactivate(mailbox_element& x) -> activation_result {
 # endif // CAF_NO_EXCEPTIONS
 }
 
+auto scheduled_actor::instrumented_reactivate(mailbox_element& x)
+-> activation_result {
+  CAF_ASSERT(metrics_ != nullptr);
+  using detail::tsc_clock;
+  auto queueing_time = tsc_clock::since(x.enqueued);
+  auto t0 = tsc_clock::now();
+  auto res = reactivate(x);
+  // skipped messages get processed later from the cache
+  if (res != activation_result::skipped) {
+    auto processing_time = tsc_clock::to_duration(tsc_clock::now() - t0);
+    metrics_->queueing_time.record(queueing_time);
+    metrics_->processing_time.record(processing_time);
+  }
+  return res;
+}
+
 // -- behavior management ----------------------------------------------------
 
 void scheduled_actor::do_become(behavior bhvr, bool discard_old) {
@@ -651,6 +794,17 @@ bool scheduled_actor::finalize() {
 
 bool scheduled_actor::handle_stream_msg(mailbox_element& x,
                                         behavior* active_behavior) {
+  return handle_stream_msg_impl(x, active_behavior);
+}
+
+bool scheduled_actor::handle_stream_msg(
+  mailbox_element& x, detail::response_handler& response_handler) {
+  return handle_stream_msg_impl(x, &response_handler);
+}
+
+template <class Handler>
+bool scheduled_actor::handle_stream_msg_impl(mailbox_element& x,
+                                             Handler* handler) {
   CAF_LOG_TRACE(CAF_ARG(x));
   CAF_ASSERT(x.content().match_elements<stream_msg>());
   auto& sm = x.content().get_mutable_as<stream_msg>(0);
@@ -658,13 +812,26 @@ bool scheduled_actor::handle_stream_msg(mailbox_element& x,
     CAF_LOG_ERROR("received a stream_msg with invalid sender field");
     return false;
   }
-  stream_msg_visitor f{this, sm, active_behavior};
+  stream_msg_visitor f{this, sm, handler};
   auto result = visit(f, sm.content);
+  update_stream_registry();
   if (streams_.empty() && !has_behavior())
     quit(exit_reason::normal);
   return result;
 }
 
+void scheduled_actor::update_stream_registry() {
+  if (streams_.empty() == !getf(has_streams_flag))
+    return;
+  if (streams_.empty()) {
+    unsetf(has_streams_flag);
+    home_system().streams().erase(id());
+  } else {
+    setf(has_streams_flag);
+    home_system().streams().add(ctrl());
+  }
+}
+
 bool scheduled_actor::add_source(const stream_manager_ptr& mgr,
                                  const stream_id& sid,
                                  strong_actor_ptr source_ptr,
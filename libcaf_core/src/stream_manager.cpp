@@ -18,6 +18,8 @@
 
 #include "caf/stream_manager.hpp"
 
+#include <chrono>
+
 #include "caf/sec.hpp"
 #include "caf/error.hpp"
 #include "caf/logger.hpp"
@@ -84,13 +86,19 @@ error stream_manager::batch(const stream_id& sid, const actor_addr& hdl,
     CAF_LOG_WARNING("received batch for unknown stream");
     return sec::invalid_downstream;
   }
+  if (xs_size <= 0) {
+    CAF_LOG_WARNING("received batch with invalid size" << xs_size);
+    return sec::invalid_stream_state;
+  }
   if (xs_size > ptr->assigned_credit) {
     CAF_LOG_WARNING("batch size of" << xs_size << "exceeds assigned credit of"
                     << ptr->assigned_credit);
     return sec::invalid_stream_state;
   }
   ptr->handle_batch(xs_size, xs_id);
+  auto t0 = std::chrono::steady_clock::now();
   auto err = process_batch(xs);
+  processing_time_.record((std::chrono::steady_clock::now() - t0) / xs_size);
   if (err == none) {
     push();
     auto current_size = out().buffered();
@@ -102,11 +110,13 @@ error stream_manager::batch(const stream_id& sid, const actor_addr& hdl,
 }
 
 error stream_manager::ack_batch(const stream_id& sid, const actor_addr& hdl,
-                                long demand, int64_t) {
-  CAF_LOG_TRACE(CAF_ARG(sid) << CAF_ARG(hdl) << CAF_ARG(demand));
+                                long demand, int64_t cumulative_batch_id) {
+  CAF_LOG_TRACE(CAF_ARG(sid) << CAF_ARG(hdl) << CAF_ARG(demand)
+                << CAF_ARG(cumulative_batch_id));
   auto ptr = out().find(sid, hdl);
   if (ptr == nullptr)
     return sec::invalid_downstream;
+  ptr->handle_ack_batch(cumulative_batch_id);
   ptr->open_credit += demand;
   downstream_demand(ptr, demand);
   return none;
@@ -192,6 +202,20 @@ bool stream_manager::generate_messages() {
   return false;
 }
 
+stream_metrics stream_manager::metrics() {
+  stream_metrics result;
+  result.owner = invalid_actor_id;
+  result.buffered = out().buffered();
+  result.processing_time = processing_time_;
+  auto& ins = in();
+  for (size_t i = 0; i < static_cast<size_t>(ins.num_paths()); ++i)
+    result.inbound_paths.emplace_back(ins.path_at(i)->metrics());
+  auto& outs = out();
+  for (size_t i = 0; i < static_cast<size_t>(outs.num_paths()); ++i)
+    result.outbound_paths.emplace_back(outs.path_at(i)->metrics());
+  return result;
+}
+
 message stream_manager::make_final_result() {
   return none;
 }
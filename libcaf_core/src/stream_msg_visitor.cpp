@@ -31,7 +31,19 @@ stream_msg_visitor::stream_msg_visitor(scheduled_actor* self,
     : self_(self),
       sid_(msg.sid),
       sender_(msg.sender),
-      bhvr_(bhvr) {
+      bhvr_(bhvr),
+      response_handler_(nullptr) {
+  CAF_ASSERT(sender_ != nullptr);
+}
+
+stream_msg_visitor::stream_msg_visitor(scheduled_actor* self,
+                                       const stream_msg& msg,
+                                       detail::response_handler* f)
+    : self_(self),
+      sid_(msg.sid),
+      sender_(msg.sender),
+      bhvr_(nullptr),
+      response_handler_(f) {
   CAF_ASSERT(sender_ != nullptr);
 }
 
@@ -51,7 +63,7 @@ auto stream_msg_visitor::operator()(stream_msg::open& x) -> result_type {
     CAF_LOG_WARNING("received stream_msg::open with empty prev_stage");
     return fail(sec::invalid_upstream);
   }
-  if (bhvr_ == nullptr) {
+  if (bhvr_ == nullptr && response_handler_ == nullptr) {
     CAF_LOG_WARNING("received stream_msg::open with empty behavior");
     return fail(sec::stream_init_failed);
   }
@@ -59,8 +71,11 @@ auto stream_msg_visitor::operator()(stream_msg::open& x) -> result_type {
     CAF_LOG_WARNING("received duplicate stream_msg::open");
     return fail(sec::stream_init_failed);
   }
-  // Invoke behavior of parent to perform handshake.
-  (*bhvr_)(x.msg);
+  // Invoke behavior of parent or response handler to perform handshake.
+  if (response_handler_ != nullptr)
+    (*response_handler_)(x.msg);
+  else
+    (*bhvr_)(x.msg);
   if (self_->streams().count(sid_) == 0) {
     CAF_LOG_WARNING("actor did not provide a stream "
                     "handler after receiving handshake:"
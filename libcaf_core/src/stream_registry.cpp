@@ -0,0 +1,93 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/stream_registry.hpp"
+
+#include <iterator>
+
+#include "caf/sec.hpp"
+#include "caf/atom.hpp"
+#include "caf/locks.hpp"
+#include "caf/logger.hpp"
+#include "caf/actor_cast.hpp"
+
+#include "caf/detail/request_all.hpp"
+
+namespace caf {
+
+namespace {
+
+using exclusive_guard = unique_lock<detail::shared_spinlock>;
+using shared_guard = shared_lock<detail::shared_spinlock>;
+
+} // namespace <anonymous>
+
+stream_registry::stream_registry(actor_system& sys) : system_(sys) {
+  // nop
+}
+
+stream_registry::~stream_registry() {
+  // nop
+}
+
+void stream_registry::add(const strong_actor_ptr& x) {
+  if (x == nullptr)
+    return;
+  exclusive_guard guard{mtx_};
+  entries_.emplace(x->id(), actor_cast<weak_actor_ptr>(x));
+}
+
+void stream_registry::erase(actor_id x) {
+  exclusive_guard guard{mtx_};
+  entries_.erase(x);
+}
+
+std::vector<strong_actor_ptr> stream_registry::actors() const {
+  std::vector<strong_actor_ptr> result;
+  shared_guard guard{mtx_};
+  result.reserve(entries_.size());
+  for (auto& kvp : entries_) {
+    auto hdl = actor_cast<strong_actor_ptr>(kvp.second);
+    if (hdl)
+      result.emplace_back(std::move(hdl));
+  }
+  return result;
+}
+
+size_t stream_registry::size() const {
+  shared_guard guard{mtx_};
+  return entries_.size();
+}
+
+std::vector<stream_metrics> stream_registry::collect(const duration& timeout) {
+  CAF_LOG_TRACE(CAF_ARG(timeout));
+  std::vector<stream_metrics> result;
+  detail::request_all(
+    system_, actors(), timeout,
+    [&](ok_atom, const std::string&, std::vector<stream_metrics>& xs) {
+      std::move(xs.begin(), xs.end(), std::back_inserter(result));
+    },
+    [&](const error& err) {
+      CAF_LOG_DEBUG("unable to collect stream metrics:" << CAF_ARG(err));
+      CAF_IGNORE_UNUSED(err);
+    },
+    sys_atom::value, get_atom::value, "streams");
+  return result;
+}
+
+} // namespace caf
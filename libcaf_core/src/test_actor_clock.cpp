@@ -30,6 +30,8 @@ bool test_actor_clock::dispatch_once() {
     return false;
   visitor f{this};
   auto i = schedule_.begin();
+  if (i->first > current_time)
+    current_time = i->first;
   visit(f, i->second);
   schedule_.erase(i);
   return true;
@@ -40,8 +42,11 @@ size_t test_actor_clock::dispatch() {
     return 0u;
   visitor f{this};
   auto result = schedule_.size();
-  for (auto& kvp : schedule_)
+  for (auto& kvp : schedule_) {
+    if (kvp.first > current_time)
+      current_time = kvp.first;
     visit(f, kvp.second);
+  }
   schedule_.clear();
   return result;
 }
@@ -0,0 +1,100 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/thread_parker.hpp"
+
+#ifdef CAF_LINUX
+#include <ctime>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+namespace caf {
+namespace detail {
+
+thread_parker::thread_parker() : parked_(false), seq_(0) {
+  // nop
+}
+
+#ifdef CAF_LINUX
+
+namespace {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "std::atomic<uint32_t> is not usable as futex word");
+
+inline uint32_t* futex_word(std::atomic<uint32_t>& x) {
+  return reinterpret_cast<uint32_t*>(&x);
+}
+
+} // namespace <anonymous>
+
+void thread_parker::unpark() {
+  seq_.fetch_add(1);
+  if (parked_)
+    syscall(SYS_futex, futex_word(seq_), FUTEX_WAKE_PRIVATE, 1,
+            nullptr, nullptr, 0);
+}
+
+bool thread_parker::wait(uint32_t x, const clock_type::time_point* timeout) {
+  if (timeout == nullptr) {
+    syscall(SYS_futex, futex_word(seq_), FUTEX_WAIT_PRIVATE, x,
+            nullptr, nullptr, 0);
+    return true;
+  }
+  // FUTEX_WAIT expects a relative timeout
+  auto now = clock_type::now();
+  if (now >= *timeout)
+    return false;
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(*timeout
+                                                                 - now);
+  timespec ts;
+  ts.tv_sec = static_cast<time_t>(ns.count() / 1000000000);
+  ts.tv_nsec = static_cast<long>(ns.count() % 1000000000);
+  auto res = syscall(SYS_futex, futex_word(seq_), FUTEX_WAIT_PRIVATE, x,
+                     &ts, nullptr, 0);
+  return res == 0 || errno != ETIMEDOUT;
+}
+
+#else // CAF_LINUX
+
+void thread_parker::unpark() {
+  seq_.fetch_add(1);
+  if (parked_) {
+    std::unique_lock<std::mutex> guard{mtx_};
+    cv_.notify_one();
+  }
+}
+
+bool thread_parker::wait(uint32_t x, const clock_type::time_point* timeout) {
+  std::unique_lock<std::mutex> guard{mtx_};
+  while (seq_ == x) {
+    if (timeout == nullptr)
+      cv_.wait(guard);
+    else if (cv_.wait_until(guard, *timeout) == std::cv_status::timeout)
+      return seq_ != x;
+  }
+  return true;
+}
+
+#endif // CAF_LINUX
+
+} // namespace detail
+} // namespace caf
@@ -0,0 +1,76 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/detail/tsc_clock.hpp"
+
+#include <thread>
+
+namespace caf {
+namespace detail {
+
+namespace {
+
+// minimum distance between the reference point and the second measurement
+constexpr auto calibration_interval = std::chrono::milliseconds(5);
+
+struct reference_point {
+  std::chrono::steady_clock::time_point time;
+  tsc_clock::rep ticks;
+};
+
+const reference_point& reference() {
+  static reference_point result{std::chrono::steady_clock::now(),
+                                tsc_clock::now()};
+  return result;
+}
+
+} // namespace <anonymous>
+
+double tsc_clock::ticks_per_ns() {
+# ifdef CAF_HAS_TSC
+  static double result = [] {
+    using namespace std::chrono;
+    auto& ref = reference();
+    auto elapsed = steady_clock::now() - ref.time;
+    if (elapsed < calibration_interval)
+      std::this_thread::sleep_for(calibration_interval - elapsed);
+    auto c1 = now();
+    auto t1 = steady_clock::now();
+    auto ns = duration_cast<nanoseconds>(t1 - ref.time).count();
+    return ns > 0 && c1 > ref.ticks
+           ? static_cast<double>(c1 - ref.ticks) / ns
+           : 1.;
+  }();
+  return result;
+# else
+  return 1.;
+# endif
+}
+
+void tsc_clock::calibrate() {
+  reference();
+}
+
+std::chrono::nanoseconds tsc_clock::to_duration(rep ticks) {
+  using rep_type = std::chrono::nanoseconds::rep;
+  return std::chrono::nanoseconds{
+    static_cast<rep_type>(static_cast<double>(ticks) / ticks_per_ns())};
+}
+
+} // namespace detail
+} // namespace caf
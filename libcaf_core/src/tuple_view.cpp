@@ -0,0 +1,180 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/tuple_view.hpp"
+
+#include <algorithm>
+
+#include "caf/config.hpp"
+#include "caf/message.hpp"
+
+namespace caf {
+
+constexpr size_t tuple_view::max_segments;
+
+// -- constructors, destructors, and assignment operators ----------------------
+
+tuple_view::tuple_view()
+    : num_segments_(0),
+      size_(0),
+      type_token_(0xFFFFFFFF) {
+  // nop
+}
+
+tuple_view::tuple_view(const type_erased_tuple& xs) : tuple_view() {
+  append(xs, 0, xs.size());
+}
+
+tuple_view::tuple_view(const message& xs) : tuple_view() {
+  if (!xs.empty())
+    append(*xs.cvals(), 0, xs.size());
+}
+
+tuple_view::~tuple_view() {
+  // nop
+}
+
+// -- overridden modifiers of type_erased_tuple --------------------------------
+
+void* tuple_view::get_mutable(size_t pos) {
+  auto x = select(pos);
+  return x.first->get_mutable(x.second);
+}
+
+error tuple_view::load(size_t pos, deserializer& source) {
+  auto x = select(pos);
+  return x.first->load(x.second, source);
+}
+
+// -- overridden observers of type_erased_tuple --------------------------------
+
+size_t tuple_view::size() const noexcept {
+  return size_;
+}
+
+uint32_t tuple_view::type_token() const noexcept {
+  return type_token_;
+}
+
+auto tuple_view::type(size_t pos) const noexcept -> rtti_pair {
+  auto x = select(pos);
+  return x.first->type(x.second);
+}
+
+const void* tuple_view::get(size_t pos) const noexcept {
+  auto x = select(pos);
+  return x.first->get(x.second);
+}
+
+std::string tuple_view::stringify(size_t pos) const {
+  auto x = select(pos);
+  return x.first->stringify(x.second);
+}
+
+type_erased_value_ptr tuple_view::copy(size_t pos) const {
+  auto x = select(pos);
+  return x.first->copy(x.second);
+}
+
+error tuple_view::save(size_t pos, serializer& sink) const {
+  auto x = select(pos);
+  return x.first->save(x.second, sink);
+}
+
+bool tuple_view::shared() const noexcept {
+  return true;
+}
+
+// -- views --------------------------------------------------------------------
+
+tuple_view tuple_view::slice(size_t pos, size_t n) const {
+  tuple_view result;
+  for (size_t i = 0; i < num_segments_ && n > 0; ++i) {
+    auto& x = segments_[i];
+    if (pos >= x.size) {
+      pos -= x.size;
+      continue;
+    }
+    auto len = std::min(x.size - pos, n);
+    result.append(*x.source, x.offset + pos, len);
+    n -= len;
+    pos = 0;
+  }
+  return result;
+}
+
+tuple_view tuple_view::drop(size_t n) const {
+  return n >= size_ ? tuple_view{} : slice(n, size_ - n);
+}
+
+tuple_view tuple_view::drop_right(size_t n) const {
+  return n >= size_ ? tuple_view{} : slice(0, size_ - n);
+}
+
+tuple_view operator+(const tuple_view& xs, const tuple_view& ys) {
+  auto result = xs;
+  for (size_t i = 0; i < ys.num_segments_; ++i) {
+    auto& y = ys.segments_[i];
+    result.append(*y.source, y.offset, y.size);
+  }
+  return result;
+}
+
+// -- observers ----------------------------------------------------------------
+
+message tuple_view::to_message() const {
+  return message::copy(*this);
+}
+
+// -- utility functions --------------------------------------------------------
+
+void tuple_view::append(const type_erased_tuple& xs, size_t offset,
+                        size_t n) {
+  CAF_ASSERT(offset + n <= xs.size());
+  if (n == 0)
+    return;
+  // check the segment limit before touching any state
+  segment* last = nullptr;
+  if (num_segments_ > 0) {
+    auto& x = segments_[num_segments_ - 1];
+    if (x.source == &xs && x.offset + x.size == offset)
+      last = &x;
+  }
+  if (last == nullptr && num_segments_ == max_segments)
+    CAF_RAISE_ERROR("tuple_view: too many segments");
+  for (size_t i = offset; i < offset + n; ++i)
+    type_token_ = (type_token_ << 6) | xs.type_nr(i);
+  size_ += n;
+  if (last != nullptr)
+    last->size += n;
+  else
+    segments_[num_segments_++] = segment{&xs, offset, n};
+}
+
+std::pair<type_erased_tuple*, size_t>
+tuple_view::select(size_t pos) const noexcept {
+  CAF_ASSERT(pos < size_);
+  for (size_t i = 0;; ++i) {
+    auto& x = segments_[i];
+    if (pos < x.size)
+      return {const_cast<type_erased_tuple*>(x.source), x.offset + pos};
+    pos -= x.size;
+  }
+}
+
+} // namespace caf
@@ -38,6 +38,10 @@ error type_erased_tuple::load(deserializer& source) {
   return none;
 }
 
+void* type_erased_tuple::native_tuple(const void*) noexcept {
+  return nullptr;
+}
+
 bool type_erased_tuple::shared() const noexcept {
   return false;
 }
@@ -99,17 +99,22 @@ namespace {
 using builtins = std::array<uniform_type_info_map::value_factory_kvp,
                             type_nrs - 1>;
 
-void fill_builtins(builtins&, detail::type_list<>, size_t) {
+using builtin_descriptors = std::array<const detail::value_descriptor*,
+                                       type_nrs - 1>;
+
+void fill_builtins(builtins&, builtin_descriptors&, detail::type_list<>,
+                   size_t) {
   // end of recursion
 }
 
 template <class List>
-void fill_builtins(builtins& arr, List, size_t pos) {
+void fill_builtins(builtins& arr, builtin_descriptors& ds, List, size_t pos) {
   using type = typename detail::tl_head<List>::type;
   typename detail::tl_tail<List>::type next;
   arr[pos].first = numbered_type_names[pos];
   arr[pos].second = &make_type_erased_value<type>;
-  fill_builtins(arr, next, pos + 1);
+  ds[pos] = detail::make_value_descriptor<type>();
+  fill_builtins(arr, ds, next, pos + 1);
 }
 
 } // namespace <anonymous>
@@ -134,6 +139,22 @@ uniform_type_info_map::make_value(const std::string& x) const {
   return nullptr;
 }
 
+const detail::value_descriptor*
+uniform_type_info_map::descriptor(const std::string& x) const {
+  auto pred = [&](const value_factory_kvp& kvp) {
+    return kvp.first == x;
+  };
+  auto e = builtin_.end();
+  auto i = std::find_if(builtin_.begin(), e, pred);
+  if (i != e)
+    return builtin_descriptors_[static_cast<size_t>(i - builtin_.begin())];
+  auto& custom_names = system().config().value_descriptors_by_name;
+  auto j = custom_names.find(x);
+  if (j != custom_names.end())
+    return j->second;
+  return nullptr;
+}
+
 type_erased_value_ptr
 uniform_type_info_map::make_value(const std::type_info& x) const {
   auto& custom_by_rtti = system().config().value_factories_by_rtti;
@@ -159,7 +180,7 @@ uniform_type_info_map::portable_name(uint16_t nr,
 
 uniform_type_info_map::uniform_type_info_map(actor_system& sys) : system_(sys) {
   sorted_builtin_types list;
-  fill_builtins(builtin_, list, 0);
+  fill_builtins(builtin_, builtin_descriptors_, list, 0);
   for (size_t i = 0; i < builtin_names_.size(); ++i)
     builtin_names_[i] = numbered_type_names[i];
 }
@@ -0,0 +1,78 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE ack_window
+#include "caf/test/unit_test.hpp"
+
+#include "caf/detail/ack_window.hpp"
+
+using caf::detail::ack_window;
+
+namespace {
+
+ack_window::time_point at(int x) {
+  return ack_window::time_point{std::chrono::milliseconds{x}};
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(cumulative_release) {
+  ack_window xs;
+  CAF_CHECK(xs.empty());
+  xs.push(5, at(1));
+  xs.push(3, at(2));
+  xs.push(4, at(3));
+  CAF_CHECK_EQUAL(xs.batches(), 3);
+  CAF_CHECK_EQUAL(xs.elements(), 12);
+  auto x = xs.release(1);
+  CAF_REQUIRE(x != nullptr);
+  CAF_CHECK(x->sent == at(2));
+  CAF_CHECK_EQUAL(xs.first_id(), 2);
+  CAF_CHECK_EQUAL(xs.batches(), 1);
+  CAF_CHECK_EQUAL(xs.elements(), 4);
+  CAF_MESSAGE("outdated and invalid IDs have no effect");
+  CAF_CHECK(xs.release(0) == nullptr);
+  CAF_CHECK(xs.release(3) == nullptr);
+  CAF_CHECK_EQUAL(xs.elements(), 4);
+  CAF_CHECK(xs.release(2) != nullptr);
+  CAF_CHECK(xs.empty());
+  CAF_CHECK_EQUAL(xs.elements(), 0);
+}
+
+CAF_TEST(growing) {
+  ack_window xs;
+  for (int i = 0; i < 3; ++i) {
+    xs.push(1, at(i));
+    xs.release(i);
+  }
+  // wraps around the ring buffer and forces it to grow
+  for (int i = 0; i < 20; ++i)
+    xs.push(i, at(100 + i));
+  CAF_CHECK_EQUAL(xs.first_id(), 3);
+  CAF_CHECK_EQUAL(xs.next_id(), 23);
+  CAF_CHECK_EQUAL(xs.elements(), 190);
+  for (int i = 0; i < 20; ++i) {
+    auto x = xs.release(3 + i);
+    CAF_REQUIRE(x != nullptr);
+    CAF_CHECK(x->sent == at(100 + i));
+    CAF_CHECK_EQUAL(xs.elements(), 190 - (i * (i + 1)) / 2);
+  }
+  CAF_CHECK(xs.empty());
+}
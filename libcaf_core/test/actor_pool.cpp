@@ -182,6 +182,75 @@ CAF_TEST(random_actor_pool) {
   self->send_exit(pool, exit_reason::user_shutdown);
 }
 
+CAF_TEST(join_shortest_queue_actor_pool) {
+  scoped_actor self{system};
+  auto pool = actor_pool::make(&context, 5, spawn_worker,
+                               actor_pool::join_shortest_queue());
+  for (int i = 0; i < 10; ++i) {
+    self->request(pool, infinite, i, i).receive(
+      [&](int res) {
+        CAF_CHECK_EQUAL(res, i + i);
+      },
+      handle_err
+    );
+  }
+  CAF_MESSAGE("dispatch to idle workers with growing mailboxes");
+  // scoped actors never process messages on their own, i.e., each message
+  // stays in the mailbox of the selected worker
+  scoped_actor w1{system};
+  scoped_actor w2{system};
+  scoped_actor w3{system};
+  auto idle_pool = actor_pool::make(&context,
+                                    actor_pool::join_shortest_queue());
+  for (auto w : {&w1, &w2, &w3})
+    self->send(idle_pool, sys_atom::value, put_atom::value,
+               actor_cast<actor>(*w));
+  for (int i = 0; i < 9; ++i)
+    self->send(idle_pool, i, i);
+  CAF_CHECK_EQUAL(w1->mailbox_size_estimate(), 3u);
+  CAF_CHECK_EQUAL(w2->mailbox_size_estimate(), 3u);
+  CAF_CHECK_EQUAL(w3->mailbox_size_estimate(), 3u);
+  CAF_MESSAGE("reading from a mailbox lowers its depth estimate");
+  w1->receive([](int, int) {});
+  CAF_CHECK_EQUAL(w1->mailbox_size_estimate(), 2u);
+  self->send(idle_pool, 1, 1);
+  CAF_CHECK_EQUAL(w1->mailbox_size_estimate(), 3u);
+  CAF_MESSAGE("only pool workers count their messages");
+  scoped_actor w4{system};
+  self->send(w4, 1, 1);
+  CAF_CHECK_EQUAL(w4->mailbox_size_estimate(), 0u);
+  self->send_exit(idle_pool, exit_reason::user_shutdown);
+  self->send_exit(pool, exit_reason::user_shutdown);
+}
+
+CAF_TEST(power_of_two_choices_actor_pool) {
+  scoped_actor self{system};
+  auto pool = actor_pool::make(&context, 5, spawn_worker,
+                               actor_pool::power_of_two_choices());
+  for (int i = 0; i < 10; ++i) {
+    self->request(pool, infinite, i, i).receive(
+      [&](int res) {
+        CAF_CHECK_EQUAL(res, i + i);
+      },
+      handle_err
+    );
+  }
+  CAF_MESSAGE("two workers always compare both mailboxes");
+  scoped_actor w1{system};
+  scoped_actor w2{system};
+  auto idle_pool = actor_pool::make(&context,
+                                    actor_pool::power_of_two_choices());
+  for (auto w : {&w1, &w2})
+    self->send(idle_pool, sys_atom::value, put_atom::value,
+               actor_cast<actor>(*w));
+  for (int i = 0; i < 8; ++i)
+    self->send(idle_pool, i, i);
+  CAF_CHECK_EQUAL(w1->mailbox_size_estimate(), 4u);
+  CAF_CHECK_EQUAL(w2->mailbox_size_estimate(), 4u);
+  self->send_exit(idle_pool, exit_reason::user_shutdown);
+  self->send_exit(pool, exit_reason::user_shutdown);
+}
+
 CAF_TEST(split_join_actor_pool) {
   auto spawn_split_worker = [&] {
     return system.spawn<lazy_init>([]() -> behavior {
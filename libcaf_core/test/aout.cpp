@@ -21,8 +21,18 @@
 #define CAF_SUITE aout
 #include "caf/test/unit_test.hpp"
 
+#include <cstdio>
+#include <thread>
+#include <fstream>
+
 #include "caf/all.hpp"
 
+#include "caf/detail/print_sink.hpp"
+
+#ifndef CAF_WINDOWS
+#include <unistd.h>
+#endif
+
 using namespace caf;
 
 using std::endl;
@@ -45,6 +55,21 @@ void chattier_actor(event_based_actor* self, const std::string& fn) {
   aout(self) << chattier_line << endl;
 }
 
+// prints `n` lines in pieces, spread over `n` messages
+behavior counting_actor(event_based_actor* self, int k, int n) {
+  self->send(self, 0);
+  return {
+    [=](int i) {
+      aout(self) << k << ":";
+      aout(self) << i << endl;
+      if (i + 1 < n)
+        self->send(self, i + 1);
+      else
+        self->quit();
+    }
+  };
+}
+
 struct fixture {
   fixture() : system(cfg) {
     // nop
@@ -102,4 +127,65 @@ CAF_TEST(global_and_local_redirect) {
   CAF_CHECK_EQUAL(self->mailbox().count(), 0u);
 }
 
+#ifndef CAF_WINDOWS
+
+CAF_TEST(line_order_per_actor) {
+  constexpr int num_actors = 20;
+  constexpr int num_lines = 50;
+  constexpr const char* fn = "caf-aout-test.txt";
+  // capture STDOUT in a file
+  std::fflush(stdout);
+  auto fd = dup(STDOUT_FILENO);
+  CAF_REQUIRE(std::freopen(fn, "w", stdout) != nullptr);
+  for (int k = 0; k < num_actors; ++k)
+    system.spawn(counting_actor, k, num_lines);
+  aout(self) << "main:" << 0 << endl;
+  self->await_all_other_actors_done();
+  std::fflush(stdout);
+  dup2(fd, STDOUT_FILENO);
+  close(fd);
+  std::vector<int> next(num_actors, 0);
+  std::ifstream in{fn};
+  std::string line;
+  size_t lines = 0;
+  while (std::getline(in, line)) {
+    ++lines;
+    if (line == "main:0")
+      continue;
+    auto pos = line.find(':');
+    CAF_REQUIRE_NOT_EQUAL(pos, std::string::npos);
+    auto k = std::stoi(line.substr(0, pos));
+    auto i = std::stoi(line.substr(pos + 1));
+    CAF_REQUIRE(k >= 0 && k < num_actors);
+    CAF_CHECK_EQUAL(i, next[k]);
+    next[k] = i + 1;
+  }
+  std::remove(fn);
+  CAF_CHECK_EQUAL(lines, static_cast<size_t>(num_actors * num_lines + 1));
+  CAF_CHECK_EQUAL(next, std::vector<int>(num_actors, num_lines));
+}
+
+CAF_TEST(flush_on_thread_exit) {
+  auto sink = system.scheduler().print_sink();
+  if (sink == nullptr) {
+    CAF_MESSAGE("no print sink available, skip test");
+    return;
+  }
+  constexpr const char* fn = "caf-aout-test.txt";
+  std::fflush(stdout);
+  auto fd = dup(STDOUT_FILENO);
+  CAF_REQUIRE(std::freopen(fn, "w", stdout) != nullptr);
+  auto aid = self->id();
+  std::thread{[=] { sink->write(aid, "thread:0\n"); }}.join();
+  std::fflush(stdout);
+  dup2(fd, STDOUT_FILENO);
+  close(fd);
+  std::ifstream in{fn};
+  std::string line;
+  CAF_CHECK(std::getline(in, line) && line == "thread:0");
+  std::remove(fn);
+}
+
+#endif // CAF_WINDOWS
+
 CAF_TEST_FIXTURE_SCOPE_END()
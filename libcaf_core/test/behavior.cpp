@@ -26,8 +26,11 @@
 
 #include "caf/behavior.hpp"
 #include "caf/message_handler.hpp"
+#include "caf/message_builder.hpp"
 #include "caf/make_type_erased_tuple_view.hpp"
 
+#include "caf/detail/type_list_id.hpp"
+
 using namespace caf;
 using namespace std;
 
@@ -94,4 +97,34 @@ CAF_TEST(multiple_lambda_construct) {
   CAF_CHECK_EQUAL(f(m3), none);
 }
 
+CAF_TEST(native_tuples) {
+  using detail::type_list_id;
+  auto& xs = *m2.vals();
+  CAF_CHECK_NOT_EQUAL(xs.native_tuple(type_list_id<int, int>::get()), nullptr);
+  CAF_CHECK_EQUAL(xs.native_tuple(type_list_id<int>::get()), nullptr);
+  CAF_CHECK_EQUAL(xs.native_tuple(type_list_id<int, double>::get()), nullptr);
+  CAF_MESSAGE("handlers accept native and dynamically built tuples alike");
+  auto dyn = message_builder{}.append(1).append(2).to_message();
+  CAF_CHECK_EQUAL(dyn.vals()->native_tuple(type_list_id<int, int>::get()),
+                  nullptr);
+  behavior f{
+    [](int x, int& y) {
+      y += 10;
+      return x + y;
+    },
+    [](hi_atom, int x) {
+      return x;
+    }
+  };
+  CAF_CHECK_EQUAL(to_string(f(m2)), "*(13)");
+  CAF_CHECK_EQUAL(m2.get_as<int>(1), 12);
+  CAF_CHECK_EQUAL(to_string(f(dyn)), "*(13)");
+  auto m4 = make_message(hi_atom::value, 7);
+  CAF_CHECK_EQUAL(to_string(f(m4)), "*(7)");
+  CAF_MESSAGE("manipulators do not modify shared tuples");
+  auto m2_copy = m2;
+  CAF_CHECK_EQUAL(to_string(f(m2_copy)), "*(23)");
+  CAF_CHECK_EQUAL(m2.get_as<int>(1), 12);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,153 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE block_cache
+#include "caf/test/dsl.hpp"
+
+#include <array>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "caf/detail/block_cache.hpp"
+#include "caf/detail/tuple_vals.hpp"
+
+using namespace caf;
+
+using caf::detail::block_cache;
+
+namespace {
+
+class dummy_actor : public event_based_actor {
+public:
+  dummy_actor(actor_config& cfg) : event_based_actor(cfg) {
+    // nop
+  }
+
+  behavior make_behavior() override {
+    return {
+      [](int x) {
+        return x;
+      }
+    };
+  }
+};
+
+struct block {
+  char data[128];
+};
+
+struct message_block {
+  char data[64];
+};
+
+using fixture = test_coordinator_fixture<>;
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(block_cache_tests, fixture)
+
+#ifndef CAF_NO_BLOCK_CACHE
+
+CAF_TEST(free_lists) {
+  auto& xs = block_cache::local<block>();
+  CAF_REQUIRE_EQUAL(xs.size, 0u);
+  auto ptr = block_cache::allocate(xs, sizeof(block));
+  block_cache::deallocate(xs, ptr);
+  CAF_CHECK_EQUAL(xs.size, 1u);
+  CAF_CHECK(xs.enrolled);
+  CAF_CHECK_EQUAL(block_cache::allocate(xs, sizeof(block)), ptr);
+  CAF_CHECK_EQUAL(xs.size, 0u);
+  block_cache::deallocate(xs, ptr);
+  CAF_MESSAGE("free lists hold at most max_blocks blocks");
+  std::vector<void*> ptrs;
+  for (size_t i = 0; i < block_cache::max_blocks + 10; ++i)
+    ptrs.push_back(block_cache::allocate(xs, sizeof(block)));
+  CAF_CHECK_EQUAL(xs.size, 0u);
+  for (auto x : ptrs)
+    block_cache::deallocate(xs, x);
+  CAF_CHECK_LESS_OR_EQUAL(xs.size, block_cache::max_blocks);
+  CAF_MESSAGE("surplus blocks move to the depot");
+  CAF_CHECK_EQUAL((*xs.shared)->size.load(), block_cache::batch_size);
+  CAF_CHECK_EQUAL(xs.size + (*xs.shared)->size.load(), ptrs.size());
+}
+
+CAF_TEST(cross_thread_reuse) {
+  // The main thread acts as producer, e.g., of messages, and allocates
+  // blocks that a consumer thread releases.
+  auto& xs = block_cache::local<message_block>();
+  std::vector<void*> ptrs;
+  for (size_t i = 0; i < 2 * block_cache::max_blocks; ++i)
+    ptrs.push_back(block_cache::allocate(xs, sizeof(message_block)));
+  std::thread consumer{[&] {
+    auto& ys = block_cache::local<message_block>();
+    for (auto x : ptrs)
+      block_cache::deallocate(ys, x);
+    // The consumer keeps a full list and moves the surplus to the depot.
+    CAF_CHECK_EQUAL(ys.size, block_cache::max_blocks);
+  }};
+  consumer.join();
+  CAF_REQUIRE_EQUAL((*xs.shared)->size.load(), block_cache::max_blocks);
+  CAF_MESSAGE("the producer picks up blocks released by the consumer");
+  std::vector<void*> reused;
+  for (size_t i = 0; i < block_cache::max_blocks; ++i) {
+    auto ptr = block_cache::allocate(xs, sizeof(message_block));
+    CAF_CHECK(std::find(ptrs.begin(), ptrs.end(), ptr) != ptrs.end());
+    reused.push_back(ptr);
+  }
+  CAF_CHECK_EQUAL((*xs.shared)->size.load(), 0u);
+  CAF_CHECK_EQUAL(xs.size, 0u);
+  for (auto x : reused)
+    block_cache::deallocate(xs, x);
+}
+
+CAF_TEST(spawning_reuses_storage) {
+  auto spawn_and_kill = [&] {
+    auto hdl = sys.spawn<dummy_actor>();
+    auto ptr = actor_cast<abstract_actor*>(hdl);
+    anon_send_exit(hdl, exit_reason::kill);
+    sched.run();
+    return ptr;
+  };
+  auto ptr = spawn_and_kill();
+  CAF_CHECK_EQUAL(spawn_and_kill(), ptr);
+}
+
+CAF_TEST(small_messages_reuse_storage) {
+  auto addr = [](const message& x) {
+    return static_cast<const void*>(x.cvals().get());
+  };
+  const void* ptr;
+  {
+    auto x = make_message(1, 2.0);
+    ptr = addr(x);
+  }
+  CAF_CHECK_EQUAL(addr(make_message(3, 4.0)), ptr);
+  CAF_MESSAGE("non-scalar values use the default allocator");
+  CAF_CHECK(!detail::is_small_message<std::string>::value);
+  CAF_MESSAGE("messages exceeding CAF_SMALL_MESSAGE_SIZE bytes are not cached");
+  using big = std::array<char, CAF_SMALL_MESSAGE_SIZE + 1>;
+  CAF_CHECK(!detail::is_small_message<big>::value);
+}
+
+#endif // CAF_NO_BLOCK_CACHE
+
+CAF_TEST_FIXTURE_SCOPE_END()
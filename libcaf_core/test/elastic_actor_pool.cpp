@@ -0,0 +1,172 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE elastic_actor_pool
+#include "caf/test/dsl.hpp"
+
+#include <chrono>
+#include <vector>
+
+using namespace caf;
+
+using std::chrono::milliseconds;
+
+namespace {
+
+behavior dummy_worker() {
+  return {
+    [](int) {
+      // nop
+    }
+  };
+}
+
+struct fixture : test_coordinator_fixture<> {
+  scoped_execution_unit context;
+  actor_pool::elasticity cfg;
+  actor pool;
+
+  fixture() : context(&sys) {
+    cfg.min_workers = 1;
+    cfg.max_workers = 3;
+    cfg.grow_threshold = 2;
+    cfg.shrink_threshold = 0;
+    cfg.max_latency = std::chrono::hours(1);
+    cfg.interval = milliseconds(10);
+    cfg.shrink_delay = milliseconds(100);
+  }
+
+  ~fixture() {
+    anon_send_exit(pool, exit_reason::user_shutdown);
+    sched.run();
+  }
+
+  void make_pool() {
+    auto fac = [&] {
+      return sys.spawn(dummy_worker);
+    };
+    auto res = actor_pool::make(&context, cfg, fac, actor_pool::round_robin());
+    CAF_REQUIRE(res);
+    pool = std::move(*res);
+  }
+
+  size_t num_workers() {
+    size_t result = 0;
+    self->request(pool, infinite, sys_atom::value, get_atom::value).receive(
+      [&](const std::vector<actor>& xs) {
+        result = xs.size();
+      },
+      [&](const error& err) {
+        CAF_FAIL("pool responded with an error: " << sys.render(err));
+      }
+    );
+    return result;
+  }
+
+  /// Advances the clock by `x` and sends a message to the pool, allowing it
+  /// to take a new sample.
+  void tick(milliseconds x = milliseconds(10)) {
+    sched.clock().current_time += x;
+    anon_send(pool, 1);
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(elastic_actor_pool_tests, fixture)
+
+CAF_TEST(invalid_config) {
+  auto fac = [&] {
+    return sys.spawn(dummy_worker);
+  };
+  auto make = [&] {
+    return actor_pool::make(&context, cfg, fac, actor_pool::round_robin());
+  };
+  cfg.min_workers = 0;
+  CAF_CHECK_EQUAL(make().error(), sec::invalid_argument);
+  cfg.min_workers = 4;
+  CAF_CHECK_EQUAL(make().error(), sec::invalid_argument);
+  cfg.min_workers = 1;
+  cfg.shrink_threshold = cfg.grow_threshold;
+  CAF_CHECK_EQUAL(make().error(), sec::invalid_argument);
+}
+
+CAF_TEST(grow_with_queue_depth) {
+  make_pool();
+  CAF_CHECK_EQUAL(num_workers(), 1u);
+  for (int i = 0; i < 5; ++i)
+    anon_send(pool, i);
+  CAF_MESSAGE("the pool only resizes after each interval");
+  CAF_CHECK_EQUAL(num_workers(), 1u);
+  tick();
+  CAF_CHECK_EQUAL(num_workers(), 2u);
+  tick();
+  CAF_CHECK_EQUAL(num_workers(), 3u);
+  CAF_MESSAGE("the pool never exceeds max_workers");
+  tick();
+  CAF_CHECK_EQUAL(num_workers(), 3u);
+  sched.run();
+}
+
+CAF_TEST(shrink_with_hysteresis) {
+  make_pool();
+  for (int i = 0; i < 10; ++i)
+    anon_send(pool, i);
+  tick();
+  tick();
+  CAF_REQUIRE_EQUAL(num_workers(), 3u);
+  sched.run();
+  CAF_MESSAGE("the pool retires workers only after shrink_delay");
+  tick();
+  sched.run();
+  CAF_CHECK_EQUAL(num_workers(), 3u);
+  tick(milliseconds(50));
+  sched.run();
+  CAF_CHECK_EQUAL(num_workers(), 3u);
+  tick(milliseconds(50));
+  sched.run();
+  CAF_CHECK_EQUAL(num_workers(), 2u);
+  CAF_MESSAGE("each retirement restarts the delay");
+  tick();
+  sched.run();
+  CAF_CHECK_EQUAL(num_workers(), 2u);
+  tick(milliseconds(100));
+  sched.run();
+  CAF_CHECK_EQUAL(num_workers(), 1u);
+  CAF_MESSAGE("the pool never drops below min_workers");
+  tick(milliseconds(100));
+  sched.run();
+  CAF_CHECK_EQUAL(num_workers(), 1u);
+}
+
+CAF_TEST(grow_with_latency) {
+  cfg.grow_threshold = 10;
+  cfg.max_latency = milliseconds(50);
+  make_pool();
+  anon_send(pool, 1);
+  tick();
+  CAF_CHECK_EQUAL(num_workers(), 1u);
+  CAF_MESSAGE("a worker without progress for max_latency triggers growth");
+  tick(milliseconds(60));
+  CAF_CHECK_EQUAL(num_workers(), 2u);
+  sched.run();
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,133 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE forwarding_stack
+#include "caf/test/unit_test.hpp"
+
+#include <vector>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/forwarding_stack.hpp"
+
+using std::vector;
+
+using namespace caf;
+
+using caf::detail::forwarding_stack;
+
+namespace {
+
+behavior dummy() {
+  return {
+    [](int) {
+      // nop
+    }
+  };
+}
+
+struct fixture {
+  fixture() : sys(cfg) {
+    for (int i = 0; i < 4; ++i)
+      xs.emplace_back(actor_cast<strong_actor_ptr>(sys.spawn(dummy)));
+  }
+
+  ~fixture() {
+    for (auto& x : xs)
+      anon_send_exit(actor_cast<actor>(x), exit_reason::kill);
+  }
+
+  actor_system_config cfg;
+  actor_system sys;
+  vector<strong_actor_ptr> xs;
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(forwarding_stack_tests, fixture)
+
+CAF_TEST(compact_layout) {
+  CAF_CHECK_LESS(sizeof(forwarding_stack), sizeof(vector<strong_actor_ptr>));
+  CAF_CHECK_EQUAL(sizeof(mailbox_element), 8 * sizeof(void*));
+}
+
+CAF_TEST(inline_storage) {
+  forwarding_stack s;
+  CAF_CHECK(s.empty());
+  CAF_CHECK(s.is_inline());
+  s.push_back(xs[0]);
+  CAF_CHECK(s.is_inline());
+  CAF_CHECK_EQUAL(s.size(), 1u);
+  CAF_CHECK_EQUAL(s.back(), xs[0]);
+  s.pop_back();
+  CAF_CHECK(s.empty());
+  CAF_CHECK(s.is_inline());
+}
+
+CAF_TEST(heap_storage) {
+  forwarding_stack s;
+  for (auto& x : xs)
+    s.push_back(x);
+  CAF_CHECK(!s.is_inline());
+  CAF_CHECK_EQUAL(s.size(), xs.size());
+  CAF_CHECK(std::equal(s.begin(), s.end(), xs.begin()));
+  CAF_MESSAGE("copies share elements and moves transfer the heap storage");
+  auto t = s;
+  CAF_CHECK_EQUAL(t, s);
+  auto u = std::move(s);
+  CAF_CHECK(s.empty());
+  CAF_CHECK(s.is_inline());
+  CAF_CHECK_EQUAL(u, t);
+  CAF_MESSAGE("pop elements in reverse order");
+  for (auto i = xs.rbegin(); i != xs.rend(); ++i) {
+    CAF_CHECK_EQUAL(u.back(), *i);
+    u.pop_back();
+  }
+  CAF_CHECK(u.empty());
+}
+
+CAF_TEST(insert) {
+  forwarding_stack s{xs[0], xs[2]};
+  auto i = s.insert(s.begin() + 1, xs[1]);
+  CAF_CHECK_EQUAL(*i, xs[1]);
+  s.insert(s.end(), xs[3]);
+  CAF_CHECK_EQUAL(s, forwarding_stack(xs));
+}
+
+CAF_TEST(serialization) {
+  forwarding_stack s{xs[0], xs[1]};
+  std::vector<char> buf1;
+  std::vector<char> buf2;
+  binary_serializer sink1{sys, buf1};
+  binary_serializer sink2{sys, buf2};
+  auto e1 = sink1(s);
+  vector<strong_actor_ptr> v{xs[0], xs[1]};
+  auto e2 = sink2(v);
+  CAF_REQUIRE(!e1 && !e2);
+  CAF_MESSAGE("forwarding stacks use the same format as vectors");
+  CAF_CHECK_EQUAL(buf1, buf2);
+  forwarding_stack t;
+  binary_deserializer source{sys, buf1};
+  auto e3 = source(t);
+  CAF_REQUIRE(!e3);
+  CAF_CHECK_EQUAL(s, t);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
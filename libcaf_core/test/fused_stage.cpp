@@ -0,0 +1,88 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE fused_stage
+#include "caf/test/unit_test.hpp"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "caf/fused_stage.hpp"
+#include "caf/stream_stage_trait.hpp"
+
+using std::deque;
+using std::string;
+using std::vector;
+
+using namespace caf;
+using namespace caf::stream_ops;
+
+namespace {
+
+template <class F, class T>
+deque<typename F::output_type> process(F& f, vector<vector<T>> batches) {
+  unit_t dummy;
+  deque<typename F::output_type> buf;
+  downstream<typename F::output_type> out{buf};
+  for (auto& batch : batches) {
+    for (auto& x : batch)
+      f(dummy, out, x);
+    f.end_batch(dummy, out);
+  }
+  return buf;
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(stage_signature) {
+  auto f = fuse<int>(map([](int x) { return std::to_string(x); }));
+  using trait = stream_stage_trait_t<decltype(f)>;
+  CAF_CHECK((std::is_same<trait::input, int>::value));
+  CAF_CHECK((std::is_same<trait::output, string>::value));
+  CAF_CHECK((std::is_same<trait::state, unit_t>::value));
+}
+
+CAF_TEST(map_and_filter) {
+  auto f = fuse<int>(filter([](int x) { return x % 2 == 0; }),
+                     map([](int x) { return std::to_string(x); }));
+  CAF_CHECK_EQUAL(process(f, vector<vector<int>>{{1, 2, 3, 4}, {5, 6}}),
+                  deque<string>({"2", "4", "6"}));
+}
+
+CAF_TEST(flat_map) {
+  auto f = fuse<int>(flat_map([](int x) { return vector<int>(x, x); }));
+  CAF_CHECK_EQUAL(process(f, vector<vector<int>>{{1, 0, 3}}),
+                  deque<int>({1, 3, 3, 3}));
+}
+
+CAF_TEST(take_while) {
+  auto f = fuse<int>(take_while([](int x) { return x < 3; }));
+  CAF_CHECK_EQUAL(process(f, vector<vector<int>>{{1, 2, 3}, {1, 2}}),
+                  deque<int>({1, 2}));
+}
+
+CAF_TEST(reduce) {
+  auto f = fuse<int>(map([](int x) { return x * 10; }),
+                     reduce(0, [](int& x, int y) { x += y; }),
+                     map([](int x) { return x + 1; }));
+  CAF_CHECK_EQUAL(process(f, vector<vector<int>>{{1, 2}, {}, {3}}),
+                  deque<int>({31, 31}));
+}
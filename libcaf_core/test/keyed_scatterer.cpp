@@ -0,0 +1,192 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include <map>
+#include <vector>
+
+#define CAF_SUITE keyed_scatterer
+#include "caf/test/dsl.hpp"
+
+#include "caf/keyed_scatterer.hpp"
+
+using std::map;
+using std::vector;
+
+using namespace caf;
+
+namespace {
+
+struct key_fn {
+  int operator()(const int& x) const {
+    return x % 10;
+  }
+};
+
+using scatterer = keyed_scatterer<int, key_fn>;
+
+struct fixture : test_coordinator_fixture<> {
+  scatterer out;
+  stream_id sid;
+
+  fixture() : out(self.ptr()) {
+    sid = stream_id{self->ctrl(), 1};
+  }
+
+  ~fixture() {
+    out.close();
+  }
+
+  void add(scoped_actor& sink, long credit) {
+    auto hdl = actor_cast<strong_actor_ptr>(sink);
+    out.add_path(sid, nullptr, hdl, no_stages, make_message_id(),
+                 make_message(), stream_priority::normal, false);
+    sink->receive([](const stream_msg& x) {
+      CAF_REQUIRE(holds_alternative<stream_msg::open>(x.content));
+    });
+    out.confirm_path(sid, sink->address(), hdl, credit, false);
+  }
+
+  void remove(scoped_actor& sink) {
+    out.remove_path(sid, sink->address(), none, true);
+  }
+
+  void push(int first, int last) {
+    for (auto i = first; i < last; ++i)
+      out.push(i);
+    out.emit_batches();
+  }
+
+  /// Drains all batches from the mailbox of `sink` and returns their content.
+  vector<int> received(scoped_actor& sink) {
+    vector<int> result;
+    while (!sink->mailbox().empty())
+      sink->receive([&](const stream_msg& x) {
+        auto& xs = get<stream_msg::batch>(x.content).xs;
+        auto& ys = xs.get_as<vector<int>>(0);
+        result.insert(result.end(), ys.begin(), ys.end());
+      });
+    return result;
+  }
+
+  /// Adds all keys in `xs` to `owners` and checks that `id` owns them.
+  void check_owner(map<int, int>& owners, int id, const vector<int>& xs) {
+    for (auto x : xs) {
+      auto i = owners.emplace(x % 10, id).first;
+      CAF_CHECK_EQUAL(i->second, id);
+    }
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(keyed_scatterer_tests, fixture)
+
+CAF_TEST(partitioning) {
+  scoped_actor s1{sys};
+  scoped_actor s2{sys};
+  add(s1, 100);
+  add(s2, 100);
+  push(0, 100);
+  auto xs1 = received(s1);
+  auto xs2 = received(s2);
+  CAF_CHECK_EQUAL(xs1.size() + xs2.size(), 100u);
+  CAF_CHECK(std::is_sorted(xs1.begin(), xs1.end()));
+  CAF_CHECK(std::is_sorted(xs2.begin(), xs2.end()));
+  map<int, int> owners;
+  check_owner(owners, 1, xs1);
+  check_owner(owners, 2, xs2);
+  CAF_MESSAGE("keys stay on their path for subsequent batches");
+  push(100, 200);
+  check_owner(owners, 1, received(s1));
+  check_owner(owners, 2, received(s2));
+}
+
+CAF_TEST(credit) {
+  scoped_actor s1{sys};
+  add(s1, 5);
+  push(0, 20);
+  CAF_CHECK_EQUAL(received(s1), vector<int>({0, 1, 2, 3, 4}));
+  CAF_CHECK_EQUAL(out.buffered(), 15);
+  out.path_at(0)->open_credit += 10;
+  out.emit_batches();
+  CAF_CHECK_EQUAL(received(s1).size(), 10u);
+  CAF_CHECK_EQUAL(out.buffered(), 5);
+}
+
+CAF_TEST(hot_key) {
+  scoped_actor s1{sys};
+  scoped_actor s2{sys};
+  add(s1, 10);
+  add(s2, 10);
+  auto initial_credit = out.credit();
+  CAF_CHECK_EQUAL(initial_credit, 20 + out.min_buffer_size());
+  CAF_MESSAGE("elements of a single key congest only one lane");
+  for (int i = 0; i < 30; ++i)
+    out.push(i * 10);
+  out.emit_batches();
+  auto xs1 = received(s1);
+  auto xs2 = received(s2);
+  CAF_CHECK_EQUAL(xs1.size() + xs2.size(), 10u);
+  CAF_CHECK_EQUAL(out.buffered(), 20);
+  CAF_MESSAGE("the congested lane reduces the credit for upstream");
+  CAF_CHECK_EQUAL(out.credit(), 10 + out.min_buffer_size() - 20);
+  CAF_MESSAGE("credit recovers once the congested path drains its lane");
+  for (size_t i = 0; i < 2; ++i)
+    out.path_at(i)->open_credit += 20;
+  out.emit_batches();
+  CAF_CHECK_EQUAL(out.buffered(), 0);
+  CAF_CHECK_EQUAL(out.credit(), out.total_credit() + out.min_buffer_size());
+}
+
+CAF_TEST(rebalancing) {
+  scoped_actor s1{sys};
+  scoped_actor s2{sys};
+  scoped_actor s3{sys};
+  add(s1, 10);
+  add(s2, 10);
+  push(0, 100);
+  map<int, int> owners;
+  check_owner(owners, 1, received(s1));
+  check_owner(owners, 2, received(s2));
+  CAF_MESSAGE("a new path only takes over keys from existing paths");
+  add(s3, 100);
+  out.path_at(0)->open_credit += 100;
+  out.path_at(1)->open_credit += 100;
+  out.emit_batches();
+  CAF_CHECK_EQUAL(out.buffered(), 0);
+  auto xs3 = received(s3);
+  auto moved = owners;
+  for (auto x : xs3)
+    moved[x % 10] = 3;
+  check_owner(moved, 1, received(s1));
+  check_owner(moved, 2, received(s2));
+  check_owner(moved, 3, xs3);
+  CAF_MESSAGE("removing a path re-assigns its pending elements");
+  for (size_t i = 0; i < 3; ++i)
+    out.path_at(i)->open_credit = 0;
+  push(100, 200);
+  CAF_CHECK_EQUAL(out.buffered(), 100);
+  remove(s3);
+  out.path_at(0)->open_credit = 100;
+  out.path_at(1)->open_credit = 100;
+  out.emit_batches();
+  CAF_CHECK_EQUAL(out.buffered(), 0);
+  CAF_CHECK_EQUAL(received(s1).size() + received(s2).size(), 100u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
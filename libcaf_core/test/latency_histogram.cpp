@@ -0,0 +1,84 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE latency_histogram
+#include "caf/test/unit_test.hpp"
+
+#include "caf/latency_histogram.hpp"
+
+using namespace caf;
+
+using ns = std::chrono::nanoseconds;
+
+CAF_TEST(empty) {
+  latency_histogram x;
+  CAF_CHECK_EQUAL(x.count(), 0u);
+  CAF_CHECK(x.min() == ns{0});
+  CAF_CHECK(x.max() == ns{0});
+  CAF_CHECK(x.mean() == ns{0});
+  CAF_CHECK(x.percentile(0.5) == ns{0});
+}
+
+CAF_TEST(buckets) {
+  latency_histogram x;
+  x.record(ns{0});
+  x.record(ns{1});
+  x.record(ns{2});
+  x.record(ns{3});
+  x.record(ns{1000});
+  x.record(ns{-5});
+  CAF_CHECK_EQUAL(x.count(), 6u);
+  CAF_CHECK_EQUAL(x.buckets()[0], 2u);
+  CAF_CHECK_EQUAL(x.buckets()[1], 1u);
+  CAF_CHECK_EQUAL(x.buckets()[2], 2u);
+  CAF_CHECK_EQUAL(x.buckets()[10], 1u);
+  CAF_CHECK(x.min() == ns{0});
+  CAF_CHECK(x.max() == ns{1000});
+  CAF_CHECK(x.mean() == ns{1006 / 6});
+}
+
+CAF_TEST(percentiles) {
+  latency_histogram x;
+  for (int i = 0; i < 99; ++i)
+    x.record(ns{100});
+  x.record(ns{100000});
+  // 100ns falls into bucket [64, 128)
+  CAF_CHECK(x.percentile(0.5) == ns{127});
+  CAF_CHECK(x.percentile(0.99) == ns{127});
+  // the upper bound of the last bucket never exceeds the maximum
+  CAF_CHECK(x.percentile(1.0) == ns{100000});
+}
+
+CAF_TEST(merge_and_reset) {
+  latency_histogram x;
+  latency_histogram y;
+  x.record(ns{10});
+  y.record(ns{20});
+  y.record(ns{30});
+  x.merge(y);
+  CAF_CHECK_EQUAL(x.count(), 3u);
+  CAF_CHECK(x.min() == ns{10});
+  CAF_CHECK(x.max() == ns{30});
+  CAF_CHECK(x.mean() == ns{20});
+  x.reset();
+  CAF_CHECK_EQUAL(x.count(), 0u);
+  CAF_CHECK_EQUAL(to_string(x), "latency_histogram(count = 0, min = 0ns, "
+                                "mean = 0ns, p50 = 0ns, p99 = 0ns, max = 0ns)");
+}
@@ -23,6 +23,7 @@
 
 #include <array>
 #include <chrono>
+#include <thread>
 #include <algorithm>
 
 #include "caf/all.hpp"
@@ -86,5 +87,38 @@ CAF_TEST(class_based_joined_at_spawn) {
     self->send_exit(x, exit_reason::user_shutdown);
 }
 
+CAF_TEST(publish_during_churn) {
+  auto grp = system.groups().get_local("churn");
+  std::array<actor, 10> xs;
+  for (auto& x : xs)
+    x = system.spawn_in_group(grp, testee_impl);
+  std::array<actor, 10> ys;
+  for (auto& y : ys)
+    y = system.spawn(testee_impl);
+  // subscribe and unsubscribe while publishing
+  size_t joined = 0;
+  std::thread churn{[&] {
+    for (int i = 0; i < 100; ++i)
+      for (auto& y : ys) {
+        auto ptr = actor_cast<strong_actor_ptr>(y);
+        if (grp.subscribe(ptr) && !grp.subscribe(ptr))
+          ++joined;
+        grp.unsubscribe(ptr.get());
+      }
+  }};
+  for (int i = 1; i <= 100; ++i)
+    self->send(grp, put_atom::value, i);
+  churn.join();
+  CAF_CHECK_EQUAL(joined, 1000u);
+  for (auto& x : xs) {
+    auto f = make_function_view(actor_cast<testee_if>(x));
+    CAF_CHECK_EQUAL(f(get_atom::value), 100);
+  }
+  for (auto& x : xs)
+    self->send_exit(x, exit_reason::user_shutdown);
+  for (auto& y : ys)
+    self->send_exit(y, exit_reason::user_shutdown);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
 
@@ -23,6 +23,7 @@
 
 #include <ctime>
 #include <string>
+#include <thread>
 
 #include "caf/all.hpp"
 
@@ -133,4 +134,126 @@ CAF_TEST(rendering) {
                   "unit.test WARN actor0 ns.foo bar foo.cpp:42 hello world");
 }
 
+CAF_TEST(binary_payload) {
+  auto x = 42;
+  auto y = string{"foo"};
+  auto z = vector<int>{1, 2};
+  auto check = [&](logger::line_builder lb, logger::record_builder& rb) {
+    auto expected = lb.get();
+    string result;
+    auto& buf = rb.get();
+    CAF_REQUIRE(detail::render_log_payload(result, buf.data(), buf.size()));
+    CAF_CHECK_EQUAL(result, expected);
+  };
+  { // scope for the thread-local record buffer
+    logger::record_builder rb;
+    rb << "ENTRY" << CAF_ARG(x) << CAF_ARG(y) << CAF_ARG(z);
+    check(logger::line_builder{} << "ENTRY" << CAF_ARG(x) << CAF_ARG(y)
+                                 << CAF_ARG(z), rb);
+  }
+  {
+    logger::record_builder rb;
+    rb << y << 1.5 << true << -7 << atom("ok") << CAF_ARG2("n", 7u);
+    check(logger::line_builder{} << y << 1.5 << true << -7 << atom("ok")
+                                 << CAF_ARG2("n", 7u), rb);
+  }
+  CAF_MESSAGE("common CAF types are stored in raw form");
+  actor_system sys{cfg};
+  scoped_actor self{sys};
+  auto addr = self->address();
+  auto ptr = actor_cast<strong_actor_ptr>(self);
+  auto hdl = actor_cast<actor>(self);
+  auto null_ptr = strong_actor_ptr{};
+  auto timeout = caf::duration{time_unit::milliseconds, 5};
+  auto mid = make_message_id(42);
+  {
+    logger::record_builder rb;
+    rb << atom("ok");
+    CAF_CHECK_EQUAL(rb.get()[1], static_cast<char>(detail::atom_raw_value));
+  }
+  {
+    logger::record_builder rb;
+    rb << CAF_ARG(addr) << CAF_ARG(ptr) << CAF_ARG(hdl) << CAF_ARG(null_ptr)
+       << CAF_ARG(timeout) << caf::duration{} << CAF_ARG(mid);
+    check(logger::line_builder{} << CAF_ARG(addr) << CAF_ARG(ptr)
+                                 << CAF_ARG(hdl) << CAF_ARG(null_ptr)
+                                 << CAF_ARG(timeout) << caf::duration{}
+                                 << CAF_ARG(mid), rb);
+  }
+}
+
+CAF_TEST(binary_rendering) {
+  std::stringstream buf;
+  detail::write_log_header(buf, 0);
+  detail::write_log_site(buf, 7, CAF_LOG_LEVEL_WARNING, "unit.test",
+                         "void ns::foo::bar()", "foo.cpp", 42);
+  detail::write_log_thread(buf, 1, "thread1");
+  detail::write_log_thread(buf, 2, "thread2");
+  auto write = [&](uint32_t thread, uint64_t aid, int64_t ms, string msg) {
+    logger::record_builder rb;
+    rb << msg;
+    detail::log_record header;
+    header.site = 7;
+    header.thread = thread;
+    header.aid = aid;
+    header.tstamp = ms * 1000000;
+    vector<detail::log_record> xs;
+    xs.resize(detail::log_record_count(rb.get().size()));
+    size_t i = 0;
+    detail::split_log_payload(header, rb.get(), [&]() -> detail::log_record& {
+      return xs[i++];
+    });
+    return xs;
+  };
+  auto long_msg = string(300, 'x');
+  auto xs = write(1, 10, 5, long_msg);
+  CAF_REQUIRE_EQUAL(xs.size(), 4u);
+  auto ys = write(2, 0, 3, "hello world");
+  CAF_REQUIRE_EQUAL(ys.size(), 1u);
+  // interleave the records of both threads
+  detail::write_log_record(buf, xs[0]);
+  detail::write_log_record(buf, ys[0]);
+  for (size_t i = 1; i < xs.size(); ++i)
+    detail::write_log_record(buf, xs[i]);
+  std::ostringstream out;
+  auto lf = logger::parse_format("%r %c %p %a %t %C %M %F:%L %m%n");
+  CAF_REQUIRE(logger::render_binary(buf, out, lf));
+  CAF_CHECK_EQUAL(out.str(),
+                  "3 unit.test WARN actor0 thread2 ns.foo bar foo.cpp:42 "
+                  "hello world\n"
+                  "5 unit.test WARN actor10 thread1 ns.foo bar foo.cpp:42 "
+                  + long_msg + "\n");
+  CAF_MESSAGE("render_binary rejects text logs");
+  std::istringstream text{"0 caf INFO actor0 ..."};
+  CAF_CHECK(!logger::render_binary(text, out, lf));
+}
+
+CAF_TEST(thread_local_aids) {
+  actor_system sys{cfg};
+  auto& lg = sys.logger();
+  auto contains = [](thread::id tid, actor_id aid) {
+    auto xs = logger::thread_aids();
+    return find(xs.begin(), xs.end(), make_pair(tid, aid)) != xs.end();
+  };
+  auto prev = lg.thread_local_aid(42);
+  CAF_CHECK_EQUAL(lg.thread_local_aid(), 42u);
+  CAF_CHECK(contains(this_thread::get_id(), 42));
+  thread::id tid;
+  vector<actor_id> aids;
+  bool registered = false;
+  thread t{[&] {
+    tid = this_thread::get_id();
+    aids.push_back(lg.thread_local_aid());
+    aids.push_back(lg.thread_local_aid(7));
+    aids.push_back(lg.thread_local_aid());
+    registered = contains(tid, 7);
+  }};
+  t.join();
+  CAF_CHECK_EQUAL(aids, vector<actor_id>({0, 0, 7}));
+  CAF_CHECK(registered);
+  CAF_MESSAGE("terminated threads no longer show up in the registry");
+  CAF_CHECK(!contains(tid, 7));
+  CAF_CHECK_EQUAL(lg.thread_local_aid(prev), 42u);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -185,6 +185,40 @@ CAF_TEST(concat) {
   CAF_CHECK_EQUAL(to_string(message::concat(m3, message{}, m1, m2)), to_string(m4));
 }
 
+CAF_TEST(message_builder) {
+  message_builder mb;
+  for (int i = 0; i < 20; ++i)
+    mb.append(std::to_string(i)).append(i);
+  mb.append(std::vector<int>{1, 2, 3});
+  CAF_CHECK_EQUAL(mb.size(), 41u);
+  auto m1 = mb.to_message();
+  CAF_MESSAGE("values survive reallocating the memory block");
+  CAF_REQUIRE_EQUAL(m1.size(), 41u);
+  for (size_t i = 0; i < 40; i += 2) {
+    CAF_CHECK_EQUAL(m1.get_as<string>(i), std::to_string(i / 2));
+    CAF_CHECK_EQUAL(m1.get_as<int>(i + 1), static_cast<int>(i / 2));
+  }
+  CAF_CHECK_EQUAL(m1.get_as<vector<int>>(40), vector<int>({1, 2, 3}));
+  CAF_MESSAGE("the builder detaches its data before modifying it");
+  mb.append("tail");
+  CAF_CHECK_EQUAL(m1.size(), 41u);
+  auto m2 = mb.move_to_message();
+  CAF_REQUIRE_EQUAL(m2.size(), 42u);
+  CAF_CHECK_EQUAL(m2.get_as<string>(0), "0");
+  CAF_CHECK_EQUAL(m2.get_as<string>(41), "tail");
+  CAF_MESSAGE("messages copy all values on write");
+  auto m3 = m2;
+  m3.get_mutable_as<string>(0) = "zero";
+  CAF_CHECK_EQUAL(m2.get_as<string>(0), "0");
+  CAF_CHECK_EQUAL(m3.get_as<string>(0), "zero");
+  CAF_CHECK_EQUAL(m3.get_as<string>(41), "tail");
+  CAF_MESSAGE("copies of type-erased tuples box each value");
+  auto m4 = message::copy(m3.content());
+  CAF_CHECK_EQUAL(to_string(m4), to_string(m3));
+  CAF_CHECK(m4.match_elements<string, int>() == false);
+  CAF_CHECK_EQUAL(m4.type_token(), m3.type_token());
+}
+
 namespace {
 
 struct s1 {
@@ -0,0 +1,179 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE metrics_registry
+#include "caf/test/dsl.hpp"
+
+#include <string>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/tsc_clock.hpp"
+
+using namespace caf;
+
+using ns = std::chrono::nanoseconds;
+
+namespace {
+
+behavior counter(event_based_actor*) {
+  auto n = std::make_shared<int>(0);
+  return {
+    [=](int x) {
+      *n += x;
+      return *n;
+    }
+  };
+}
+
+class instrumented_counter : public event_based_actor {
+public:
+  instrumented_counter(actor_config& cfg)
+      : event_based_actor(cfg.add_flag(is_instrumented_flag)) {
+    // nop
+  }
+
+  const char* name() const override {
+    return "instrumented_counter";
+  }
+
+  behavior make_behavior() override {
+    return counter(this);
+  }
+};
+
+using fixture = test_coordinator_fixture<>;
+
+} // namespace <anonymous>
+
+CAF_TEST(tsc_clock) {
+  using detail::tsc_clock;
+  CAF_CHECK(tsc_clock::ticks_per_ns() > 0.);
+  auto t0 = tsc_clock::now();
+  auto x = tsc_clock::stamp();
+  CAF_CHECK(tsc_clock::now() >= t0);
+  CAF_CHECK(tsc_clock::since(x) >= ns{0});
+  CAF_CHECK(tsc_clock::since(x) < std::chrono::seconds(1));
+}
+
+CAF_TEST_FIXTURE_SCOPE(metrics_registry_tests, fixture)
+
+CAF_TEST(spawn_option) {
+  auto plain = sys.spawn(counter);
+  auto testee = sys.spawn<instrumented>(counter);
+  CAF_MESSAGE("only instrumented actors appear in the registry");
+  CAF_CHECK_EQUAL(sys.metrics().size(), 1u);
+  for (int i = 0; i < 3; ++i) {
+    self->send(plain, i);
+    self->send(testee, i);
+  }
+  sched.run();
+  auto xs = deref(testee).metrics_snapshot();
+  CAF_CHECK_EQUAL(xs.owner, testee.id());
+  CAF_CHECK_EQUAL(xs.queueing_time.count(), 3u);
+  CAF_CHECK_EQUAL(xs.processing_time.count(), 3u);
+  CAF_CHECK(xs.processing_time.max() > ns{0});
+  CAF_MESSAGE("actors without instrumentation report empty histograms");
+  auto ys = deref(plain).metrics_snapshot();
+  CAF_CHECK_EQUAL(ys.owner, plain.id());
+  CAF_CHECK_EQUAL(ys.queueing_time.count(), 0u);
+  CAF_CHECK_EQUAL(ys.processing_time.count(), 0u);
+  anon_send_exit(testee, exit_reason::user_shutdown);
+  anon_send_exit(plain, exit_reason::user_shutdown);
+  sched.run();
+  CAF_MESSAGE("actors leave the registry after terminating");
+  CAF_CHECK_EQUAL(sys.metrics().size(), 0u);
+}
+
+CAF_TEST(actor_config_flag) {
+  auto testee = sys.spawn<instrumented_counter>();
+  CAF_CHECK_EQUAL(sys.metrics().size(), 1u);
+  self->send(testee, 5);
+  expect((int), from(self).to(testee).with(5));
+  CAF_MESSAGE("actors report their metrics on request");
+  self->send(testee, sys_atom::value, get_atom::value, "metrics");
+  expect((atom_value, atom_value, std::string),
+         from(self).to(testee).with(_, _, "metrics"));
+  self->receive(
+    [&](int x) {
+      CAF_CHECK_EQUAL(x, 5);
+    }
+  );
+  self->receive(
+    [&](ok_atom, const std::string&, const actor_metrics& x) {
+      CAF_CHECK_EQUAL(x.owner, testee.id());
+      CAF_CHECK_EQUAL(x.owner_name, "instrumented_counter");
+      CAF_CHECK_EQUAL(x.queueing_time.count(), 1u);
+      CAF_CHECK_EQUAL(x.processing_time.count(), 1u);
+    }
+  );
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
+
+CAF_TEST(collect) {
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  auto testee = sys.spawn<instrumented>(counter);
+  scoped_actor self{sys};
+  for (int i = 0; i < 10; ++i)
+    self->request(testee, infinite, i).receive(
+      [](int) {
+        // nop
+      },
+      [](error& err) {
+        CAF_FAIL("unexpected error: " << to_string(err));
+      });
+  auto xs = sys.metrics().collect(duration{time_unit::seconds, 10});
+  CAF_REQUIRE_EQUAL(xs.size(), 1u);
+  CAF_CHECK_EQUAL(xs[0].owner, testee.id());
+  CAF_CHECK_EQUAL(xs[0].processing_time.count(), 10u);
+  anon_send_exit(testee, exit_reason::user_shutdown);
+}
+
+CAF_TEST(collect_uses_single_deadline) {
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  // Each sleeper blocks its thread and cannot respond before the deadline.
+  auto sleeper = [](event_based_actor*) -> behavior {
+    return {
+      [](int) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+      }
+    };
+  };
+  std::vector<actor> xs;
+  for (int i = 0; i < 4; ++i) {
+    xs.emplace_back(sys.spawn<instrumented + detached>(sleeper));
+    anon_send(xs.back(), i);
+  }
+  CAF_REQUIRE_EQUAL(sys.metrics().size(), xs.size());
+  auto t0 = std::chrono::steady_clock::now();
+  auto ys = sys.metrics().collect(duration{time_unit::milliseconds, 100});
+  auto t1 = std::chrono::steady_clock::now();
+  CAF_CHECK(ys.empty());
+  CAF_MESSAGE("collect waits for all actors at once");
+  CAF_CHECK(t1 - t0 < std::chrono::milliseconds(350));
+  for (auto& x : xs)
+    anon_send_exit(x, exit_reason::user_shutdown);
+}
@@ -0,0 +1,181 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE pending_response_table
+#include "caf/test/unit_test.hpp"
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/response_handler.hpp"
+#include "caf/detail/pending_response_table.hpp"
+
+using std::vector;
+
+using namespace caf;
+
+using caf::detail::response_handler;
+using caf::detail::make_response_handler;
+using caf::detail::pending_response_table;
+
+namespace {
+
+using time_point = pending_response_table::time_point;
+
+message_id response_id(uint64_t x) {
+  return make_message_id(x).response_id();
+}
+
+struct fixture {
+  fixture() : t0(std::chrono::seconds(10)) {
+    // nop
+  }
+
+  // returns a handler that stores its argument or error in `result`
+  response_handler make_handler(int* result) {
+    return make_response_handler(
+      [=](int x) {
+        *result = x;
+      },
+      [=](error&) {
+        *result = -1;
+      }
+    );
+  }
+
+  time_point t0;
+  pending_response_table tbl;
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(pending_response_table_tests, fixture)
+
+CAF_TEST(response_handlers) {
+  int result = 0;
+  auto f = make_handler(&result);
+  CAF_REQUIRE(f);
+  CAF_CHECK(f.is_inline());
+  auto msg = make_message(42);
+  CAF_CHECK(f(msg));
+  CAF_CHECK_EQUAL(result, 42);
+  msg = make_message(make_error(sec::request_timeout));
+  CAF_CHECK(f(msg));
+  CAF_CHECK_EQUAL(result, -1);
+  msg = make_message("hello");
+  CAF_CHECK(!f(msg));
+  CAF_MESSAGE("large function objects live on the heap");
+  std::array<int*, 16> ptrs;
+  ptrs.fill(&result);
+  auto g = make_response_handler([=](int x) { *ptrs.back() = x; });
+  CAF_CHECK(!g.is_inline());
+  msg = make_message(7);
+  CAF_CHECK(g(msg));
+  CAF_CHECK_EQUAL(result, 7);
+  CAF_MESSAGE("moving transfers ownership");
+  auto h = std::move(g);
+  CAF_CHECK(!g);
+  CAF_CHECK(h(msg));
+  h.reset();
+  CAF_CHECK(!h);
+  CAF_MESSAGE("handlers wrap behaviors");
+  response_handler b{behavior{[&](int x) { result = x * 2; }}};
+  CAF_CHECK(b(msg));
+  CAF_CHECK_EQUAL(result, 14);
+}
+
+CAF_TEST(handlers) {
+  vector<int> results(100);
+  for (uint64_t i = 1; i <= 100; ++i)
+    tbl.add_handler(response_id(i), make_handler(&results[i - 1]));
+  CAF_CHECK_EQUAL(tbl.size(), 100u);
+  CAF_CHECK_EQUAL(tbl.num_handlers(), 100u);
+  CAF_CHECK(tbl.capacity() >= 128u);
+  CAF_MESSAGE("take every other handler");
+  for (uint64_t i = 1; i <= 100; i += 2) {
+    auto f = tbl.take(response_id(i));
+    CAF_REQUIRE(f);
+    auto msg = make_message(static_cast<int>(i));
+    f(msg);
+  }
+  CAF_CHECK_EQUAL(tbl.size(), 50u);
+  CAF_CHECK_EQUAL(tbl.num_handlers(), 50u);
+  CAF_CHECK(!tbl.take(response_id(1)));
+  CAF_MESSAGE("all remaining handlers are still reachable");
+  for (uint64_t i = 2; i <= 100; i += 2)
+    CAF_CHECK(tbl.take(response_id(i)));
+  CAF_CHECK(tbl.empty());
+  CAF_CHECK_EQUAL(tbl.num_handlers(), 0u);
+  for (size_t i = 0; i < results.size(); ++i)
+    CAF_CHECK_EQUAL(results[i], i % 2 == 0 ? static_cast<int>(i + 1) : 0);
+}
+
+CAF_TEST(collisions) {
+  // IDs with the same home slot wrap around the end of the table
+  int dummy = 0;
+  auto cap = pending_response_table::min_capacity;
+  vector<message_id> ids;
+  for (uint64_t i = 0; i < 4; ++i)
+    ids.push_back(response_id(cap - 1 + i * cap));
+  for (auto id : ids)
+    tbl.add_handler(id, make_handler(&dummy));
+  CAF_REQUIRE_EQUAL(tbl.capacity(), cap);
+  tbl.erase(ids[0]);
+  tbl.erase(ids[2]);
+  CAF_CHECK_EQUAL(tbl.size(), 2u);
+  CAF_CHECK(tbl.take(ids[1]));
+  CAF_CHECK(tbl.take(ids[3]));
+  CAF_CHECK(!tbl.take(ids[0]));
+  CAF_CHECK(tbl.empty());
+}
+
+CAF_TEST(timeouts) {
+  int result = 0;
+  CAF_CHECK(tbl.add_timeout(response_id(1), t0 + std::chrono::seconds(3)));
+  CAF_CHECK(tbl.add_timeout(response_id(2), t0 + std::chrono::seconds(1)));
+  CAF_CHECK(!tbl.add_timeout(response_id(3), t0 + std::chrono::seconds(2)));
+  tbl.add_handler(response_id(1), make_handler(&result));
+  tbl.add_handler(response_id(3), make_handler(&result));
+  CAF_CHECK_EQUAL(tbl.size(), 3u);
+  CAF_CHECK_EQUAL(tbl.num_handlers(), 2u);
+  CAF_CHECK_EQUAL(tbl.next_timeout(), t0 + std::chrono::seconds(1));
+  CAF_MESSAGE("answered requests never expire");
+  CAF_CHECK(tbl.take(response_id(3)));
+  vector<message_id> expired;
+  auto collect = [&](message_id id) { expired.push_back(id); };
+  tbl.expire(t0 + std::chrono::seconds(2), collect);
+  CAF_CHECK_EQUAL(expired, vector<message_id>({response_id(2)}));
+  CAF_CHECK(tbl.expired(response_id(2)));
+  CAF_CHECK(!tbl.expired(response_id(1)));
+  tbl.erase(response_id(2));
+  CAF_CHECK_EQUAL(tbl.next_timeout(), t0 + std::chrono::seconds(3));
+  expired.clear();
+  tbl.expire(t0 + std::chrono::seconds(5), collect);
+  CAF_CHECK_EQUAL(expired, vector<message_id>({response_id(1)}));
+  CAF_CHECK(tbl.expired(response_id(1)));
+  CAF_CHECK(tbl.take(response_id(1)));
+  CAF_CHECK(tbl.empty());
+  CAF_CHECK_EQUAL(tbl.next_timeout(), none);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
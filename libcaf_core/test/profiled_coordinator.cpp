@@ -0,0 +1,149 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE profiled_coordinator
+#include "caf/test/unit_test.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <fstream>
+
+#include "caf/all.hpp"
+
+using std::string;
+using std::vector;
+
+using namespace caf;
+
+namespace {
+
+constexpr const char* output_file = "caf-profiled-coordinator-test.csv";
+
+struct counter_state {
+  int value = 0;
+  const char* name = "counter";
+};
+
+struct quoted_state {
+  const char* name = "a,\"b\"";
+};
+
+behavior quoted(stateful_actor<quoted_state>* self) {
+  return {
+    [=](ok_atom) {
+      self->quit();
+    }
+  };
+}
+
+behavior counter(stateful_actor<counter_state>* self) {
+  return {
+    [=](int x) {
+      self->state.value += x;
+      return self->state.value;
+    },
+    [=](ok_atom) {
+      self->quit();
+    }
+  };
+}
+
+/// Returns all lines of the profiler output split at commas.
+vector<vector<string>> read_output() {
+  vector<vector<string>> result;
+  std::ifstream in{output_file};
+  string line;
+  while (std::getline(in, line)) {
+    // keeps empty fields, e.g., the name of workers
+    vector<string> xs{string{}};
+    auto quoted = false;
+    for (size_t i = 0; i < line.size(); ++i) {
+      auto c = line[i];
+      if (c == '"') {
+        // a doubled quote inside a quoted field is a literal quote
+        if (quoted && i + 1 < line.size() && line[i + 1] == '"')
+          xs.back() += line[++i];
+        else
+          quoted = !quoted;
+      } else if (c == ',' && !quoted) {
+        xs.emplace_back();
+      } else {
+        xs.back() += c;
+      }
+    }
+    result.emplace_back(std::move(xs));
+  }
+  return result;
+}
+
+} // namespace <anonymous>
+
+CAF_TEST(profiler_output) {
+  { // lifetime scope of the actor system
+    actor_system_config cfg;
+    cfg.scheduler_enable_profiling = true;
+    cfg.scheduler_max_threads = 2;
+    cfg.scheduler_profiling_output_file = output_file;
+    actor_system sys{cfg};
+    auto testee = sys.spawn(counter);
+    scoped_actor self{sys};
+    for (int i = 0; i < 100; ++i)
+      self->request(testee, infinite, 1).receive(
+        [](int) {
+          // nop
+        },
+        [](error& err) {
+          CAF_FAIL("unexpected error: " << to_string(err));
+        });
+    anon_send(testee, ok_atom::value);
+    anon_send(sys.spawn(quoted), ok_atom::value);
+  }
+  auto lines = read_output();
+  std::remove(output_file);
+  CAF_REQUIRE(!lines.empty());
+  CAF_CHECK_EQUAL(lines.front(),
+                  vector<string>({"clock", "type", "id", "name", "resumes",
+                                  "samples", "cpu_ns", "messages", "steals"}));
+  uint64_t resumes = 0;
+  uint64_t samples = 0;
+  uint64_t messages = 0;
+  size_t worker_lines = 0;
+  size_t quoted_lines = 0;
+  for (auto& xs : lines) {
+    CAF_REQUIRE_EQUAL(xs.size(), 9u);
+    if (xs[1] == "worker")
+      ++worker_lines;
+    if (xs[3] == "a,\"b\"")
+      ++quoted_lines;
+    if (xs[1] != "behavior" || xs[3] != "counter")
+      continue;
+    resumes += std::stoull(xs[4]);
+    samples += std::stoull(xs[5]);
+    messages += std::stoull(xs[7]);
+  }
+  CAF_CHECK(worker_lines >= 2u);
+  CAF_MESSAGE("names with commas and quotes are escaped");
+  CAF_CHECK(quoted_lines > 0u);
+  CAF_CHECK(resumes > 0u);
+  CAF_MESSAGE("the default sample interval measures each resume");
+  CAF_CHECK_EQUAL(samples, resumes);
+  CAF_CHECK(messages >= 101u);
+}
@@ -287,6 +287,35 @@ struct fixture {
   }
 };
 
+// never responds to requests, i.e., all requests to it eventually time out
+behavior silent_server(event_based_actor* self) {
+  return {
+    [=](int) {
+      // Creating the promise suppresses the implicit empty response.
+      self->make_response_promise();
+    }
+  };
+}
+
+// sends a request with a timeout of `secs` seconds for each integer and
+// records each request that timed out
+behavior timeout_client(event_based_actor* self, actor server,
+                        std::vector<int>* timeouts) {
+  return {
+    [=](int secs) {
+      self->request(server, seconds(secs), secs).then(
+        [=](int) {
+          CAF_ERROR("received a response from the silent server");
+        },
+        [=](const error& err) {
+          CAF_REQUIRE_EQUAL(err, sec::request_timeout);
+          timeouts->push_back(secs);
+        }
+      );
+    }
+  };
+}
+
 } // namespace <anonymous>
 
 CAF_TEST_FIXTURE_SCOPE(request_timeout_tests, fixture)
@@ -366,4 +395,34 @@ CAF_TEST(multiplexed_timeout) {
   }
 }
 
+CAF_TEST(overlapping_timeouts) {
+  using ivec = std::vector<int>;
+  ivec timeouts;
+  auto server = system.spawn(silent_server);
+  auto client = system.spawn(timeout_client, server, &timeouts);
+  sched.run();
+  auto& clock = sched.clock();
+  self->send(client, 10);
+  self->send(client, 1);
+  sched.run();
+  clock.advance_time(seconds(2));
+  sched.run();
+  CAF_CHECK_EQUAL(timeouts, ivec({1}));
+  CAF_MESSAGE("a later deadline must not expire early at t = 10");
+  self->send(client, 60);
+  sched.run();
+  clock.advance_time(seconds(8));
+  sched.run();
+  CAF_CHECK_EQUAL(timeouts, ivec({1, 10}));
+  clock.advance_time(seconds(51));
+  sched.run();
+  CAF_CHECK_EQUAL(timeouts, ivec({1, 10}));
+  clock.advance_time(seconds(1));
+  sched.run();
+  CAF_CHECK_EQUAL(timeouts, ivec({1, 10, 60}));
+  anon_send_exit(client, exit_reason::kill);
+  anon_send_exit(server, exit_reason::kill);
+  sched.run();
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,154 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE response_future
+#include "caf/test/unit_test.hpp"
+
+#include <thread>
+#include <vector>
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+using go_atom = atom_constant<atom("go")>;
+
+behavior adder() {
+  return {
+    [](int x, int y) {
+      return x + y;
+    }
+  };
+}
+
+struct lazy_state {
+  std::vector<response_promise> pending;
+};
+
+// responds to requests only after receiving 'go'
+behavior lazy(stateful_actor<lazy_state>* self) {
+  return {
+    [=](int) {
+      self->state.pending.push_back(self->make_response_promise());
+    },
+    [=](go_atom) {
+      for (auto& rp : self->state.pending)
+        rp.deliver(-1);
+      self->state.pending.clear();
+    }
+  };
+}
+
+bool is_int(const expected<message>& x, int y) {
+  return x && x->match_elements<int>() && x->get_as<int>(0) == y;
+}
+
+struct fixture {
+  actor_system_config cfg;
+  actor_system sys;
+
+  fixture() : sys(cfg) {
+    // nop
+  }
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(response_future_tests, fixture)
+
+CAF_TEST(request_from_plain_thread) {
+  auto testee = sys.spawn(adder);
+  CAF_CHECK(is_int(sys.request(testee, infinite, 1, 2).get(), 3));
+  CAF_MESSAGE("subsequent requests reuse the slot without creating actors");
+  auto last_id = sys.latest_actor_id();
+  for (int i = 0; i < 100; ++i)
+    sys.request(testee, infinite, i, i).receive(
+      [=](int x) {
+        CAF_CHECK_EQUAL(x, i + i);
+      },
+      [](error& err) {
+        CAF_FAIL("unexpected error: " << to_string(err));
+      });
+  CAF_CHECK_EQUAL(sys.latest_actor_id(), last_id);
+  anon_send_exit(testee, exit_reason::user_shutdown);
+}
+
+CAF_TEST(concurrent_requests) {
+  auto testee = sys.spawn(adder);
+  std::vector<std::thread> threads;
+  std::vector<int> failures(4, 0);
+  for (size_t t = 0; t < failures.size(); ++t)
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 1000; ++i) {
+        auto res = sys.request(testee, duration{std::chrono::seconds(10)},
+                               i, 1).get();
+        if (!is_int(res, i + 1))
+          ++failures[t];
+      }
+    });
+  for (auto& t : threads)
+    t.join();
+  CAF_CHECK_EQUAL(failures, std::vector<int>(4, 0));
+  anon_send_exit(testee, exit_reason::user_shutdown);
+}
+
+CAF_TEST(timeouts_and_late_responses) {
+  auto testee = sys.spawn(lazy);
+  duration timeout{std::chrono::milliseconds(10)};
+  auto res = sys.request(testee, timeout, 1).get();
+  CAF_CHECK_EQUAL(res.error(), sec::request_timeout);
+  CAF_MESSAGE("late responses never reach subsequent requests");
+  anon_send(testee, go_atom::value);
+  auto f = sys.request(testee, infinite, 2);
+  anon_send(testee, go_atom::value);
+  res = f.get();
+  CAF_CHECK(is_int(res, -1));
+  CAF_MESSAGE("get() fails after receiving the response");
+  CAF_CHECK(!f.valid());
+  res = f.get();
+  CAF_CHECK_EQUAL(res.error(), sec::invalid_argument);
+  CAF_MESSAGE("dropping a future discards its response");
+  { // lifetime scope of dropped
+    auto dropped = sys.request(testee, infinite, 3);
+  }
+  anon_send(testee, go_atom::value);
+  anon_send_exit(testee, exit_reason::user_shutdown);
+}
+
+CAF_TEST(invalid_receiver) {
+  auto res = sys.request(actor{}, infinite, 1).get();
+  CAF_CHECK_EQUAL(res.error(), sec::invalid_argument);
+}
+
+CAF_TEST(terminated_receiver) {
+  auto testee = sys.spawn(adder);
+  anon_send_exit(testee, exit_reason::kill);
+  sys.request(testee, infinite, 1, 2).receive(
+    [](int) {
+      CAF_FAIL("terminated actor produced a result");
+    },
+    [](error& err) {
+      CAF_CHECK_EQUAL(err, sec::request_receiver_down);
+    });
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
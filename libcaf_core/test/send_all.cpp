@@ -0,0 +1,186 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE send_all
+#include "caf/test/unit_test.hpp"
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "caf/all.hpp"
+
+using payload = std::shared_ptr<int>;
+
+CAF_ALLOW_UNSAFE_MESSAGE_TYPE(payload)
+
+using namespace caf;
+
+namespace {
+
+using typed_receiver = typed_actor<reacts_to<int>>;
+
+behavior receiver(event_based_actor* self, actor collector) {
+  return {
+    [=](int x) {
+      self->send(collector, x);
+      self->quit();
+    },
+    [=](const payload& x) {
+      self->send(collector, *x);
+      self->quit();
+    }
+  };
+}
+
+typed_receiver::behavior_type typed_receiver_impl(typed_receiver::pointer self,
+                                                  actor collector) {
+  return {
+    [=](int x) {
+      anon_send(collector, x);
+      self->quit();
+    }
+  };
+}
+
+// moves the sender out of the mailbox element
+behavior promising_receiver(event_based_actor* self, actor) {
+  return {
+    [=](int x) {
+      auto rp = self->make_response_promise();
+      rp.deliver(x);
+      self->quit();
+    }
+  };
+}
+
+behavior broadcaster(event_based_actor* self, std::vector<actor> xs) {
+  return {
+    [=](int x) {
+      self->send_all(xs, x);
+      self->quit();
+    }
+  };
+}
+
+struct fixture {
+  fixture() : system(cfg), self(system, true) {
+    // nop
+  }
+
+  template <class F>
+  std::vector<actor> spawn_receivers(size_t n, F fun) {
+    std::vector<actor> result;
+    for (size_t i = 0; i < n; ++i)
+      result.push_back(system.spawn(fun, actor{self}));
+    return result;
+  }
+
+  /// Returns the sum of the next `n` integers in the mailbox of `self`.
+  int collect(size_t n) {
+    int result = 0;
+    size_t i = 0;
+    self->receive_for(i, n)(
+      [&](int x) {
+        result += x;
+      }
+    );
+    return result;
+  }
+
+  actor_system_config cfg;
+  actor_system system;
+  scoped_actor self;
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(send_all_tests, fixture)
+
+CAF_TEST(send_all_from_event_based_actor) {
+  auto xs = spawn_receivers(100, receiver);
+  xs.emplace_back(); // invalid handles are ignored
+  auto b = system.spawn(broadcaster, xs);
+  self->send(b, 2);
+  CAF_CHECK_EQUAL(collect(100), 200);
+  self->await_all_other_actors_done();
+  CAF_CHECK_EQUAL(self->mailbox().count(), 0u);
+}
+
+CAF_TEST(anon_send_all_to_typed_actors) {
+  std::vector<typed_receiver> xs;
+  for (int i = 0; i < 50; ++i)
+    xs.push_back(system.spawn(typed_receiver_impl, actor{self}));
+  anon_send_all(xs, 3);
+  CAF_CHECK_EQUAL(collect(50), 150);
+  self->await_all_other_actors_done();
+}
+
+CAF_TEST(shared_content_gets_released) {
+  auto x = std::make_shared<int>(1);
+  auto xs = spawn_receivers(20, receiver);
+  // a terminated receiver drops its element immediately
+  auto dead = system.spawn(receiver, actor{self});
+  self->send_exit(dead, exit_reason::kill);
+  self->wait_for(dead);
+  xs.push_back(dead);
+  self->send_all(xs, x);
+  CAF_CHECK_EQUAL(collect(20), 20);
+  self->await_all_other_actors_done();
+  // actors may still hold their last element briefly after unregistering
+  for (int i = 0; i < 1000 && x.use_count() > 1; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  CAF_CHECK_EQUAL(x.use_count(), 1);
+}
+
+CAF_TEST(sender_references_get_released) {
+  auto ctrl = actor_cast<strong_actor_ptr>(self);
+  auto refs = [&] {
+    return ctrl->strong_refs.load();
+  };
+  auto before = refs();
+  auto xs = spawn_receivers(20, receiver);
+  auto ys = spawn_receivers(20, promising_receiver);
+  xs.insert(xs.end(), ys.begin(), ys.end());
+  ys.clear();
+  // spawning receivers with a handle to `self` adds references
+  auto with_receivers = refs();
+  self->send_all(xs, 1);
+  CAF_CHECK_EQUAL(collect(40), 40);
+  xs.clear();
+  self->await_all_other_actors_done();
+  // actors may still hold their last element briefly after unregistering
+  for (int i = 0; i < 1000 && refs() > before; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  CAF_CHECK(with_receivers > before);
+  CAF_CHECK_EQUAL(refs(), before);
+}
+
+CAF_TEST(empty_range) {
+  std::vector<actor> xs;
+  self->send_all(xs, 1);
+  anon_send_all(xs, 1);
+  xs.emplace_back();
+  anon_send_all(xs, 1);
+  CAF_CHECK_EQUAL(self->mailbox().count(), 0u);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
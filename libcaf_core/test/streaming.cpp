@@ -142,6 +142,40 @@ behavior filter(stateful_actor<filter_state>* self) {
   };
 }
 
+struct fused_filter_state {
+  static const char* name;
+};
+
+const char* fused_filter_state::name = "fused_filter";
+
+behavior fused_filter(stateful_actor<fused_filter_state>* self) {
+  namespace ops = stream_ops;
+  return {
+    [=](stream<int>& in, std::string& fname) -> stream<int> {
+      CAF_CHECK_EQUAL(fname, "test.txt");
+      return self->make_stage(
+        // input stream
+        in,
+        // forward file name in handshake to next stage
+        std::forward_as_tuple(std::move(fname)),
+        // initialize state
+        [=](unit_t&) {
+          // nop
+        },
+        // processing steps: sum up x * 10 for all odd x of a batch
+        fuse<int>(ops::filter([](int x) { return (x & 0x01) != 0; }),
+                  ops::map([](int x) { return x * 10; }),
+                  ops::reduce(0, [](int& x, int y) { x += y; })),
+        // cleanup
+        [=](unit_t&) {
+          // nop
+        },
+        policy::arg<detail::pull5_gatherer, detail::push5_scatterer<int>>::value
+      );
+    }
+  };
+}
+
 struct broken_filter_state {
   static const char* name;
 };
@@ -708,4 +742,121 @@ CAF_TEST(multiplexed_pipeline) {
   sched.run();
 }
 
+CAF_TEST(empty_batch) {
+  auto source = sys.spawn(file_reader);
+  auto sink = sys.spawn(sum_up);
+  auto pipeline = sink * source;
+  sched.run();
+  self->send(pipeline, "test.txt");
+  expect((std::string), from(self).to(source).with("test.txt"));
+  expect((stream_msg::open),
+         from(self).to(sink).with(_, source, _, _, _, _, false));
+  expect((stream_msg::ack_open), from(sink).to(source).with(_, _, 5, _, false));
+  CAF_MESSAGE("the sink rejects batches without elements");
+  CAF_REQUIRE_EQUAL(deref(sink).streams().size(), 1u);
+  auto sid = deref(sink).streams().begin()->first;
+  auto& mgr = deref(sink).streams().begin()->second;
+  message xs;
+  CAF_CHECK_EQUAL(mgr->batch(sid, source.address(), 0, xs, 0),
+                  sec::invalid_stream_state);
+  CAF_CHECK_EQUAL(mgr->batch(sid, source.address(), -1, xs, 0),
+                  sec::invalid_stream_state);
+  CAF_CHECK_EQUAL(mgr->processing_time().count(), 0u);
+  anon_send_exit(source, exit_reason::kill);
+  anon_send_exit(sink, exit_reason::kill);
+  sched.run();
+}
+
+CAF_TEST(depth3_pipeline_with_fused_stage) {
+  CAF_MESSAGE("check pipeline with a fused filter/map/reduce stage");
+  auto source = sys.spawn(file_reader);
+  auto stage = sys.spawn(fused_filter);
+  auto sink = sys.spawn(sum_up);
+  auto pipeline = self * sink * stage * source;
+  sched.run();
+  self->send(pipeline, "test.txt");
+  expect((std::string), from(self).to(source).with("test.txt"));
+  expect((stream_msg::open),
+         from(self).to(stage).with(_, source, _, _, _, false));
+  expect((stream_msg::open),
+         from(self).to(sink).with(_, stage, _, _, _, false));
+  expect((stream_msg::ack_open), from(sink).to(stage).with(_, _, 5, _, false));
+  expect((stream_msg::ack_open),
+         from(stage).to(source).with(_, _, 5, _, false));
+  expect((stream_msg::batch),
+         from(source).to(stage).with(5, std::vector<int>{1, 2, 3, 4, 5}, 0));
+  // the fused stage emits one element per input batch: 10 + 30 + 50
+  expect((stream_msg::batch),
+         from(stage).to(sink).with(1, std::vector<int>{90}, 0));
+  sched.run();
+  // 90 for the first batch plus 70 + 90 for the second batch
+  expect((int), from(sink).to(self).with(250));
+}
+
+CAF_TEST(stream_instrumentation) {
+  auto source = sys.spawn(file_reader);
+  auto stage = sys.spawn(filter);
+  auto sink = sys.spawn(sum_up);
+  auto pipeline = self * sink * stage * source;
+  sched.run();
+  self->send(pipeline, "test.txt");
+  expect((std::string), from(self).to(source).with("test.txt"));
+  expect((stream_msg::open),
+         from(self).to(stage).with(_, source, _, _, _, false));
+  expect((stream_msg::open),
+         from(self).to(sink).with(_, stage, _, _, _, false));
+  expect((stream_msg::ack_open), from(sink).to(stage).with(_, _, 5, _, false));
+  expect((stream_msg::ack_open),
+         from(stage).to(source).with(_, _, 5, _, false));
+  CAF_MESSAGE("all actors with streams appear in the registry");
+  CAF_CHECK_EQUAL(sys.streams().size(), 3u);
+  expect((stream_msg::batch),
+         from(source).to(stage).with(5, std::vector<int>{1, 2, 3, 4, 5}, 0));
+  CAF_MESSAGE("the source waits for the ACK of its first batch");
+  auto xs = deref(source).stream_metrics_snapshot();
+  CAF_REQUIRE_EQUAL(xs.size(), 1u);
+  CAF_CHECK_EQUAL(xs[0].owner, source.id());
+  CAF_CHECK_EQUAL(xs[0].owner_name, "file_reader");
+  CAF_CHECK_EQUAL(xs[0].inbound_paths.size(), 0u);
+  CAF_REQUIRE_EQUAL(xs[0].outbound_paths.size(), 1u);
+  auto& src_out = xs[0].outbound_paths[0];
+  CAF_CHECK_EQUAL(src_out.hdl, stage.address());
+  CAF_CHECK_EQUAL(src_out.open_credit, 0);
+  CAF_CHECK_EQUAL(src_out.batches_in_flight, 1);
+  CAF_CHECK_EQUAL(src_out.elements_in_flight, 5);
+  CAF_CHECK_EQUAL(src_out.ack_rtt.count(), 0u);
+  CAF_MESSAGE("the stage reports both of its paths in a single snapshot");
+  self->send(stage, sys_atom::value, get_atom::value, "streams");
+  expect((atom_value, atom_value, std::string),
+         from(self).to(stage).with(_, _, "streams"));
+  self->receive(
+    [&](ok_atom, const std::string&, std::vector<stream_metrics>& ys) {
+      CAF_REQUIRE_EQUAL(ys.size(), 1u);
+      CAF_CHECK_EQUAL(ys[0].owner_name, "filter");
+      CAF_CHECK_EQUAL(ys[0].processing_time.count(), 1u);
+      CAF_REQUIRE_EQUAL(ys[0].inbound_paths.size(), 1u);
+      CAF_CHECK_EQUAL(ys[0].inbound_paths[0].hdl, source.address());
+      CAF_CHECK_EQUAL(ys[0].inbound_paths[0].last_batch_id, 0);
+      CAF_REQUIRE_EQUAL(ys[0].outbound_paths.size(), 1u);
+      CAF_CHECK_EQUAL(ys[0].outbound_paths[0].hdl, sink.address());
+      CAF_CHECK_EQUAL(ys[0].outbound_paths[0].batches_in_flight, 1);
+      CAF_CHECK_EQUAL(ys[0].outbound_paths[0].elements_in_flight, 3);
+    }
+  );
+  expect((stream_msg::batch),
+         from(stage).to(sink).with(3, std::vector<int>{1, 3, 5}, 0));
+  CAF_MESSAGE("ACKs release in-flight batches and record the round-trip");
+  expect((stream_msg::ack_batch), from(stage).to(source).with(5, 0));
+  xs = deref(source).stream_metrics_snapshot();
+  CAF_REQUIRE_EQUAL(xs.size(), 1u);
+  CAF_REQUIRE_EQUAL(xs[0].outbound_paths.size(), 1u);
+  CAF_CHECK_EQUAL(xs[0].outbound_paths[0].batches_in_flight, 1);
+  CAF_CHECK_EQUAL(xs[0].outbound_paths[0].elements_in_flight, 4);
+  CAF_CHECK_EQUAL(xs[0].outbound_paths[0].ack_rtt.count(), 1u);
+  sched.run();
+  expect((int), from(sink).to(self).with(25));
+  CAF_MESSAGE("actors leave the registry once all streams are closed");
+  CAF_CHECK_EQUAL(sys.streams().size(), 0u);
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,88 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE thread_parker
+#include "caf/test/unit_test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "caf/all.hpp"
+
+#include "caf/detail/thread_parker.hpp"
+
+using namespace caf;
+
+using detail::thread_parker;
+
+CAF_TEST(park_and_unpark) {
+  thread_parker parker;
+  std::atomic<int> value{0};
+  std::thread writer{[&] {
+    for (int i = 1; i <= 100; ++i) {
+      value = i;
+      parker.unpark();
+      std::this_thread::yield();
+    }
+  }};
+  parker.park([&] { return value == 100; });
+  writer.join();
+  CAF_CHECK_EQUAL(value.load(), 100);
+}
+
+CAF_TEST(park_until_timeout) {
+  thread_parker parker;
+  auto t0 = thread_parker::clock_type::now();
+  auto timeout = t0 + std::chrono::milliseconds(10);
+  CAF_CHECK(!parker.park_until([] { return false; }, timeout));
+  CAF_CHECK(thread_parker::clock_type::now() >= timeout);
+  CAF_MESSAGE("park_until returns immediately for ready predicates");
+  CAF_CHECK(parker.park_until([] { return true; }, t0));
+}
+
+CAF_TEST(blocking_receive_with_timeout) {
+  actor_system_config cfg;
+  actor_system sys{cfg};
+  scoped_actor self{sys};
+  auto received = false;
+  self->receive(
+    [&](int) {
+      received = true;
+    },
+    after(std::chrono::milliseconds(5)) >> [] {
+      // nop
+    }
+  );
+  CAF_CHECK(!received);
+  auto testee = sys.spawn([]() -> behavior {
+    return [](int x) { return x * 2; };
+  });
+  for (int i = 0; i < 100; ++i)
+    self->request(testee, infinite, i).receive(
+      [&](int y) {
+        CAF_CHECK_EQUAL(y, i * 2);
+      },
+      [](error& err) {
+        CAF_FAIL("unexpected error: " << to_string(err));
+      }
+    );
+  self->send_exit(testee, exit_reason::user_shutdown);
+}
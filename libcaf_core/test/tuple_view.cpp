@@ -0,0 +1,127 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE tuple_view
+#include "caf/test/unit_test.hpp"
+
+#include <string>
+
+#include "caf/all.hpp"
+
+using std::string;
+
+using namespace caf;
+
+namespace {
+
+struct fixture {
+  fixture()
+      : xs(make_message(1, 2, 3)),
+        ys(make_message(string{"a"}, string{"b"})) {
+    // nop
+  }
+
+  message xs;
+  message ys;
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(tuple_view_tests, fixture)
+
+CAF_TEST(default_constructed) {
+  tuple_view v;
+  CAF_CHECK_EQUAL(v.size(), 0u);
+  CAF_CHECK_EQUAL(v.num_segments(), 0u);
+  CAF_CHECK_EQUAL(v.type_token(), make_type_token<>());
+  CAF_CHECK(v.to_message().empty());
+}
+
+CAF_TEST(slicing) {
+  tuple_view v{xs};
+  CAF_CHECK_EQUAL(v.size(), 3u);
+  CAF_CHECK_EQUAL(v.type_token(), xs.type_token());
+  CAF_CHECK(v.drop(1).match_elements<int, int>());
+  CAF_CHECK_EQUAL(v.drop(1).get_as<int>(0), 2);
+  CAF_CHECK_EQUAL(v.drop_right(1).get_as<int>(1), 2);
+  CAF_CHECK_EQUAL(v.take(1).size(), 1u);
+  CAF_CHECK_EQUAL(v.take_right(1).get_as<int>(0), 3);
+  CAF_CHECK_EQUAL(v.slice(1, 1).get_as<int>(0), 2);
+  CAF_CHECK_EQUAL(v.drop(3).size(), 0u);
+  CAF_CHECK_EQUAL(v.slice(1, 10).size(), 2u);
+  CAF_CHECK_EQUAL(to_string(v.drop(1).to_message()), "(2, 3)");
+  CAF_MESSAGE("views refer to the original elements");
+  CAF_CHECK_EQUAL(v.drop(1).get(0), xs.at(1));
+}
+
+CAF_TEST(concatenation) {
+  tuple_view v{xs};
+  auto w = v.take(1) + tuple_view{ys} + v.drop(1);
+  CAF_CHECK_EQUAL(w.num_segments(), 3u);
+  CAF_CHECK(w.match_elements<int, string, string, int, int>());
+  CAF_CHECK_EQUAL(w.type_token(),
+                  (make_type_token<int, string, string, int, int>()));
+  CAF_CHECK_EQUAL(to_string(w.to_message()), R"__((1, "a", "b", 2, 3))__");
+  CAF_CHECK_EQUAL(to_string(w.slice(1, 3).to_message()), R"__(("a", "b", 2))__");
+  CAF_MESSAGE("adjacent ranges collapse into one segment");
+  CAF_CHECK_EQUAL((v.take(1) + v.drop(1)).num_segments(), 1u);
+  CAF_CHECK_EQUAL(tuple_view{w}.num_segments(), 3u);
+  CAF_MESSAGE("exceeding the maximum number of segments raises an error");
+  auto raised = false;
+  try {
+    w + v.take(1) + tuple_view{ys};
+  } catch (std::runtime_error&) {
+    raised = true;
+  }
+  CAF_CHECK(raised);
+}
+
+CAF_TEST(invoking_behaviors) {
+  auto w = tuple_view{xs}.drop(2) + tuple_view{ys};
+  string result;
+  message_handler f{
+    [&](int x, const string& y, const string& z) {
+      result = std::to_string(x) + y + z;
+    }
+  };
+  CAF_CHECK(f(w));
+  CAF_CHECK_EQUAL(result, "3ab");
+  CAF_MESSAGE("manipulators operate on a copy of the viewed elements");
+  message_handler g{
+    [&](int& x) {
+      x = 42;
+    }
+  };
+  auto v = tuple_view{xs}.take(1);
+  CAF_CHECK(g(v));
+  CAF_CHECK_EQUAL(xs.get_as<int>(0), 1);
+}
+
+CAF_TEST(extract) {
+  auto msg = make_message(1, string{"a"}, 2, string{"b"});
+  auto res = msg.extract({
+    [](const string&) {
+      // nop
+    }
+  });
+  CAF_CHECK_EQUAL(to_string(res), "(1, 2)");
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
@@ -0,0 +1,91 @@
+/******************************************************************************
+ *                       ____    _    _____                                   *
+ *                      / ___|  / \  |  ___|    C++                           *
+ *                     | |     / _ \ | |_       Actor                         *
+ *                     | |___ / ___ \|  _|      Framework                     *
+ *                      \____/_/   \_|_|                                      *
+ *                                                                            *
+ * Copyright 2011-2018 Dominik Charousset                                     *
+ *                                                                            *
+ * Distributed under the terms and conditions of the BSD 3-Clause License or  *
+ * (at your option) under the terms and conditions of the Boost Software      *
+ * License 1.0. See accompanying files LICENSE and LICENSE_ALTERNATIVE.       *
+ *                                                                            *
+ * If you did not receive a copy of the license files, see                    *
+ * http://opensource.org/licenses/BSD-3-Clause and                            *
+ * http://www.boost.org/LICENSE_1_0.txt.                                      *
+ ******************************************************************************/
+
+#include "caf/config.hpp"
+
+#define CAF_SUITE work_stealing
+#include "caf/test/unit_test.hpp"
+
+#include "caf/all.hpp"
+
+using namespace caf;
+
+namespace {
+
+behavior ping_pong(event_based_actor* self) {
+  return {
+    [=](int x, const actor& buddy) {
+      self->send(buddy, x + 1, actor{self});
+    }
+  };
+}
+
+behavior echo(event_based_actor*) {
+  return {
+    [](int x) {
+      return x;
+    }
+  };
+}
+
+struct fixture {
+  fixture() {
+    cfg.scheduler_policy = atom("stealing");
+    cfg.scheduler_max_threads = 1;
+    cfg.work_stealing_direct_handoff = true;
+  }
+
+  actor_system_config cfg;
+};
+
+} // namespace <anonymous>
+
+CAF_TEST_FIXTURE_SCOPE(work_stealing_tests, fixture)
+
+CAF_TEST(direct_handoff) {
+  actor_system sys{cfg};
+  scoped_actor self{sys};
+  auto first = sys.spawn(echo);
+  auto second = sys.spawn(echo);
+  for (int i = 0; i < 10; ++i) {
+    self->send(first, i);
+    self->send(second, i);
+  }
+  for (int i = 0; i < 20; ++i)
+    self->receive(
+      [](int) {
+        // nop
+      }
+    );
+  CAF_MESSAGE("actors waking up each other do not starve others");
+  auto a = sys.spawn(ping_pong);
+  auto b = sys.spawn(ping_pong);
+  anon_send(a, 0, b);
+  self->request(first, duration{std::chrono::seconds(10)}, 42).receive(
+    [](int x) {
+      CAF_CHECK_EQUAL(x, 42);
+    },
+    [](error& err) {
+      CAF_FAIL("unexpected error: " << to_string(err));
+    }
+  );
+  anon_send_exit(a, exit_reason::user_shutdown);
+  anon_send_exit(b, exit_reason::user_shutdown);
+}
+
+CAF_TEST_FIXTURE_SCOPE_END()
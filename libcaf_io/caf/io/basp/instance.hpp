@@ -213,6 +213,15 @@ public:
                 const strong_actor_ptr& receiver,
                 message_id mid, const message& msg);
 
+  /// Writes `msg` to the output buffer for `receiver` without flushing it.
+  /// Allows callers to coalesce multiple messages into a single flush.
+  /// @returns The route to `receiver` or `none` if no path exists.
+  optional<routing_table::route>
+  write_dispatch(execution_unit* ctx, const strong_actor_ptr& sender,
+                 const std::vector<strong_actor_ptr>& forwarding_stack,
+                 const strong_actor_ptr& receiver, message_id mid,
+                 const message& msg);
+
   /// Returns the actor namespace associated to this BASP protocol instance.
   proxy_registry& proxies() {
     return callee_.proxies();
@@ -28,6 +28,7 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "caf/stream_msg.hpp"
 #include "caf/stateful_actor.hpp"
 #include "caf/proxy_registry.hpp"
 #include "caf/binary_serializer.hpp"
@@ -199,6 +200,76 @@ struct basp_broker_state : proxy_registry::backend, basp::instance::callee {
   // actor
   void handle_down_msg(down_msg&);
 
+  // -- stream-aware message handling ------------------------------------------
+
+  // a `stream_msg::ack_batch` in transit between a sink and a source
+  struct stream_ack {
+    strong_actor_ptr src;
+    strong_actor_ptr dest;
+    stream_msg msg;
+  };
+
+  using stream_ack_list = std::vector<stream_ack>;
+
+  // buffers `msg` if it is an ACK to a remote source, merging it with an
+  // already buffered ACK for the same stream; returns `false` if `msg`
+  // needs to be sent immediately
+  bool buffer_stream_ack(const strong_actor_ptr& src,
+                         const std::vector<strong_actor_ptr>& fwd_stack,
+                         const strong_actor_ptr& dest, message_id mid,
+                         const message& msg);
+
+  // writes all buffered ACKs for `nid` to the output buffer
+  void write_stream_acks(execution_unit* ctx, const node_id& nid);
+
+  // writes a stream message to `dest` and defers flushing the connection
+  // until the end of the current activation
+  bool dispatch_stream_msg(execution_unit* ctx, const strong_actor_ptr& src,
+                           const std::vector<strong_actor_ptr>& fwd_stack,
+                           const strong_actor_ptr& dest, message_id mid,
+                           const message& msg);
+
+  // writes all buffered ACKs and flushes all connections with stream traffic
+  void flush_stream_traffic(execution_unit* ctx);
+
+  // enables write ACKs for `hdl` until its backlog drops to zero
+  void track_backlog(connection_handle hdl);
+
+  // returns the number of bytes waiting to be sent on the route to `nid`
+  size_t stream_backlog(const node_id& nid);
+
+  // withholds an ACK from a remote sink while the send buffer towards its
+  // node is congested; returns `false` if `msg` needs to be delivered
+  bool hold_stream_ack(const node_id& src_nid, const strong_actor_ptr& src,
+                       const strong_actor_ptr& dest, const message& msg);
+
+  // delivers withheld ACKs from `src` or from all sinks if `src == nullptr`
+  void release_stream_acks(const node_id& src_nid,
+                           const strong_actor_ptr& src);
+
+  // delivers withheld ACKs for all nodes reachable via `hdl`
+  void release_stream_acks(connection_handle hdl);
+
+  // updates the send-buffer backlog of `hdl` and releases withheld ACKs once
+  // the backlog drops below the low watermark
+  void handle_data_transferred(const data_transferred_msg& msg);
+
+  // ACKs to remote sources waiting for piggybacking, grouped by node
+  std::unordered_map<node_id, stream_ack_list> pending_stream_acks;
+
+  // ACKs from remote sinks withheld due to congestion, grouped by node
+  std::unordered_map<node_id, stream_ack_list> held_stream_acks;
+
+  // nodes with unflushed stream traffic
+  std::unordered_set<node_id> stream_flushes;
+
+  // bytes handed to the socket but not yet written, per connection with
+  // pending stream traffic
+  std::unordered_map<connection_handle, size_t> tcp_backlog;
+
+  // maximum number of unsent bytes per connection before withholding credit
+  const size_t max_stream_backlog;
+
   static const char* name;
 };
 
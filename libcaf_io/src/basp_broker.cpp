@@ -19,6 +19,8 @@
 #include "caf/io/basp_broker.hpp"
 
 #include <limits>
+#include <iterator>
+#include <algorithm>
 #include <chrono>
 
 #include "caf/sec.hpp"
@@ -54,6 +56,32 @@ struct seq_num_visitor {
   basp_broker_state* state;
 };
 
+// returns the ACK stored in `msg` or `nullptr` if `msg` is no ACK
+const stream_msg::ack_batch* get_stream_ack(const message& msg) {
+  if (!msg.match_elements<stream_msg>())
+    return nullptr;
+  return get_if<stream_msg::ack_batch>(&msg.get_as<stream_msg>(0).content);
+}
+
+// merges `x` into an ACK for the same stream in `xs` or appends it to `xs`
+void merge_stream_ack(basp_broker_state::stream_ack_list& xs,
+                      const strong_actor_ptr& src, const strong_actor_ptr& dest,
+                      const stream_msg& x) {
+  auto& ack = get<stream_msg::ack_batch>(x.content);
+  for (auto& y : xs) {
+    if (y.src == src && y.dest == dest && y.msg.sid == x.sid) {
+      // ACKs are cumulative, hence merging them only requires us to sum up
+      // the credit and to keep the latest batch ID
+      auto& merged = get<stream_msg::ack_batch>(y.msg.content);
+      merged.new_capacity += ack.new_capacity;
+      merged.acknowledged_id = std::max(merged.acknowledged_id,
+                                        ack.acknowledged_id);
+      return;
+    }
+  }
+  xs.push_back(basp_broker_state::stream_ack{src, dest, x});
+}
+
 struct close_visitor {
   using result_type = void;
   close_visitor(broker* ptr) : b(ptr) { }
@@ -78,7 +106,8 @@ basp_broker_state::basp_broker_state(broker* selfptr)
       self(selfptr),
       instance(selfptr, *this),
       max_buffers(self->system().config().middleman_cached_udp_buffers),
-      max_pending_messages(self->system().config().middleman_max_pending_msgs) {
+      max_pending_messages(self->system().config().middleman_max_pending_msgs),
+      max_stream_backlog(self->system().config().middleman_max_stream_backlog) {
   CAF_ASSERT(this_node() != none);
 }
 
@@ -176,6 +205,9 @@ void basp_broker_state::purge_state(const node_id& nid) {
   // Cleanup all remaining references to the lost node.
   for (auto& kvp : monitored_actors)
     kvp.second.erase(nid);
+  pending_stream_acks.erase(nid);
+  held_stream_acks.erase(nid);
+  stream_flushes.erase(nid);
 }
 
 void basp_broker_state::send_kill_proxy_instance(const node_id& nid,
@@ -189,6 +221,8 @@ void basp_broker_state::send_kill_proxy_instance(const node_id& nid,
                  << CAF_ARG(nid));
     return;
   }
+  // make sure the remote node receives all ACKs before the kill message
+  write_stream_acks(self->context(), nid);
   instance.write_kill_proxy(self->context(),
                             get_buffer(path->hdl),
                             nid, aid, rsn,
@@ -311,11 +345,161 @@ void basp_broker_state::deliver(const node_id& src_nid, actor_id src_aid,
     return;
   }
   self->parent().notify<hook::message_received>(src_nid, src, dest, mid, msg);
+  if (hold_stream_ack(src_nid, src, dest, msg))
+    return;
+  // deliver withheld ACKs first to preserve message ordering
+  release_stream_acks(src_nid, src);
   dest->enqueue(make_mailbox_element(std::move(src), mid, std::move(stages),
                                      std::move(msg)),
                 nullptr);
 }
 
+bool basp_broker_state::buffer_stream_ack(
+  const strong_actor_ptr& src, const std::vector<strong_actor_ptr>& fwd_stack,
+  const strong_actor_ptr& dest, message_id mid, const message& msg) {
+  if (!fwd_stack.empty() || mid.valid() || get_stream_ack(msg) == nullptr)
+    return false;
+  CAF_LOG_TRACE(CAF_ARG(src) << CAF_ARG(dest) << CAF_ARG(msg));
+  merge_stream_ack(pending_stream_acks[dest->node()], src, dest,
+                   msg.get_as<stream_msg>(0));
+  return true;
+}
+
+void basp_broker_state::write_stream_acks(execution_unit* ctx,
+                                          const node_id& nid) {
+  auto i = pending_stream_acks.find(nid);
+  if (i == pending_stream_acks.end())
+    return;
+  CAF_LOG_TRACE(CAF_ARG(nid) << CAF_ARG2("num_acks", i->second.size()));
+  std::vector<strong_actor_ptr> no_stages;
+  for (auto& x : i->second)
+    dispatch_stream_msg(ctx, x.src, no_stages, x.dest, make_message_id(),
+                        make_message(std::move(x.msg)));
+  pending_stream_acks.erase(i);
+}
+
+bool basp_broker_state::dispatch_stream_msg(
+  execution_unit* ctx, const strong_actor_ptr& src,
+  const std::vector<strong_actor_ptr>& fwd_stack, const strong_actor_ptr& dest,
+  message_id mid, const message& msg) {
+  auto path = instance.write_dispatch(ctx, src, fwd_stack, dest, mid, msg);
+  if (!path)
+    return false;
+  // datagrams must not carry more than one BASP message
+  if (path->hdl.is<connection_handle>()) {
+    stream_flushes.emplace(dest->node());
+    track_backlog(get<connection_handle>(path->hdl));
+  } else {
+    instance.flush(*path);
+  }
+  return true;
+}
+
+void basp_broker_state::track_backlog(connection_handle hdl) {
+  // write ACKs cost one message per flush, so we only request them while
+  // stream traffic is on its way
+  if (max_stream_backlog > 0 && tcp_backlog.emplace(hdl, 0).second)
+    self->ack_writes(hdl, true);
+}
+
+void basp_broker_state::flush_stream_traffic(execution_unit* ctx) {
+  while (!pending_stream_acks.empty())
+    write_stream_acks(ctx, pending_stream_acks.begin()->first);
+  for (auto& nid : stream_flushes) {
+    auto path = instance.tbl().lookup(nid);
+    if (path)
+      instance.flush(*path);
+  }
+  stream_flushes.clear();
+}
+
+size_t basp_broker_state::stream_backlog(const node_id& nid) {
+  auto path = instance.tbl().lookup(nid);
+  if (!path || !path->hdl.is<connection_handle>())
+    return 0;
+  auto hdl = get<connection_handle>(path->hdl);
+  auto i = tcp_backlog.find(hdl);
+  auto in_flight = i != tcp_backlog.end() ? i->second : size_t{0};
+  return in_flight + self->wr_buf(hdl).size();
+}
+
+bool basp_broker_state::hold_stream_ack(const node_id& src_nid,
+                                        const strong_actor_ptr& src,
+                                        const strong_actor_ptr& dest,
+                                        const message& msg) {
+  if (max_stream_backlog == 0 || get_stream_ack(msg) == nullptr
+      || stream_backlog(src_nid) <= max_stream_backlog)
+    return false;
+  CAF_LOG_DEBUG("withhold credit from congested stream:" << CAF_ARG(src_nid)
+                << CAF_ARG(src) << CAF_ARG(dest));
+  merge_stream_ack(held_stream_acks[src_nid], src, dest,
+                   msg.get_as<stream_msg>(0));
+  return true;
+}
+
+void basp_broker_state::release_stream_acks(const node_id& src_nid,
+                                            const strong_actor_ptr& src) {
+  if (held_stream_acks.empty())
+    return;
+  auto i = held_stream_acks.find(src_nid);
+  if (i == held_stream_acks.end())
+    return;
+  CAF_LOG_TRACE(CAF_ARG(src_nid) << CAF_ARG(src));
+  // move ACKs out of the map before delivering them, because enqueueing can
+  // run arbitrary code
+  stream_ack_list xs;
+  auto& ys = i->second;
+  if (src == nullptr) {
+    xs.swap(ys);
+  } else {
+    auto pred = [&](const stream_ack& y) { return y.src != src; };
+    auto p = std::stable_partition(ys.begin(), ys.end(), pred);
+    std::move(p, ys.end(), std::back_inserter(xs));
+    ys.erase(p, ys.end());
+  }
+  if (ys.empty())
+    held_stream_acks.erase(i);
+  for (auto& x : xs)
+    x.dest->enqueue(make_mailbox_element(std::move(x.src), make_message_id(),
+                                         {}, std::move(x.msg)),
+                    nullptr);
+}
+
+void basp_broker_state::release_stream_acks(connection_handle hdl) {
+  std::vector<node_id> nids;
+  for (auto& kvp : held_stream_acks) {
+    auto path = instance.tbl().lookup(kvp.first);
+    if (!path || path->hdl == endpoint_handle{hdl})
+      nids.push_back(kvp.first);
+  }
+  for (auto& nid : nids)
+    release_stream_acks(nid, nullptr);
+}
+
+void basp_broker_state::handle_data_transferred(
+  const data_transferred_msg& msg) {
+  CAF_LOG_TRACE(CAF_ARG(msg.handle) << CAF_ARG(msg.remaining));
+  auto i = tcp_backlog.find(msg.handle);
+  if (i == tcp_backlog.end())
+    return;
+  // `remaining` includes the bytes that are still in our write buffer, which
+  // stream_backlog() adds separately
+  auto buffered = self->wr_buf(msg.handle).size();
+  auto in_flight = static_cast<size_t>(msg.remaining);
+  in_flight = in_flight > buffered ? in_flight - buffered : 0;
+  // use half the maximum as low watermark to avoid oscillating
+  if (in_flight + buffered <= max_stream_backlog / 2)
+    release_stream_acks(msg.handle);
+  if (in_flight + buffered > 0) {
+    i->second = in_flight;
+    return;
+  }
+  // all stream traffic left the host, the next stream message turns write
+  // ACKs back on
+  self->ack_writes(msg.handle, false);
+  tcp_backlog.erase(msg.handle);
+}
+
 void basp_broker_state::learned_new_node(const node_id& nid) {
   CAF_LOG_TRACE(CAF_ARG(nid));
   if (spawn_servers.count(nid) > 0) {
@@ -497,6 +681,7 @@ void basp_broker_state::cleanup(connection_handle hdl) {
     }
     ctx_tcp.erase(i);
   }
+  tcp_backlog.erase(hdl);
 }
 
 void basp_broker_state::cleanup(datagram_handle hdl) {
@@ -746,9 +931,18 @@ behavior basp_broker::make_behavior() {
       }
       if (src && system().node() == src->node())
         system().registry().put(src->id(), src);
-      if (!state.instance.dispatch(context(), src, fwd_stack,
-                                   dest, mid, msg)
-          && mid.is_request()) {
+      // ACKs wait for other outbound traffic or for the end of this run
+      auto is_stream_msg = msg.match_elements<stream_msg>();
+      if (is_stream_msg
+          && state.buffer_stream_ack(src, fwd_stack, dest, mid, msg))
+        return;
+      state.write_stream_acks(context(), dest->node());
+      auto sent = is_stream_msg
+                  ? state.dispatch_stream_msg(context(), src, fwd_stack,
+                                              dest, mid, msg)
+                  : state.instance.dispatch(context(), src, fwd_stack,
+                                            dest, mid, msg);
+      if (!sent && mid.is_request()) {
         detail::sync_request_bouncer srb{exit_reason::remote_link_unreachable};
         srb(src, mid);
       }
@@ -787,6 +981,10 @@ behavior basp_broker::make_behavior() {
       return delegated<message>();
     },
     // received from underlying broker implementation
+    [=](const data_transferred_msg& msg) {
+      state.handle_data_transferred(msg);
+    },
+    // received from underlying broker implementation
     [=](const new_connection_msg& msg) {
       CAF_LOG_TRACE(CAF_ARG(msg.handle));
       auto& bi = state.instance;
@@ -949,7 +1147,11 @@ resumable::resume_result basp_broker::resume(execution_unit* ctx, size_t mt) {
   auto guard = detail::make_scope_guard([=] {
     ctx->proxy_registry_ptr(nullptr);
   });
-  return super::resume(ctx, mt);
+  auto result = super::resume(ctx, mt);
+  // coalesce all stream traffic of this run into a single flush per connection
+  if (!getf(is_terminated_flag))
+    state.flush_stream_traffic(ctx);
+  return result;
 }
 
 proxy_registry* basp_broker::proxy_registry_ptr() {
@@ -304,13 +304,25 @@ bool instance::dispatch(execution_unit* ctx, const strong_actor_ptr& sender,
                         const std::vector<strong_actor_ptr>& forwarding_stack,
                         const strong_actor_ptr& receiver, message_id mid,
                         const message& msg) {
+  auto path = write_dispatch(ctx, sender, forwarding_stack, receiver, mid, msg);
+  if (!path)
+    return false;
+  flush(*path);
+  return true;
+}
+
+optional<routing_table::route>
+instance::write_dispatch(execution_unit* ctx, const strong_actor_ptr& sender,
+                         const std::vector<strong_actor_ptr>& forwarding_stack,
+                         const strong_actor_ptr& receiver, message_id mid,
+                         const message& msg) {
   CAF_LOG_TRACE(CAF_ARG(sender) << CAF_ARG(receiver)
                 << CAF_ARG(mid) << CAF_ARG(msg));
   CAF_ASSERT(receiver && system().node() != receiver->node());
   auto path = lookup(receiver->node());
   if (!path) {
     notify<hook::message_sending_failed>(sender, receiver, mid, msg);
-    return false;
+    return none;
   }
   auto writer = make_callback([&](serializer& sink) -> error {
     return sink(const_cast<std::vector<strong_actor_ptr>&>(forwarding_stack),
@@ -321,9 +333,8 @@ bool instance::dispatch(execution_unit* ctx, const strong_actor_ptr& sender,
              sender ? sender->id() : invalid_actor_id, receiver->id(),
              visit(seq_num_visitor{callee_}, path->hdl)};
   write(ctx, callee_.get_buffer(path->hdl), hdr, &writer);
-  flush(*path);
   notify<hook::message_sent>(sender, path->next_hop, receiver, mid, msg);
-  return true;
+  return path;
 }
 
 void instance::write(execution_unit* ctx, buffer_type& buf,
@@ -773,6 +773,34 @@ CAF_TEST(indirect_connections) {
            make_message("hello from earth!"));
 }
 
+CAF_TEST(stream_ack_coalescing) {
+  connect_node(jupiter());
+  auto prx = proxies().get_or_put(jupiter().id, jupiter().dummy_actor->id());
+  mock()
+  .receive(jupiter().connection,
+          basp::message_type::announce_proxy, no_flags, no_payload,
+          no_operation_data, this_node(), prx->node(),
+          invalid_actor_id, prx->id());
+  CAF_MESSAGE("send two ACKs for the same stream to the proxy");
+  stream_id sid{self()->address(), 42};
+  auto dest = actor_cast<actor>(prx);
+  self()->send(dest, make<stream_msg::ack_batch>(sid, self()->address(), 5, 1));
+  self()->send(dest, make<stream_msg::ack_batch>(sid, self()->address(), 5, 2));
+  // the test multiplexer resumes brokers with a max. throughput of 1
+  aut()->resume(mpx(), 10);
+  mpx()->flush_runnables();
+  CAF_MESSAGE("BASP broker should've merged both ACKs into one message");
+  mock()
+  .receive(jupiter().connection,
+          basp::message_type::dispatch_message, no_flags, any_vals,
+          no_operation_data, this_node(), prx->node(),
+          self()->id(), prx->id(),
+          std::vector<actor_id>{},
+          make_message(make<stream_msg::ack_batch>(sid, self()->address(),
+                                                   10, 2)));
+  CAF_CHECK(mpx()->output_buffer(jupiter().connection).empty());
+}
+
 CAF_TEST_FIXTURE_SCOPE_END()
 
 CAF_TEST_FIXTURE_SCOPE(basp_tests_with_autoconn, autoconn_enabled_fixture)
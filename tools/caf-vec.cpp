@@ -1,6 +1,8 @@
 #include <string>
 #include <vector>
 #include <cctype>
+#include <cstring>
+#include <sstream>
 #include <utility>
 #include <cassert>
 #include <fstream>
@@ -90,6 +92,33 @@ istream_char_consumer consume(const char (&what)[S]) {
   return {what, S - 1};
 }
 
+// -- support for binary log files
+
+/// Default line format of log files, expected by `operator>>` for `log_entry`.
+constexpr const char* default_log_format = "%r %c %p %a %t %C %M %F:%L %m%n";
+
+/// Opens the log file at `path`. Renders binary logs to text using the line
+/// format `lf`. Returns `nullptr` on error.
+std::unique_ptr<std::istream> open_log(const string& path,
+                                       const logger::line_format& lf) {
+  std::ifstream bin{path, std::ios::binary};
+  if (!bin) {
+    std::cerr << "could not open file: " << path << std::endl;
+    return nullptr;
+  }
+  char magic[detail::binary_log_magic_size];
+  if (!bin.read(magic, sizeof(magic))
+      || memcmp(magic, detail::binary_log_magic, sizeof(magic)) != 0)
+    return std::unique_ptr<std::istream>{new std::ifstream(path)};
+  bin.seekg(0);
+  std::unique_ptr<std::stringstream> result{new std::stringstream};
+  if (!logger::render_binary(bin, *result, lf)) {
+    std::cerr << "malformed binary log: " << path << std::endl;
+    return nullptr;
+  }
+  return result;
+}
+
 // -- convenience functions for vector timestamps
 
 vector_timestamp& merge(vector_timestamp& x, const vector_timestamp& y) {
@@ -747,12 +776,15 @@ namespace {
 struct config : public actor_system_config {
   string output_file;
   bool include_hidden_actors = false;
+  bool decode_only = false;
   size_t verbosity = 0;
   config() {
     opt_group{custom_options_, "global"}
     .add(output_file, "output-file,o", "Path for the output file")
     .add(include_hidden_actors, "include-hidden-actors,i",
          "Include hidden (system-level) actors")
+    .add(decode_only, "decode-only,d",
+         "Only convert binary logs to text using logger.file-format")
     .add(verbosity, "verbosity,v", "Debug output (from 0 to 2)");
     // shutdown logging per default
     logger_verbosity = atom("quiet");
@@ -784,19 +816,30 @@ void caf_main(actor_system& sys, const config& cfg) {
     cerr << "unable to open output file: " << cfg.output_file << endl;
     return;
   }
+  if (cfg.decode_only) {
+    auto lf = logger::parse_format(cfg.logger_file_format.c_str());
+    for (size_t i = 0; i < cfg.args_remainder.size(); ++i) {
+      auto& file = cfg.args_remainder.get_as<string>(i);
+      auto in = open_log(file, lf);
+      if (in)
+        out << in->rdbuf();
+    }
+    return;
+  }
+  auto default_lf = logger::parse_format(default_log_format);
   using file_path = string;
-  static constexpr size_t irsize = sizeof(file_path) + sizeof(std::ifstream)
+  static constexpr size_t irsize = sizeof(file_path) + sizeof(std::istream*)
                                    + sizeof(first_pass_result);
-  using ifstream_ptr = std::unique_ptr<std::ifstream>;
+  using istream_ptr = std::unique_ptr<std::istream>;
   struct intermediate_res {
     file_path fname;
-    ifstream_ptr fstream;
+    istream_ptr fstream;
     first_pass_result res;
     char pad[irsize >= CAF_CACHE_LINE_SIZE ? 1 : CAF_CACHE_LINE_SIZE - irsize];
     intermediate_res() = default;
     intermediate_res(intermediate_res&&) = default;
     intermediate_res& operator=(intermediate_res&&) = default;
-    intermediate_res(file_path fp, ifstream_ptr fs, first_pass_result&& fr)
+    intermediate_res(file_path fp, istream_ptr fs, first_pass_result&& fr)
         : fname(std::move(fp)),
           fstream(std::move(fs)),
           res(std::move(fr)) {
@@ -810,11 +853,9 @@ void caf_main(actor_system& sys, const config& cfg) {
     auto& file = cfg.args_remainder.get_as<string>(i);
     auto ptr = &intermediate_results[i];
     ptr->fname = file;
-    ptr->fstream.reset(new std::ifstream(file));
-    if (!*ptr->fstream) {
-      cerr << "could not open file: " << file << endl;
+    ptr->fstream = open_log(file, default_lf);
+    if (!ptr->fstream)
       continue;
-    }
     sys.spawn([ptr, vl](blocking_actor* self) {
       auto& f = *ptr->fstream;
       auto res = first_pass(self, f, vl);
@@ -875,6 +916,8 @@ void caf_main(actor_system& sys, const config& cfg) {
   std::mutex out_mtx;
   auto grp = sys.groups().anonymous();
   for (auto& fpr : intermediate_results) {
+    if (!fpr.fstream)
+      continue;
     sys.spawn_in_group(grp, [&](blocking_actor* self) {
       second_pass(self, grp, entities, fpr.res.this_node, entity_names,
                   *fpr.fstream, out, out_mtx, !cfg.include_hidden_actors, vl);